@@ -1,27 +1,32 @@
 ﻿
-import sys
-import copy
-import logging
+import importlib.util
 import os
+import sys
 import time
+import types
+from functools import lru_cache
 from PyQt5 import QtWidgets, QtCore
 from PyQt5.QtCore import QTimer, Qt, QRect, QPoint
 from PyQt5.QtGui import QStatusTipEvent, QPixmap, QPainter, QPen, QColor, QIcon
 from PyQt5.QtWidgets import QMessageBox, QApplication, QAction
 from PyQt5 import QtGui
+# The generated ParamMonitor_ui.py ends with "import img_rc" (~680 KB of embedded images). Until finish_startup()
+# loads the real module after the first paint, a placeholder satisfies that import, so pyuic output is used as generated.
+IMG_RC_PLACEHOLDER = types.ModuleType("img_rc")
+sys.modules.setdefault("img_rc", IMG_RC_PLACEHOLDER)
 from ParamMonitor_ui import Ui_MainWindow
-from form_setuart import UartSet
 import serial
-import qtawesome as qta
-import qtawesome.iconic_font as qta_iconic
-from monitor_alarm import AlarmLimits, evaluate_alarm_state
-from PackUnpack import PackUnpack
+from debug_log import LEVEL_ERROR, LEVEL_INFO, LEVEL_TRAFFIC, DebugLog
+from startup_timing import STARTUP
+from view_model import ViewModel, alarm_title_text, lead_text, metric_state
+from monitor_core import (ID2_EVENT_QRS, LEAD_NAMES, MODULE_PARAM, MODULE_STATUS, MODULE_WAVE, MonitorCore, SerialSource,
+                          is_param_packet, parse_event, setup_logger, to_int16)
 from ui_theme import (
     COLORS,
     MONO_FONT,
-    alarm_title_style,
     debug_controls_style,
     bold_font,
+    central_widget_style,
     debug_dock_style,
     debug_text_style,
     main_window_style,
@@ -30,15 +35,47 @@ from ui_theme import (
     metric_card_style,
     metric_name_style,
     metric_unit_style,
-    metric_value_style,
     status_bar_style,
-    status_label_style,
     toolbar_style,
     wave_label_style,
     wave_title_style,
 )
 
-qta_iconic.IconicFont._install_fonts = lambda self, fonts_directory, system_wide=False: fonts_directory
+DEBUG_VIEW_LINES = 300
+PROFILE_SAMPLE_S = 10       # default length of a sampling profile
+HEART_PULSE_MS = 150        # heart icon stays lit this long after each QRS event
+HEART_REST_OPACITY = 0.18
+BEAT_MARK_HEIGHT = 10       # QRS tick at the top of the ECG sweep, in pixels
+
+PYQTGRAPH_AVAILABLE = importlib.util.find_spec("pyqtgraph") is not None
+
+# set once the window has been painted, see finish_startup
+TOOLBAR_ICONS = (
+    ("actionSerialToolbar", "fa5s.plug", "#61AFEF"),
+    ("actionPauseWave", "fa5s.pause", "#E5C07B"),
+    ("actionClearWave", "fa5s.eraser", "#ABB2BF"),
+    ("actionWaveBackend", "fa5s.wave-square", "#56B6C2"),
+    ("actionMuteAlarm", "fa5s.bell-slash", "#E06C75"),
+    ("actionTrend", "fa5s.chart-line", "#98C379"),
+    ("actionDebugPanel", "fa5s.terminal", "#56B6C2"),
+    ("actionDockDebugLeft", "fa5s.arrow-left", "#ABB2BF"),
+    ("actionDockDebugRight", "fa5s.arrow-right", "#ABB2BF"),
+    ("actionStreamServer", "fa5s.broadcast-tower", "#C678DD"),
+    ("actionShmRing", "fa5s.memory", "#C678DD"),
+    ("actionEdfRecord", "fa5s.file-medical", "#98C379"),
+    ("viewToolButton", "fa5s.layer-group", "#61AFEF"),
+    ("actionAboutToolbar", "fa5s.info-circle", "#ABB2BF"),
+    ("actionQuitToolbar", "fa5s.sign-out-alt", "#E06C75"),
+)
+
+
+@lru_cache(maxsize=None)
+def icon_font():
+    import qtawesome
+    import qtawesome.iconic_font as qta_iconic
+    qta_iconic.IconicFont._install_fonts = lambda self, fonts_directory, system_wide=False: fonts_directory
+    return qtawesome
+
 
 class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
     def __init__(self):
@@ -50,8 +87,8 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             QtWidgets.QMainWindow.AnimatedDocks
         )
         self.setup_responsive_ui()
+        self.setup_view_model()
         self.ser = serial.Serial()
-        self.mPackUnpck = PackUnpack()
         self.mPackAfterUnpackArr = []
         self.mRespWaveList = []
         self.mRespXStep = 0
@@ -59,9 +96,10 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.mSPO2XStep = 0
         self.mECG1WaveList = []
         self.mECG1XStep = 0
+        self.mECG1BeatMarks = []    # indices into mECG1WaveList of QRS peaks not yet drawn
         self._wave_resize_pending = False
-        self.create_wave_pixmaps()
-        self.convert_signed_16bit = lambda high_byte, low_byte: (high_byte << 8 | low_byte) if (high_byte << 8 | low_byte) < 32768 else (high_byte << 8 | low_byte) - 65536
+        self.startup_scheduled = False
+        self.startup_finished = False
         self.adaptive_scale_enabled = True
         self.ecg_min_val, self.ecg_max_val = float('inf'), float('-inf')
         self.resp_min_val, self.resp_max_val = float('inf'), float('-inf')
@@ -74,30 +112,35 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.ecg_sliding_buffer = []
         self.resp_sliding_buffer = []
         self.spo2_sliding_buffer = []
-        self.sync_error_count = 0
-        self.sync_error_threshold = 5
-        self.heart_icon_visible = True
         self.wave_paused = False
         self.debug_visible = True
         self.debug_output_paused = False
         self.debug_error_only = False
+        self.debug_hide_traffic = False
+        self.debug_log = DebugLog()
+        self.debug_rendered_seq = 0
         self.alarm_muted = False
-        self.active_alarms = []
-        self.last_hr = None
-        self.last_resp_rate = None
-        self.last_spo2 = None
-        self.lead_status = {"ECG": None, "RESP": None, "SpO2": None}
-        self.rx_bytes = 0
-        self.rx_packets = 0
-        self.checksum_error_count = 0
-        self.packet_counts = {0x10: 0, 0x11: 0, 0x12: 0}
+        self.lead_off_latency_ms = []
+        self.latency = None          # numpy-backed, created by finish_startup
+        self.profiler = None         # created by the profiler buttons
+        self.sampler = None
         self.start_time = time.time()
-        self.last_packet_time = None
         self.current_port_label = "未连接"
         self.current_baudrate = ""
-        self.alarm_limits = AlarmLimits()
-        self.setup_logger()
+        self.logger = setup_logger()
+        # the cross-check (numpy) is enabled by finish_startup
+        self.core = MonitorCore(SerialSource(self.ser), name="GUI", logger=self.logger, crosscheck=False)
+        self.core.decoder.debug_listeners.append(self.on_decoder_debug)
+        self.core.alarm_listeners.append(self.on_alarm_raised)
+        self.trend_store = None      # numpy memmaps, opened by finish_startup
+        self.core.packet_listeners.append(self.on_packets_decoded)
+        self.trend_view = None
+        self.stream_server = None
+        self.shm_writer = None
+        self.edf_writer = None
+        self.wave_backend = None
         self.init()
+        STARTUP.mark("constructed")
 
     def init(self):
         self.menubar.setVisible(False)
@@ -113,7 +156,9 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.statusStr = '等待连接串口'
         self.statusBar().showMessage(self.statusStr)
         self.setup_toolbar()
-        self.setup_debug_dock()
+        self.debugRefreshTimer = QTimer(self)
+        self.debugRefreshTimer.timeout.connect(self.refresh_debug_view)
+        self.debugRefreshTimer.start(100)
         self.serialPortTimer = QTimer(self)
         self.serialPortTimer.timeout.connect(self.data_receive)
         self.procDataTimer = QTimer(self)
@@ -121,24 +166,45 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.statusTimer = QTimer(self)
         self.statusTimer.timeout.connect(self.update_status_bar)
         self.statusTimer.start(500)
+        self.profilerTimer = QTimer(self)
+        self.profilerTimer.timeout.connect(self.update_profiler_stats)
         self.heartShapeTimer = QTimer(self)
-        self.heartShapeTimer.timeout.connect(self.heartShapeFlash)
-        self.heartShapeTimer.start(1000)
+        self.heartShapeTimer.setSingleShot(True)
+        self.heartShapeTimer.timeout.connect(self.heartShapeRest)
         self.update_status_bar()
 
-    def setup_logger(self):
-        log_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "logs")
-        os.makedirs(log_dir, exist_ok=True)
-        log_path = os.path.join(log_dir, "host_monitor.log")
-        self.logger = logging.getLogger("TriVitalMonitor")
-        self.logger.setLevel(logging.INFO)
-        if not self.logger.handlers:
-            handler = logging.FileHandler(log_path, encoding="utf-8")
-            handler.setFormatter(logging.Formatter("%(asctime)s [%(levelname)s] %(message)s"))
-            self.logger.addHandler(handler)
-
     def icon(self, name, color="#DCDFE4"):
-        return qta.icon(name, color=color, color_active="#FFFFFF")
+        return icon_font().icon(name, color=color, color_active="#FFFFFF")
+
+    def finish_startup(self):
+        """Start-up work done after the first paint, so the window appears before it: the resource bundle, the icon
+        font, the numpy-backed latency/trend stores and cross-check, the debug dock and the wave pixmaps, which
+        need the final label sizes anyway."""
+        if self.startup_finished:
+            return
+        self.startup_finished = True
+        from latency_stats import LatencyStats
+        from stream_server import DEFAULT_PORT
+        from trend_store import TrendStore
+        self.latency = LatencyStats()
+        self.core.enable_crosscheck()
+        self.trend_store = TrendStore(os.path.join(os.path.dirname(os.path.abspath(__file__)), "trends"))
+        self.actionStreamServer.setText(f"本地数据流 :{DEFAULT_PORT}")
+        if sys.modules.get("img_rc") is IMG_RC_PLACEHOLDER:
+            del sys.modules["img_rc"]
+        import img_rc  # noqa: F401  ~680 KB of embedded images, registered with Qt on import
+        self.heartLabel.setPixmap(QIcon(":/new/prefix1/image/heart.png").pixmap(28, 28))
+        for name, icon_name, color in TOOLBAR_ICONS:
+            getattr(self, name).setIcon(self.icon(icon_name, color))
+        if self.debug_visible:
+            self.ensure_debug_dock()
+            QApplication.processEvents()     # a dock added to a shown window takes a width only once laid out
+            self.resizeDocks([self.debugDock], [360], Qt.Horizontal)
+        QApplication.sendPostedEvents(None, QtCore.QEvent.LayoutRequest)
+        self.create_wave_pixmaps()
+        STARTUP.mark("ready")
+        self.logger.info("启动耗时 (ms):\n%s", STARTUP.report())
+        self.append_debug_log(f"STARTUP window {STARTUP.ms('window') or 0:.0f} ms, ready {STARTUP.ms('ready'):.0f} ms")
 
     def setup_toolbar(self):
         self.toolbar = QtWidgets.QToolBar("监护工具", self)
@@ -148,43 +214,68 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.toolbar.setStyleSheet(toolbar_style())
         self.addToolBar(Qt.TopToolBarArea, self.toolbar)
 
-        self.actionSerialToolbar = QAction(self.icon("fa5s.plug", "#61AFEF"), "串口", self)
+        self.actionSerialToolbar = QAction("串口", self)
         self.actionSerialToolbar.triggered.connect(self.slot_serialSet)
         self.toolbar.addAction(self.actionSerialToolbar)
 
-        self.actionPauseWave = QAction(self.icon("fa5s.pause", "#E5C07B"), "暂停波形", self)
+        self.actionPauseWave = QAction("暂停波形", self)
         self.actionPauseWave.setCheckable(True)
         self.actionPauseWave.triggered.connect(self.toggle_wave_pause)
         self.toolbar.addAction(self.actionPauseWave)
 
-        self.actionClearWave = QAction(self.icon("fa5s.eraser", "#ABB2BF"), "清屏", self)
+        self.actionClearWave = QAction("清屏", self)
         self.actionClearWave.triggered.connect(self.clear_wave_screen)
         self.toolbar.addAction(self.actionClearWave)
 
-        self.actionMuteAlarm = QAction(self.icon("fa5s.bell-slash", "#E06C75"), "报警静音", self)
+        self.actionWaveBackend = QAction("pyqtgraph", self)
+        self.actionWaveBackend.setCheckable(True)
+        self.actionWaveBackend.setEnabled(PYQTGRAPH_AVAILABLE)
+        self.actionWaveBackend.setToolTip("切换 pyqtgraph 波形绘制" if PYQTGRAPH_AVAILABLE else "未安装 pyqtgraph")
+        self.actionWaveBackend.triggered.connect(self.toggle_wave_backend)
+        self.toolbar.addAction(self.actionWaveBackend)
+
+        self.actionMuteAlarm = QAction("报警静音", self)
         self.actionMuteAlarm.setCheckable(True)
         self.actionMuteAlarm.triggered.connect(self.toggle_alarm_mute)
         self.toolbar.addAction(self.actionMuteAlarm)
 
+        self.actionTrend = QAction("趋势", self)
+        self.actionTrend.triggered.connect(self.show_trend_view)
+        self.toolbar.addAction(self.actionTrend)
+
         self.viewMenu = QtWidgets.QMenu("视图", self)
         self.viewMenu.setStyleSheet(menu_style())
 
-        self.actionDebugPanel = QAction(self.icon("fa5s.terminal", "#56B6C2"), "显示协议调试", self)
+        self.actionDebugPanel = QAction("显示协议调试", self)
         self.actionDebugPanel.setCheckable(True)
         self.actionDebugPanel.setChecked(True)
         self.actionDebugPanel.triggered.connect(self.toggle_debug_panel)
         self.viewMenu.addAction(self.actionDebugPanel)
 
-        self.actionDockDebugLeft = QAction(self.icon("fa5s.arrow-left", "#ABB2BF"), "调试左侧", self)
+        self.actionDockDebugLeft = QAction("调试左侧", self)
         self.actionDockDebugLeft.triggered.connect(lambda: self.dock_debug_panel(Qt.LeftDockWidgetArea))
         self.viewMenu.addAction(self.actionDockDebugLeft)
 
-        self.actionDockDebugRight = QAction(self.icon("fa5s.arrow-right", "#ABB2BF"), "调试右侧", self)
+        self.actionDockDebugRight = QAction("调试右侧", self)
         self.actionDockDebugRight.triggered.connect(lambda: self.dock_debug_panel(Qt.RightDockWidgetArea))
         self.viewMenu.addAction(self.actionDockDebugRight)
 
+        self.actionStreamServer = QAction("本地数据流", self)
+        self.actionStreamServer.setCheckable(True)
+        self.actionStreamServer.triggered.connect(self.toggle_stream_server)
+        self.viewMenu.addAction(self.actionStreamServer)
+
+        self.actionShmRing = QAction("共享内存波形", self)
+        self.actionShmRing.setCheckable(True)
+        self.actionShmRing.triggered.connect(self.toggle_shm_ring)
+        self.viewMenu.addAction(self.actionShmRing)
+
+        self.actionEdfRecord = QAction("记录 EDF+", self)
+        self.actionEdfRecord.setCheckable(True)
+        self.actionEdfRecord.triggered.connect(self.toggle_edf_record)
+        self.viewMenu.addAction(self.actionEdfRecord)
+
         self.viewToolButton = QtWidgets.QToolButton(self)
-        self.viewToolButton.setIcon(self.icon("fa5s.layer-group", "#61AFEF"))
         self.viewToolButton.setText("视图")
         self.viewToolButton.setToolButtonStyle(Qt.ToolButtonTextBesideIcon)
         self.viewToolButton.setPopupMode(QtWidgets.QToolButton.InstantPopup)
@@ -193,14 +284,18 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
 
         self.toolbar.addSeparator()
 
-        self.actionAboutToolbar = QAction(self.icon("fa5s.info-circle", "#ABB2BF"), "关于", self)
+        self.actionAboutToolbar = QAction("关于", self)
         self.actionAboutToolbar.triggered.connect(self.slot_about)
         self.toolbar.addAction(self.actionAboutToolbar)
 
-        self.actionQuitToolbar = QAction(self.icon("fa5s.sign-out-alt", "#E06C75"), "退出", self)
+        self.actionQuitToolbar = QAction("退出", self)
         self.actionQuitToolbar.triggered.connect(self.slot_quit)
         self.toolbar.addAction(self.actionQuitToolbar)
 
+    def ensure_debug_dock(self):
+        if not hasattr(self, "debugDock"):
+            self.setup_debug_dock()
+
     def setup_debug_dock(self):
         self.debugDock = QtWidgets.QDockWidget("协议调试", self)
         self.debugDock.setAllowedAreas(Qt.LeftDockWidgetArea | Qt.RightDockWidgetArea)
@@ -219,9 +314,16 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.protocolStatsLabel.setStyleSheet(f"color: {COLORS['text_muted']}; font-family: {MONO_FONT}; font-size: 12px;")
         self.debugTextEdit = QtWidgets.QPlainTextEdit()
         self.debugTextEdit.setReadOnly(True)
-        self.debugTextEdit.setMaximumBlockCount(300)
+        self.debugTextEdit.setMaximumBlockCount(DEBUG_VIEW_LINES)
         self.debugTextEdit.setStyleSheet(debug_text_style())
+        self.latencyStatsLabel = QtWidgets.QLabel()
+        self.latencyStatsLabel.setStyleSheet(self.protocolStatsLabel.styleSheet())
         debug_layout.addWidget(self.protocolStatsLabel)
+        self.profilerStatsLabel = QtWidgets.QLabel()
+        self.profilerStatsLabel.setStyleSheet(self.protocolStatsLabel.styleSheet())
+        self.profilerStatsLabel.hide()
+        debug_layout.addWidget(self.latencyStatsLabel)
+        debug_layout.addWidget(self.profilerStatsLabel)
         debug_layout.addWidget(self.debugTextEdit, 1)
 
         controls_group = QtWidgets.QGroupBox("DEBUG OUTPUT")
@@ -242,31 +344,77 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.errorOnlyButton.setCursor(Qt.PointingHandCursor)
         self.errorOnlyButton.toggled.connect(self.toggle_debug_error_only)
 
+        self.trafficButton = QtWidgets.QPushButton("隐藏收发")
+        self.trafficButton.setCheckable(True)
+        self.trafficButton.setCursor(Qt.PointingHandCursor)
+        self.trafficButton.toggled.connect(self.toggle_debug_traffic)
+
         self.clearDebugButton = QtWidgets.QPushButton("清空调试")
         self.clearDebugButton.setObjectName("clearDebugButton")
         self.clearDebugButton.setCursor(Qt.PointingHandCursor)
         self.clearDebugButton.clicked.connect(self.clear_debug_output)
 
+        self.profileButton = QtWidgets.QPushButton("性能分析")
+        self.profileButton.setCheckable(True)
+        self.profileButton.setCursor(Qt.PointingHandCursor)
+        self.profileButton.toggled.connect(self.toggle_profiler)
+
+        self.sampleProfileButton = QtWidgets.QPushButton("采样分析")
+        self.sampleProfileButton.setCursor(Qt.PointingHandCursor)
+        self.sampleProfileButton.clicked.connect(self.start_sampling_profile)
+        self.sampleSecondsSpin = QtWidgets.QSpinBox()
+        self.sampleSecondsSpin.setRange(1, 120)
+        self.sampleSecondsSpin.setValue(PROFILE_SAMPLE_S)
+        self.sampleSecondsSpin.setSuffix(" s")
+
         controls_layout.addWidget(self.pauseDebugButton, 0, 0)
         controls_layout.addWidget(self.errorOnlyButton, 0, 1)
-        controls_layout.addWidget(self.clearDebugButton, 1, 0, 1, 2)
+        controls_layout.addWidget(self.trafficButton, 1, 0)
+        controls_layout.addWidget(self.clearDebugButton, 1, 1)
+        controls_layout.addWidget(self.profileButton, 2, 0)
+        sample_layout = QtWidgets.QHBoxLayout()
+        sample_layout.setSpacing(6)
+        sample_layout.addWidget(self.sampleProfileButton, 1)
+        sample_layout.addWidget(self.sampleSecondsSpin)
+        controls_layout.addLayout(sample_layout, 2, 1)
         debug_layout.addWidget(controls_group)
 
         self.debugDock.setWidget(debug_widget)
         self.debugDock.setStyleSheet(debug_dock_style())
         self.debugDock.visibilityChanged.connect(self.actionDebugPanel.setChecked)
+        self.debugDock.visibilityChanged.connect(self.on_debug_visibility_changed)
         self.addDockWidget(Qt.RightDockWidgetArea, self.debugDock)
         self.resizeDocks([self.debugDock], [360], Qt.Horizontal)
 
     def append_debug_log(self, text, level="info"):
+        self.debug_log.text(text, LEVEL_ERROR if level == "error" else LEVEL_INFO)
+
+    def debug_min_level(self):
+        if self.debug_error_only:
+            return LEVEL_ERROR
+        return LEVEL_INFO if self.debug_hide_traffic else LEVEL_TRAFFIC
+
+    def refresh_debug_view(self, full=False):
         if not hasattr(self, "debugTextEdit"):
             return
-        if self.debug_output_paused:
+        if full:
+            self.debugTextEdit.clear()
+            self.debug_rendered_seq = 0
+        elif self.debug_output_paused or not self.debugDock.isVisible():
             return
-        if self.debug_error_only and level != "error":
+        if self.debug_rendered_seq == self.debug_log.seq:
             return
-        timestamp = time.strftime("%H:%M:%S")
-        self.debugTextEdit.appendPlainText(f"{timestamp} {text}")
+        events = self.debug_log.since(self.debug_rendered_seq, self.debug_min_level(), DEBUG_VIEW_LINES)
+        self.debug_rendered_seq = self.debug_log.seq
+        if events:
+            self.debugTextEdit.appendPlainText("\n".join(DebugLog.format(event) for event in events))
+
+    def on_debug_visibility_changed(self, visible):
+        if visible:
+            self.debugRefreshTimer.start(100)
+            self.refresh_debug_view()
+        else:
+            self.debugRefreshTimer.stop()
 
     def toggle_debug_output_pause(self, checked):
         self.debug_output_paused = checked
@@ -275,31 +423,180 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
     def toggle_debug_error_only(self, checked):
         self.debug_error_only = checked
         self.errorOnlyButton.setText("显示全部" if checked else "只看错误")
+        self.refresh_debug_view(full=True)
+
+    def toggle_debug_traffic(self, checked):
+        self.debug_hide_traffic = checked
+        self.trafficButton.setText("显示收发" if checked else "隐藏收发")
+        self.refresh_debug_view(full=True)
 
     def clear_debug_output(self):
-        if hasattr(self, "debugTextEdit"):
-            self.debugTextEdit.clear()
+        self.debug_log.clear()
+        self.refresh_debug_view(full=True)
+
+    def profiler_targets(self):
+        from host_profiler import Target
+        targets = [
+            Target(self, "data_receive", "receive", (self.serialPortTimer.timeout,)),
+            Target(self, "data_process", "process", (self.procDataTimer.timeout,)),
+            Target(self, "analyzeWaveData", "analyze"),
+            Target(self, "analyzeParamData", "analyze"),
+            Target(self, "analyzeStatusData", "analyze"),
+            Target(self, "analyzeEventData", "analyze"),
+            Target(self, "drawECG1Wave", "draw"),
+            Target(self, "drawRespWave", "draw"),
+            Target(self, "drawSPO2Wave", "draw"),
+            Target(self, "refresh_debug_view", "debug log", (self.debugRefreshTimer.timeout,)),
+            Target(self, "on_decoder_debug", "debug log", lists=(self.core.decoder.debug_listeners,)),
+            Target(self, "update_status_bar", "status", (self.statusTimer.timeout,)),
+        ]
+        if hasattr(self, "pyqtgraph_waves"):
+            waves = self.pyqtgraph_waves
+            targets.append(Target(waves, "refresh", "draw", (waves.timer.timeout,)))
+        return targets
+
+    def toggle_profiler(self, checked):
+        if checked:
+            if self.profiler is None:
+                from host_profiler import StageProfiler
+                self.profiler = StageProfiler()
+            self.profiler.enable(self.profiler_targets())
+            self.profilerStatsLabel.setText("性能分析中 ...")
+            self.profilerTimer.start(1000)
+        else:
+            self.profilerTimer.stop()
+            if self.profiler is not None:
+                self.profiler.disable()
+        self.profilerStatsLabel.setVisible(checked)
+        self.profileButton.setText("停止分析" if checked else "性能分析")
+        self.append_debug_log("PROFILE ON" if checked else "PROFILE OFF")
+
+    def update_profiler_stats(self):
+        self.profilerStatsLabel.setText(self.profiler.report())
+
+    def start_sampling_profile(self):
+        seconds = self.sampleSecondsSpin.value()
+        if self.sampler is None:
+            from host_profiler import SamplingProfiler
+            self.sampler = SamplingProfiler()
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "logs",
+                            time.strftime("profile_%Y%m%d_%H%M%S.folded"))
+        if not self.sampler.start(seconds, path):
+            return
+        self.sampleProfileButton.setEnabled(False)
+        self.append_debug_log(f"PROFILE SAMPLE {seconds} s")
+        QTimer.singleShot(seconds * 1000 + 100, self.finish_sampling_profile)
+
+    def finish_sampling_profile(self):
+        if self.sampler.running:
+            QTimer.singleShot(100, self.finish_sampling_profile)
+            return
+        self.sampleProfileButton.setEnabled(True)
+        self.logger.info("采样分析完成: %s (%d 个样本)", self.sampler.path, self.sampler.samples)
+        self.append_debug_log(f"PROFILE {self.sampler.samples} samples -> {self.sampler.path}")
+
+    def on_decoder_debug(self, kind, payload):
+        if kind == "rx":
+            self.debug_log.rx(payload)
+        elif kind == "pack":
+            self.debug_log.pack(payload)
+        elif kind == "sync":
+            self.debug_log.sync_error(payload)
+
+    def on_packets_decoded(self, core, packets):
+        if self.trend_store is not None and any(is_param_packet(packet) for packet in packets):
+            state = core.state
+            self.trend_store.add(time.time(), state.hr, state.resp_rate, state.spo2)
+
+    def toggle_stream_server(self, checked):
+        if not checked:
+            if self.stream_server is not None:
+                self.stream_server.stop()
+            self.append_debug_log("STREAM OFF")
+            return
+        if self.stream_server is None:
+            from stream_server import DEFAULT_PORT, StreamServer
+            self.stream_server = StreamServer(port=DEFAULT_PORT, device="GUI", logger=self.logger)
+            self.stream_server.attach(self.core)
+        try:
+            host, port = self.stream_server.start()[:2]
+        except OSError as exc:
+            self.logger.warning("数据流服务启动失败: %s", exc)
+            self.append_debug_log(f"STREAM error: {exc}", level="error")
+            self.actionStreamServer.setChecked(False)
+            return
+        self.append_debug_log(f"STREAM ON {host}:{port}")
+
+    def toggle_shm_ring(self, checked):
+        if checked and self.shm_writer is None:
+            from shm_ring import DEFAULT_NAME, ShmRingWriter
+            self.shm_writer = ShmRingWriter(DEFAULT_NAME)
+            self.shm_writer.attach(self.core)
+            self.actionShmRing.setText(f"共享内存波形 {DEFAULT_NAME}")
+            self.append_debug_log(f"SHM ON {DEFAULT_NAME}")
+        elif not checked and self.shm_writer is not None:
+            self.core.packet_listeners.remove(self.shm_writer.on_packets)
+            self.shm_writer.close()
+            self.shm_writer = None
+            self.append_debug_log("SHM OFF")
+
+    def toggle_edf_record(self, checked):
+        if checked and self.edf_writer is None:
+            directory = os.path.join(os.path.dirname(os.path.abspath(__file__)), "recordings")
+            os.makedirs(directory, exist_ok=True)
+            path = os.path.join(directory, time.strftime("GUI_%Y%m%d_%H%M%S.edf"))
+            from edf_writer import EdfWriter
+            self.edf_writer = EdfWriter(path)
+            self.edf_writer.attach(self.core)
+            self.logger.info("EDF+ 记录开始: %s", path)
+            self.append_debug_log(f"EDF ON {path}")
+        elif not checked and self.edf_writer is not None:
+            self.core.packet_listeners.remove(self.edf_writer.on_packets)
+            self.core.alarm_listeners.remove(self.edf_writer.on_alarms)
+            self.edf_writer.close()
+            self.logger.info("EDF+ 记录结束: %s (%d s)", self.edf_writer.path, self.edf_writer.records)
+            self.append_debug_log(f"EDF OFF {self.edf_writer.records} s")
+            self.edf_writer = None
+
+    def show_trend_view(self):
+        self.finish_startup()
+        if self.trend_view is None:
+            from trend_view import TrendView
+            self.trend_view = TrendView(self.trend_store, self)
+            self.trend_view.resize(960, 600)
+        self.trend_view.show()
+        self.trend_view.raise_()
+
+    def on_alarm_raised(self, core, result, raised):
+        for alarm in raised:
+            self.append_debug_log(f"ALARM {alarm}", level="error")
 
     def update_protocol_stats(self):
         if not hasattr(self, "protocolStatsLabel"):
             return
+        decoder = self.core.decoder
+        counts = self.core.state.packet_counts
         self.protocolStatsLabel.setText(
-            f"RX {self.rx_bytes} B | PACK {self.rx_packets} | "
-            f"WAVE {self.packet_counts[0x10]} PARAM {self.packet_counts[0x11]} "
-            f"STATUS {self.packet_counts[0x12]} | ERR {self.checksum_error_count}"
+            f"RX {decoder.rx_bytes} B | PACK {decoder.rx_packets} | "
+            f"WAVE {counts[MODULE_WAVE]} PARAM {counts[MODULE_PARAM]} "
+            f"STATUS {counts[MODULE_STATUS]} | ERR {decoder.checksum_error_count}"
         )
+        baudrate = getattr(self.ser, "baudrate", None) if self.ser.isOpen() else None
+        self.latencyStatsLabel.setText(self.latency.report(self.latency.link_utilization(decoder.rx_bytes, baudrate)))
 
     def update_status_bar(self):
         elapsed = int(time.time() - self.start_time)
-        alarm_text = "正常" if not self.active_alarms else "报警: " + " / ".join(self.active_alarms[:3])
+        decoder = self.core.decoder
+        active_alarms = self.core.alarms.active_alarms
+        alarm_text = "正常" if not active_alarms else "报警: " + " / ".join(active_alarms[:3])
         paused_text = "暂停" if self.wave_paused else "运行"
         mute_text = "静音" if self.alarm_muted else "响铃"
         self.statusStr = (
             f"串口 {self.current_port_label} {self.current_baudrate} | "
-            f"RX {self.rx_bytes}B 包 {self.rx_packets} 错 {self.checksum_error_count} | "
+            f"RX {decoder.rx_bytes}B 包 {decoder.rx_packets} 错 {decoder.checksum_error_count} | "
             f"波形 {paused_text} | 报警 {mute_text} {alarm_text} | 运行 {elapsed}s"
         )
-        self.statusBar().showMessage(self.statusStr)
+        self.view.set("status", self.statusStr)
         self.update_protocol_stats()
 
     def setup_responsive_ui(self):
@@ -313,7 +610,7 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.setFont(base_font)
 
         self.setStyleSheet(main_window_style())
-        self.centralwidget.setStyleSheet(f"background-color: {COLORS['window']};")
+        self.centralwidget.setStyleSheet(central_widget_style())
         self.menubar.setStyleSheet(menu_bar_style())
         self.statusBar().setStyleSheet(status_bar_style())
 
@@ -363,13 +660,11 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             label.setStyleSheet("")
             label.setAutoFillBackground(False)
 
-        for value_label in (self.heartRateLabel, self.labelSPO2Data, self.respRateLabel):
+        for value_label, channel in ((self.heartRateLabel, "ecg"), (self.labelSPO2Data, "spo2"), (self.respRateLabel, "resp")):
             value_label.setObjectName("metricValue")
+            value_label.setProperty("channel", channel)
             value_label.setFont(value_font)
             value_label.setAlignment(Qt.AlignCenter)
-        self.heartRateLabel.setStyleSheet(metric_value_style(COLORS["ecg"]))
-        self.labelSPO2Data.setStyleSheet(metric_value_style(COLORS["spo2"]))
-        self.respRateLabel.setStyleSheet(metric_value_style(COLORS["resp"]))
 
         for name_label in (self.heartRateTextLabel, self.spo2InfoLabel, self.respUnitLabel):
             name_label.setObjectName("metricName")
@@ -388,18 +683,16 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             status_label.setObjectName("statusText")
             status_label.setAlignment(Qt.AlignCenter)
             status_label.setText("等待信号")
-            status_label.setStyleSheet(status_label_style(False))
 
         self.heartRateLabel.setText("---")
         self.labelSPO2Data.setText("---")
         self.respRateLabel.setText("---")
 
         self.heartLabel.setStyleSheet("background: transparent;")
-        self.heartLabel.setPixmap(QIcon(":/new/prefix1/image/heart.png").pixmap(28, 28))
         self.heartLabel.setScaledContents(False)
         self.heartLabel.setFixedSize(28, 28)
         self.heartOpacityEffect = QtWidgets.QGraphicsOpacityEffect(self.heartLabel)
-        self.heartOpacityEffect.setOpacity(1.0)
+        self.heartOpacityEffect.setOpacity(HEART_REST_OPACITY)
         self.heartLabel.setGraphicsEffect(self.heartOpacityEffect)
 
         self._setup_info_group_layouts()
@@ -411,7 +704,7 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.titleWaveLabel = QtWidgets.QLabel("TRIVITAL MONITOR")
         self.titleMetricLabel = QtWidgets.QLabel("报警状态: 正常")
         self.titleWaveLabel.setStyleSheet(f"color: {COLORS['primary']}; font-size: 32px; font-family: {MONO_FONT}; font-weight: 900;")
-        self.titleMetricLabel.setStyleSheet(alarm_title_style(False))
+        self.titleMetricLabel.setObjectName("alarmTitle")
         self.titleWaveLabel.setFont(bold_font("DejaVu Sans Mono", 22))
         self.titleMetricLabel.setFont(bold_font("SimHei", 13))
         header_layout.addWidget(self.titleWaveLabel, 1)
@@ -426,6 +719,7 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             (self.spo2Label, self.spo2WaveLabel, self.spo2InfoGroupBox),
             (self.respLabel, self.respWaveLabel, self.respInfoGroupBox),
         )
+        self.wave_sections = []
         for title_label, wave_label, info_box in row_configs:
             row_layout = QtWidgets.QHBoxLayout()
             row_layout.setSpacing(16)
@@ -434,6 +728,7 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             wave_section.setSpacing(5)
             wave_section.addWidget(title_label)
             wave_section.addWidget(wave_label, 1)
+            self.wave_sections.append(wave_section)
 
             info_section = QtWidgets.QVBoxLayout()
             info_section.setSpacing(5)
@@ -446,6 +741,19 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
 
         main_layout.addLayout(body_layout, 1)
 
+    def setup_view_model(self):
+        """Parameter, lead and alarm widgets are only updated through self.view, and only when their value changes."""
+        self.view = ViewModel()
+        for key, label in (("hr", self.heartRateLabel), ("resp_rate", self.respRateLabel), ("spo2", self.labelSPO2Data)):
+            self.view.bind_text(key, label)
+            self.view.bind_property(f"{key}_state", label, "state")
+        for name, label in zip(LEAD_NAMES, (self.labelecg_status, self.labelresp_status, self.labelspo2_status)):
+            self.view.bind_text(f"lead_{name}", label, lead_text)
+            self.view.bind_property(f"lead_{name}", label, "alarm", lambda ok: not ok)
+        self.view.bind_text("alarm_active", self.titleMetricLabel, alarm_title_text)
+        self.view.bind_property("alarm_active", self.titleMetricLabel, "alarm")
+        self.view.bind("status", self.statusBar().showMessage)
+
     def _setup_info_group_layouts(self):
         ecg_layout = QtWidgets.QGridLayout(self.ecgInfoGroupBox)
         ecg_layout.setContentsMargins(16, 12, 16, 12)
@@ -541,11 +849,32 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
 
     def _handle_wave_resize(self):
         self._wave_resize_pending = False
-        if hasattr(self, 'pixmapResp'):
+        if hasattr(self, 'pixmapResp') and self.wave_backend is None:
             self.create_wave_pixmaps()
 
+    def toggle_wave_backend(self, checked):
+        if checked and self.wave_backend is None:
+            if not hasattr(self, 'pyqtgraph_waves'):
+                from wave_pyqtgraph import PyqtgraphWaves
+                rows = zip(self.wave_sections, (self.ecg1WaveLabel, self.spo2WaveLabel, self.respWaveLabel),
+                           (COLORS["ecg"], COLORS["spo2"], COLORS["resp"]))
+                self.pyqtgraph_waves = PyqtgraphWaves(list(rows), self)
+            self.wave_backend = self.pyqtgraph_waves
+            self.wave_backend.clear()
+            self.wave_backend.activate(True)
+        elif not checked and self.wave_backend is not None:
+            self.wave_backend.activate(False)
+            self.wave_backend = None
+            self.mRespXStep = 0
+            self.mSPO2XStep = 0
+            self.mECG1XStep = 0
+            self.create_wave_pixmaps()
+        self.append_debug_log("WAVE BACKEND pyqtgraph" if checked else "WAVE BACKEND QPixmap")
+
     def toggle_wave_pause(self, checked):
         self.wave_paused = checked
+        if not checked and self.latency is not None:
+            self.latency.clear(len(self.mECG1WaveList))   # the backlog painted on resume is not pipeline latency
         self.actionPauseWave.setText("继续波形" if checked else "暂停波形")
         self.append_debug_log("WAVE PAUSE" if checked else "WAVE RESUME")
         self.update_status_bar()
@@ -558,9 +887,13 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
 
     def toggle_debug_panel(self, checked):
         self.debug_visible = checked
-        self.debugDock.setVisible(checked)
+        if checked:
+            self.ensure_debug_dock()
+        if hasattr(self, "debugDock"):
+            self.debugDock.setVisible(checked)
 
     def dock_debug_panel(self, area):
+        self.ensure_debug_dock()
         self.debugDock.setFloating(False)
         self.addDockWidget(area, self.debugDock)
         self.debugDock.show()
@@ -572,11 +905,16 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.mRespXStep = 0
         self.mSPO2XStep = 0
         self.mECG1XStep = 0
-        self.create_wave_pixmaps()
+        if self.wave_backend is not None:
+            self.wave_backend.clear()
+        else:
+            self.create_wave_pixmaps()
         self.append_debug_log("WAVE CLEAR")
         self.update_status_bar()
 
     def slot_serialSet(self):
+        self.finish_startup()                # the data path needs the latency and trend stores
+        from form_setuart import UartSet     # pulls in qfluentwidgets, only needed once the dialog is opened
         if self.ser.isOpen():
             self.uartset = UartSet(True)
         else:
@@ -603,6 +941,7 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             self.current_baudrate = str(baudRate)
             self.statusStr = "连接成功"
             self.logger.info("串口连接成功: %s %s", portNum, baudRate)
+            STARTUP.mark("serial_open")
             self.append_debug_log(f"OPEN {portNum} {baudRate},{dataBits},{parity},{stopBits}")
             self.serialPortTimer.start(2)
             self.procDataTimer.start(10)
@@ -631,68 +970,49 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             self.append_debug_log("TX ignored: serial closed", level="error")
 
     def data_receive(self):
+        read = time.perf_counter()
         try:
-            num = self.ser.inWaiting()
+            packets = self.core.poll()
         except Exception as exc:
             self.logger.warning("串口读取失败: %s", exc)
             self.append_debug_log(f"RX error: {exc}", level="error")
             self.disconnect_serial("串口读取失败")
             QMessageBox.warning(self, "串口断开", f"串口读取失败，已断开连接: {exc}")
             return None
-        if num > 0:
-            data = self.ser.read(num)
-            self.rx_bytes += len(data)
-            self.append_debug_log("RX " + " ".join(f"{byte:02X}" for byte in data[:32]) + (" ..." if len(data) > 32 else ""))
-            for i in range(0, len(data)):
-                byte = data[i]
-                if self.mPackUnpck.sGotPackId:
-                    if byte < 0x80 and self.mPackUnpck.sPackLen < 10:
-                        self.sync_error_count += 1
-                        self.checksum_error_count += 1
-                        self.append_debug_log(f"SYNC error byte={byte:02X}", level="error")
-                        self.mPackUnpck.sGotPackId = False
-                        self.mPackUnpck.sPackLen = 0
-                        self.mPackUnpck.sRestByteNum = 0
-                    elif byte >= 0x80 and self.mPackUnpck.sPackLen > 0 and self.mPackUnpck.sPackLen < 10:
-                        pass
-                else:
-                    if byte < 0x80:
-                        if hasattr(self, 'sync_error_count') and self.sync_error_count > self.sync_error_threshold:
-                            self.reset_packet_sync()
-                            self.sync_error_count = 0
-                findPack = self.mPackUnpck.unpackData(byte)
-                if findPack:
-                    self.sync_error_count = 0
-                    temp = self.mPackUnpck.getUnpackRslt()
-                    self.mPackAfterUnpackArr.append(copy.deepcopy(temp))
-                    self.rx_packets += 1
-                    self.last_packet_time = time.time()
-                    self.append_debug_log("PACK " + " ".join(f"{value:02X}" for value in temp[:8]))
-                elif byte < 0x80 and not self.mPackUnpck.sGotPackId:
-                    pass
-        else:
-            if hasattr(self, 'sync_error_count') and self.sync_error_count > self.sync_error_threshold:
-                self.reset_packet_sync()
-                self.sync_error_count = 0
+        self.latency.on_decoded(packets, read, time.perf_counter())
+        if packets and STARTUP.mark("first_packet"):
+            self.logger.info("启动耗时 (ms):\n%s", STARTUP.report())
+            opened = STARTUP.ms("serial_open")
+            after_open = "" if opened is None else f", {STARTUP.ms('first_packet') - opened:.0f} ms after open"
+            self.append_debug_log(f"STARTUP first packet {STARTUP.ms('first_packet'):.0f} ms{after_open}")
+        self.mPackAfterUnpackArr.extend(packets)
 
     def data_process(self):
         num = len(self.mPackAfterUnpackArr)
         if num > 0:
+            self.latency.on_process(time.perf_counter())
             for i in range(num):
                 packet = self.mPackAfterUnpackArr[i]
                 module_id = packet[0]
-                if module_id in self.packet_counts:
-                    self.packet_counts[module_id] += 1
-
-                if module_id == 0x10:
+                if module_id == MODULE_WAVE:
                     self.analyzeWaveData(packet)
-                elif module_id == 0x11:
+                elif is_param_packet(packet):
                     self.analyzeParamData(packet)
-                elif module_id == 0x12:
+                elif module_id == MODULE_PARAM:
+                    self.analyzeEventData(packet)
+                elif module_id == MODULE_STATUS:
                     self.analyzeStatusData(packet)
             del self.mPackAfterUnpackArr[0:num]
         if self.wave_paused:
             return
+        if self.wave_backend is not None:
+            self.wave_backend.push(self.mECG1WaveList, self.mSPO2WaveList, self.mRespWaveList, marks=self.mECG1BeatMarks)
+            self.latency.on_paint(len(self.mECG1WaveList), time.perf_counter())   # drawn by the next refresh
+            self.mECG1WaveList = []
+            self.mECG1BeatMarks = []
+            self.mSPO2WaveList = []
+            self.mRespWaveList = []
+            return
         if len(self.mRespWaveList) > 2:
             self.drawRespWave()
         if len(self.mSPO2WaveList) > 2:
@@ -701,9 +1021,9 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             self.drawECG1Wave()
 
     def analyzeWaveData(self, data):
-        ecg_data = self.convert_signed_16bit(data[2], data[3])
-        resp_data = self.convert_signed_16bit(data[4], data[5])
-        spo2_data = self.convert_signed_16bit(data[6], data[7])
+        ecg_data = to_int16(data[2], data[3])
+        resp_data = to_int16(data[4], data[5])
+        spo2_data = to_int16(data[6], data[7])
         if self.adaptive_scale_enabled:
             self.ecg_sliding_buffer.append(ecg_data)
             self.resp_sliding_buffer.append(resp_data)
@@ -728,100 +1048,53 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self.mRespWaveList.append(resp_data)
         self.mSPO2WaveList.append(spo2_data)
 
-    def analyzeParamData(self, data):
-        hr = (data[2] << 8) | data[3]
-        resp_rate = (data[4] << 8) | data[5]
-        spo2_value = (data[6] << 8) | data[7]
+    def analyzeEventData(self, data):
+        event = parse_event(data)
+        if event is None or data[1] != ID2_EVENT_QRS:
+            return
+        # the event follows the wave packet of the sample that confirmed the peak, lag samples after it
+        index = len(self.mECG1WaveList) - 1 - event.lag
+        if index >= 0 or self.wave_backend is not None:    # the pyqtgraph ring still holds earlier samples
+            self.mECG1BeatMarks.append(index)
+        self.heartOpacityEffect.setOpacity(1.0)
+        self.heartShapeTimer.start(HEART_PULSE_MS)
 
-        if 0 < hr < 300:
-            self.last_hr = hr
-            self.heartRateLabel.setText(str(hr))
-        else:
-            self.last_hr = None
-            self.heartRateLabel.setText("---")
-        if 0 < resp_rate < 120:
-            self.last_resp_rate = resp_rate
-            self.respRateLabel.setText(str(resp_rate))
-        else:
-            self.last_resp_rate = None
-            self.respRateLabel.setText("---")
-        if 0 <= spo2_value <= 100:
-            self.last_spo2 = spo2_value
-            self.labelSPO2Data.setText(str(spo2_value))
-        else:
-            self.last_spo2 = None
-            self.labelSPO2Data.setText("---")
+    def analyzeParamData(self, data):
+        state = self.core.state
+        self.view.set("hr", state.hr)
+        self.view.set("resp_rate", state.resp_rate)
+        self.view.set("spo2", state.spo2)
         self.evaluate_alarms()
 
     def analyzeStatusData(self, data):
-        ecg_lead_status = data[2]
-        leadecg = ecg_lead_status
-
-        resp_lead_status = data[4]
-        leadresp = resp_lead_status
-
-        spo2_lead_status = data[6]
-        leadspo2 = spo2_lead_status
-        self.lead_status["ECG"] = bool(leadecg)
-        self.lead_status["RESP"] = bool(leadresp)
-        self.lead_status["SpO2"] = bool(leadspo2)
-
-        if leadecg:
-            self.labelecg_status.setText("导联正常")
-            self.labelecg_status.setStyleSheet(status_label_style(False))
-        else:
-            self.labelecg_status.setText("导联异常")
-            self.labelecg_status.setStyleSheet(status_label_style(True))
-
-        if leadresp:
-            self.labelresp_status.setText("导联正常")
-            self.labelresp_status.setStyleSheet(status_label_style(False))
-        else:
-            self.labelresp_status.setText("导联异常")
-            self.labelresp_status.setStyleSheet(status_label_style(True))
-
-        if leadspo2:
-            self.labelspo2_status.setText("导联正常")
-            self.labelspo2_status.setStyleSheet(status_label_style(False))
-        else:
-            self.labelspo2_status.setText("导联异常")
-            self.labelspo2_status.setStyleSheet(status_label_style(True))
+        state = self.core.state
+        for name in LEAD_NAMES:
+            ok = state.lead_status[name]
+            shown = self.view.get(f"lead_{name}")
+            if ok is None or not self.view.set(f"lead_{name}", ok):
+                continue
+            if not ok and shown is not None:
+                # serial receive -> label update; the firmware side is debounce + at most one 2 ms task period
+                latency = (time.time() - state.lead_change_time[name]) * 1000
+                self.lead_off_latency_ms.append(latency)
+                self.logger.info("%s 导联脱落显示延迟 %.1f ms", name, latency)
+                self.append_debug_log(f"LEAD {name} off, display +{latency:.1f} ms", level="error")
         self.evaluate_alarms()
 
-    def set_metric_state(self, label, normal_color, alarm=False, invalid=False):
-        if invalid:
-            color = COLORS["text_dim"]
-        elif alarm:
-            color = COLORS["alarm"]
-        else:
-            color = normal_color
-        label.setStyleSheet(metric_value_style(color))
-
     def evaluate_alarms(self):
-        result = evaluate_alarm_state(
-            self.last_hr,
-            self.last_resp_rate,
-            self.last_spo2,
-            self.lead_status,
-            self.alarm_limits,
-        )
+        state = self.core.state
+        result = self.core.alarms.result
+        if result is None:
+            return
         alarms = result.alarms
-
-        previous = set(self.active_alarms)
-        current = set(alarms)
-        for alarm in sorted(current - previous):
-            self.logger.warning("报警触发: %s", alarm)
-            self.append_debug_log(f"ALARM {alarm}", level="error")
-
-        self.active_alarms = alarms
-        self.set_metric_state(self.heartRateLabel, COLORS["ecg"], result.hr_alarm, self.last_hr is None)
-        self.set_metric_state(self.respRateLabel, COLORS["resp"], result.resp_alarm, self.last_resp_rate is None)
-        self.set_metric_state(self.labelSPO2Data, COLORS["spo2"], result.spo2_alarm, self.last_spo2 is None)
-        self.titleMetricLabel.setText("报警状态: 异常" if alarms else "报警状态: 正常")
-        self.titleMetricLabel.setStyleSheet(alarm_title_style(bool(alarms)))
+        self.view.set("hr_state", metric_state(result.hr_alarm, state.hr is None))
+        self.view.set("resp_rate_state", metric_state(result.resp_alarm, state.resp_rate is None))
+        self.view.set("spo2_state", metric_state(result.spo2_alarm, state.spo2 is None))
+        self.view.set("alarm_active", bool(alarms))
         if alarms and not self.alarm_muted:
             QApplication.beep()
-        self.update_status_bar()
+        if self.view.set("alarms", tuple(alarms)):
+            self.update_status_bar()    # otherwise the 500 ms status timer is soon enough
 
     def drawRespWave(self):
         iCnt = len(self.mRespWaveList)
@@ -862,12 +1135,6 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         del self.mRespWaveList[0:iCnt - 1]
         self.respWaveLabel.setPixmap(self.pixmapResp)
 
-    def reset_packet_sync(self):
-        self.mPackUnpck.sGotPackId = False
-        self.mPackUnpck.sPackLen = 0
-        self.mPackUnpck.sRestByteNum = 0
-        self.mPackUnpck.mBufList = [0] * 10
-
     def drawSPO2Wave(self):
         iCnt = len(self.mSPO2WaveList)
         if iCnt == 0:
@@ -944,14 +1211,34 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
             self.mECG1XStep += 1
             if self.mECG1XStep >= self.maxECG1Length:
                 self.mECG1XStep = 0
+        self.drawBeatMarks(iCnt - 1)
         del self.mECG1WaveList[0:iCnt - 1]
         self.ecg1WaveLabel.setPixmap(self.pixmapECG1)
+        self.latency.on_paint(iCnt - 1, time.perf_counter())
+
+    def drawBeatMarks(self, drawn):
+        """Tick the QRS peaks among the drawn samples just painted; the rest shift with the list."""
+        if not self.mECG1BeatMarks:
+            return
+        start = self.mECG1XStep - drawn
+        self.painterEcg1.setPen(QPen(QColor(COLORS["white"]), 2, Qt.SolidLine))
+        pending = []
+        for index in self.mECG1BeatMarks:
+            if index < drawn:
+                x = (start + index) % self.maxECG1Length
+                self.painterEcg1.drawLine(QPoint(x, 0), QPoint(x, BEAT_MARK_HEIGHT))
+            else:
+                pending.append(index - drawn)
+        self.mECG1BeatMarks = pending
 
-    def heartShapeFlash(self):
-        self.heart_icon_visible = not self.heart_icon_visible
-        self.heartOpacityEffect.setOpacity(1.0 if self.heart_icon_visible else 0.18)
+    def heartShapeRest(self):
+        self.heartOpacityEffect.setOpacity(HEART_REST_OPACITY)
 
     def event(self, event: QtCore.QEvent) -> bool:
+        if event.type() == QtCore.QEvent.Paint and not self.startup_scheduled:
+            self.startup_scheduled = True
+            STARTUP.mark("window")
+            QTimer.singleShot(0, self.finish_startup)
         if event.type() == event.StatusTip:
             if event.tip() == "":
                 event = QStatusTipEvent(self.statusStr)
@@ -961,6 +1248,12 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
         self._end_painter('painterResp')
         self._end_painter('painterSPO2')
         self._end_painter('painterEcg1')
+        if self.trend_store is not None:
+            self.trend_store.close()
+        if self.stream_server is not None:
+            self.stream_server.stop()
+        self.toggle_shm_ring(False)
+        self.toggle_edf_record(False)
         sys.exit(0)
 
     def slot_about(self):
@@ -972,7 +1265,10 @@ class ParamMonitor(QtWidgets.QMainWindow, Ui_MainWindow):
 
     def clearData(self):
         self.mPackAfterUnpackArr = []
+        if self.latency is not None:
+            self.latency.clear()
         self.mECG1WaveList = []
+        self.mECG1BeatMarks = []
         self.mSPO2WaveList = []
         self.mRespWaveList = []
         self.ecg_min_val, self.ecg_max_val = float('inf'), float('-inf')
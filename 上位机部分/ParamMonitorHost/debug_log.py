@@ -0,0 +1,73 @@
+import time
+from collections import deque
+
+LEVEL_TRAFFIC = 0   # raw RX chunks and decoded packets
+LEVEL_INFO = 1      # connection / UI events
+LEVEL_ERROR = 2
+
+KIND_TEXT = 0
+KIND_RX = 1
+KIND_PACK = 2
+KIND_SYNC = 3
+
+RX_DUMP_BYTES = 32
+PACK_DUMP_BYTES = 8
+
+
+def hex_dump(data, limit):
+    text = data[:limit].hex(" ").upper()
+    return text + " ..." if len(data) > limit else text
+
+
+class DebugLog:
+    """Fixed-size ring of raw debug events; text is only built for what is displayed.
+
+    Recording an event is a tuple append: bytes are kept as received and the
+    hex/timestamp strings are produced by format() when the view asks for them.
+    """
+
+    def __init__(self, capacity=4096):
+        self.events = deque(maxlen=capacity)
+        self.seq = 0
+
+    def record(self, kind, level, payload):
+        self.seq += 1
+        self.events.append((self.seq, time.time(), kind, level, payload))
+
+    def text(self, text, level=LEVEL_INFO):
+        self.record(KIND_TEXT, level, text)
+
+    def rx(self, data):
+        self.record(KIND_RX, LEVEL_TRAFFIC, data)
+
+    def pack(self, packet):
+        self.record(KIND_PACK, LEVEL_TRAFFIC, bytes(packet[:PACK_DUMP_BYTES]))
+
+    def sync_error(self, byte):
+        self.record(KIND_SYNC, LEVEL_ERROR, byte)
+
+    def clear(self):
+        self.events.clear()
+
+    def since(self, seq, min_level, limit):
+        """Newest `limit` events after `seq` at or above `min_level`, oldest first."""
+        picked = []
+        for event in reversed(self.events):
+            if event[0] <= seq or len(picked) >= limit:
+                break
+            if event[3] >= min_level:
+                picked.append(event)
+        picked.reverse()
+        return picked
+
+    @staticmethod
+    def format(event):
+        _, t, kind, _, payload = event
+        stamp = time.strftime("%H:%M:%S", time.localtime(t))
+        if kind == KIND_RX:
+            return f"{stamp} RX {hex_dump(payload, RX_DUMP_BYTES)}"
+        if kind == KIND_PACK:
+            return f"{stamp} PACK {hex_dump(payload, PACK_DUMP_BYTES)}"
+        if kind == KIND_SYNC:
+            return f"{stamp} SYNC error byte={payload:02X}"
+        return f"{stamp} {payload}"
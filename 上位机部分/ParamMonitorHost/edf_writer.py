@@ -0,0 +1,230 @@
+import argparse
+import os
+import sys
+import time
+from collections import deque
+
+import numpy as np
+
+from monitor_core import (ID2_PARAM, MODULE_PARAM, MODULE_STATUS, MODULE_WAVE, PACKET_LEN, TVR_HEADER, TVR_MAGIC, TVR_RECORD,
+                          AlarmEvaluator, VitalsState)
+
+SIGNALS = (("ECG", "ECG"), ("Resp", "Resp thoracic impedance"), ("Pleth", "PPG finger"))
+SAMPLE_RATE = 250
+RECORD_SECONDS = 1
+ANNOTATION_BYTES = 256          # per data record, holds the time-keeping TAL plus a few events
+LEAD_NAMES = ("ECG", "RESP", "SpO2")
+
+TVR_DTYPE = np.dtype([("t", "<f8"), ("packet", "u1", PACKET_LEN)])
+assert TVR_DTYPE.itemsize == TVR_RECORD.size
+
+
+def field(text, width):
+    text = text.encode("ascii", "replace")[:width]
+    return text + b" " * (width - len(text))
+
+
+def tal(onset, text=""):
+    """One Time-stamped Annotation List entry."""
+    return f"{onset:+.3f}".rstrip("0").rstrip(".").encode() + b"\x14" + text.encode("utf-8") + b"\x14\x00"
+
+
+def fit_tal(onset, text, room):
+    """Shorten text (on a UTF-8 character boundary) so tal(onset, text) takes at most room bytes."""
+    over = len(tal(onset, text)) - room
+    if over > 0:
+        raw = text.encode("utf-8")
+        text = raw[:max(len(raw) - over, 0)].decode("utf-8", "ignore")
+    return text
+
+
+class EdfWriter:
+    """Streaming EDF+C writer: ECG/RESP/Pleth as int16 plus an EDF Annotations signal.
+
+    Samples are buffered for at most one data record and annotations until the
+    record they fall in is written, so memory does not grow with session length.
+    The header carries -1 records while writing and is patched on close().
+    """
+
+    def __init__(self, path, start=None, patient="X X X X", equipment="TriVital"):
+        self.path = path
+        self.start = time.localtime(start if start is not None else time.time())
+        self.spr = SAMPLE_RATE * RECORD_SECONDS
+        self.file = open(path, "wb")
+        self.records = 0
+        self.buffer = np.zeros((self.spr, len(SIGNALS)), dtype=np.int16)
+        self.filled = 0
+        self.annotations = deque()
+        self.lead_status = dict.fromkeys(LEAD_NAMES)
+        self.file.write(self._header(-1, patient, equipment))
+
+    @property
+    def seconds(self):
+        return (self.records * self.spr + self.filled) / SAMPLE_RATE
+
+    def _header(self, records, patient, equipment):
+        ns = len(SIGNALS) + 1
+        startdate = time.strftime("%d-%b-%Y", self.start).upper()
+        head = (field("0", 8) + field(patient, 80) + field(f"Startdate {startdate} X X {equipment}", 80) +
+                field(time.strftime("%d.%m.%y", self.start), 8) + field(time.strftime("%H.%M.%S", self.start), 8) +
+                field(str(256 * (ns + 1)), 8) + field("EDF+C", 44) + field(str(records), 8) +
+                field(str(RECORD_SECONDS), 8) + field(str(ns), 4))
+        labels = [label for label, _ in SIGNALS] + ["EDF Annotations"]
+        transducers = [transducer for _, transducer in SIGNALS] + [""]
+        columns = (
+            [field(v, 16) for v in labels],
+            [field(v, 80) for v in transducers],
+            [field("ADU", 8)] * len(SIGNALS) + [field("", 8)],
+            [field("-32768", 8)] * len(SIGNALS) + [field("-1", 8)],
+            [field("32767", 8)] * len(SIGNALS) + [field("1", 8)],
+            [field("-32768", 8)] * ns,
+            [field("32767", 8)] * ns,
+            [field("", 80)] * ns,
+            [field(str(self.spr), 8)] * len(SIGNALS) + [field(str(ANNOTATION_BYTES // 2), 8)],
+            [field("", 32)] * ns,
+        )
+        return head + b"".join(b"".join(column) for column in columns)
+
+    def annotate(self, onset, text):
+        # an entry longer than an otherwise empty block could never be written
+        record = max(self.records, int(onset // RECORD_SECONDS))
+        text = fit_tal(onset, text, ANNOTATION_BYTES - len(tal(record * RECORD_SECONDS)))
+        self.annotations.append((onset, text))
+
+    def _annotation_block(self, record):
+        onset = record * RECORD_SECONDS
+        block = tal(onset)
+        keeping = len(block)
+        while self.annotations and self.annotations[0][0] < onset + RECORD_SECONDS:
+            entry = tal(*self.annotations[0])
+            if len(block) + len(entry) > ANNOTATION_BYTES:
+                if len(block) > keeping:
+                    break   # spills into the next record
+                # spilled into a record whose time-keeping TAL is wider than annotate() allowed for
+                entry_onset, text = self.annotations[0]
+                entry = tal(entry_onset, fit_tal(entry_onset, text, ANNOTATION_BYTES - keeping))
+            block += entry
+            self.annotations.popleft()
+        return block + b"\x00" * (ANNOTATION_BYTES - len(block))
+
+    def write_samples(self, samples):
+        """samples: (n, 3) int16 in ECG, RESP, Pleth order."""
+        samples = np.asarray(samples, dtype=np.int16)
+        if self.filled:
+            take = min(len(samples), self.spr - self.filled)
+            self.buffer[self.filled:self.filled + take] = samples[:take]
+            self.filled += take
+            samples = samples[take:]
+            if self.filled < self.spr:
+                return
+            self._write_records(self.buffer[None])
+            self.filled = 0
+        whole = len(samples) // self.spr
+        if whole:
+            self._write_records(samples[:whole * self.spr].reshape(whole, self.spr, len(SIGNALS)))
+        rest = samples[whole * self.spr:]
+        self.buffer[:len(rest)] = rest
+        self.filled = len(rest)
+
+    def _write_records(self, blocks):
+        """blocks: (k, spr, signals) -> k EDF data records in one write."""
+        k = len(blocks)
+        signal_bytes = self.spr * len(SIGNALS) * 2
+        out = np.empty((k, signal_bytes + ANNOTATION_BYTES), dtype=np.uint8)
+        out[:, :signal_bytes] = np.ascontiguousarray(blocks.transpose(0, 2, 1)).astype("<i2").view(np.uint8).reshape(k, -1)
+        for i in range(k):
+            out[i, signal_bytes:] = np.frombuffer(self._annotation_block(self.records + i), dtype=np.uint8)
+        self.file.write(out.tobytes())
+        self.records += k
+
+    # live acquisition: MonitorCore listeners
+    def attach(self, core):
+        core.packet_listeners.append(self.on_packets)
+        core.alarm_listeners.append(self.on_alarms)
+
+    def on_packets(self, core, packets):
+        wave = [p for p in packets if p[0] == MODULE_WAVE]
+        if wave:
+            raw = np.array(wave, dtype=np.uint8)[:, 2:8].astype(np.uint16)
+            self.write_samples((raw[:, 0::2] << 8 | raw[:, 1::2]).view(np.int16))
+        if any(p[0] == MODULE_STATUS for p in packets):
+            self.note_leads(core.state.lead_status)
+
+    def on_alarms(self, core, result, raised):
+        for alarm in raised:
+            if not alarm.endswith("导联异常"):   # lead changes are annotated by note_leads
+                self.annotate(self.seconds, f"报警 {alarm}")
+
+    def note_leads(self, lead_status, onset=None):
+        """Annotate lead-off / lead-on transitions (the first report only if it is off)."""
+        onset = self.seconds if onset is None else onset
+        for name in LEAD_NAMES:
+            ok = lead_status.get(name)
+            if ok is not None and ok != self.lead_status[name]:
+                if self.lead_status[name] is not None or not ok:
+                    self.annotate(onset, f"{name}导联{'恢复' if ok else '脱落'}")
+                self.lead_status[name] = ok
+
+    def close(self):
+        if self.file.closed:
+            return
+        if self.filled:
+            self.buffer[self.filled:] = 0
+            self._write_records(self.buffer[None])
+            self.filled = 0
+        while self.annotations:
+            self._write_records(np.zeros((1, self.spr, len(SIGNALS)), dtype=np.int16))
+        self.file.seek(236)
+        self.file.write(field(str(self.records), 8))
+        self.file.close()
+
+
+def convert_recording(tvr_path, edf_path, chunk_records=1 << 18):
+    """Batch .tvr -> EDF+; wave packets are decoded with numpy one chunk at a time."""
+    with open(tvr_path, "rb") as f:
+        magic, _, _, start_time, _ = TVR_HEADER.unpack(f.read(TVR_HEADER.size))
+    if magic != TVR_MAGIC:
+        raise ValueError(f"{tvr_path}: not a TriVital recording")
+    count = (os.path.getsize(tvr_path) - TVR_HEADER.size) // TVR_RECORD.size
+    records = np.memmap(tvr_path, dtype=TVR_DTYPE, mode="r", offset=TVR_HEADER.size, shape=(count,))
+    writer = EdfWriter(edf_path, start=start_time)
+    state, alarms = VitalsState(), AlarmEvaluator()
+    for offset in range(0, count, chunk_records):
+        packets = records["packet"][offset:offset + chunk_records]
+        module = packets[:, 0]
+        is_wave = module == MODULE_WAVE
+        wave_before = np.cumsum(is_wave) - is_wave
+        # PARAM/STATUS are ~1 Hz: replay them through the same state/alarm code as the live path
+        is_param = (module == MODULE_PARAM) & (packets[:, 1] == ID2_PARAM)
+        for i in np.flatnonzero(is_param | (module == MODULE_STATUS)):
+            onset = writer.seconds + wave_before[i] / SAMPLE_RATE
+            packet = packets[i].tolist()
+            state.apply(packet, 0)
+            for alarm in alarms.evaluate(state):
+                if not alarm.endswith("导联异常"):
+                    writer.annotate(onset, f"报警 {alarm}")
+            if packet[0] == MODULE_STATUS:
+                writer.note_leads(state.lead_status, onset)
+        raw = packets[is_wave][:, 2:8].astype(np.uint16)
+        writer.write_samples((raw[:, 0::2] << 8 | raw[:, 1::2]).view(np.int16))
+    writer.close()
+    return writer.records
+
+
+def main():
+    parser = argparse.ArgumentParser(description="将 .tvr 会话记录转换为 EDF+")
+    parser.add_argument("recordings", nargs="+", help=".tvr 文件")
+    parser.add_argument("-o", "--out-dir", help="输出目录，缺省与输入相同")
+    args = parser.parse_args()
+    for path in args.recordings:
+        out_dir = args.out_dir or os.path.dirname(os.path.abspath(path))
+        os.makedirs(out_dir, exist_ok=True)
+        edf_path = os.path.join(out_dir, os.path.splitext(os.path.basename(path))[0] + ".edf")
+        start = time.perf_counter()
+        records = convert_recording(path, edf_path)
+        print(f"{path} -> {edf_path}: {records} s, {time.perf_counter() - start:.2f} s")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,182 @@
+import argparse
+import os
+import sys
+import threading
+import time
+
+import serial
+
+from monitor_core import MonitorCore, SerialSource, SimulatedSource, WAVE_RATE_HZ, is_param_packet, setup_logger
+from stream_server import StreamServer
+
+
+def open_serial(port, baudrate):
+    ser = serial.Serial()
+    ser.port = port
+    ser.baudrate = baudrate
+    ser.timeout = 0.05
+    ser.open()
+    return ser
+
+
+def device_worker(core, stop_event):
+    while not stop_event.is_set():
+        try:
+            core.poll(blocking=True)
+        except (serial.SerialException, OSError) as exc:
+            core.logger.warning("%s 串口读取失败: %s", core.name, exc)
+            break
+
+
+def attach_trend_store(core, directory):
+    from trend_store import TrendStore
+    safe_name = "".join(c if c.isalnum() else "_" for c in core.name)
+    store = TrendStore(os.path.join(directory, safe_name))
+
+    def on_packets(core, packets):
+        if any(is_param_packet(packet) for packet in packets):
+            store.add(time.time(), core.state.hr, core.state.resp_rate, core.state.spo2)
+
+    core.packet_listeners.append(on_packets)
+    return store
+
+
+def status_line(core):
+    state = core.state
+    fmt = lambda value: "---" if value is None else str(value)
+    alarms = " / ".join(core.alarms.active_alarms) or "正常"
+    return (f"[{core.name}] HR {fmt(state.hr)} RR {fmt(state.resp_rate)} SpO2 {fmt(state.spo2)} | "
+            f"RX {core.decoder.rx_bytes}B 包 {core.decoder.rx_packets} 错 {core.decoder.checksum_error_count} | {alarms}")
+
+
+def build_cores(args, logger):
+    cores = []
+    for port in args.port:
+        cores.append(MonitorCore(SerialSource(open_serial(port, args.baud)), name=port, logger=logger,
+                                 crosscheck=args.crosscheck))
+    for i in range(args.simulate):
+        cores.append(MonitorCore(SimulatedSource(seed=i), name=f"sim{i}", logger=logger, crosscheck=args.crosscheck))
+    return cores
+
+
+def run(args):
+    logger = setup_logger()
+    cores = build_cores(args, logger)
+    if not cores:
+        print("no device: use --port and/or --simulate", file=sys.stderr)
+        return 2
+    if args.record_dir:
+        for core in cores:
+            print("recording", core.start_recording(args.record_dir))
+    stream_servers = []
+    if args.stream_port:
+        for i, core in enumerate(cores):
+            server = StreamServer(port=args.stream_port + i, device=core.name, logger=logger)
+            server.attach(core)
+            print("streaming", core.name, "on %s:%d" % server.start()[:2])
+            stream_servers.append(server)
+    edf_writers = []
+    if args.edf_dir:
+        from edf_writer import EdfWriter
+        os.makedirs(args.edf_dir, exist_ok=True)
+        for core in cores:
+            safe_name = "".join(c if c.isalnum() else "_" for c in core.name)
+            writer = EdfWriter(os.path.join(args.edf_dir, time.strftime(f"{safe_name}_%Y%m%d_%H%M%S.edf")))
+            writer.attach(core)
+            print("edf", writer.path)
+            edf_writers.append(writer)
+    shm_writers = []
+    if args.shm:
+        from shm_ring import ShmRingWriter
+        for core in cores:
+            name = args.shm if len(cores) == 1 else args.shm + "_" + "".join(c if c.isalnum() else "_" for c in core.name)
+            writer = ShmRingWriter(name)
+            writer.attach(core)
+            print("shared memory", core.name, "->", name)
+            shm_writers.append(writer)
+    trend_stores = [attach_trend_store(core, args.trend_dir) for core in cores] if args.trend_dir else []
+
+    stop_event = threading.Event()
+    workers = [threading.Thread(target=device_worker, args=(core, stop_event), daemon=True) for core in cores]
+    for worker in workers:
+        worker.start()
+
+    start_wall, start_cpu = time.perf_counter(), time.process_time()
+    try:
+        while any(worker.is_alive() for worker in workers):
+            time.sleep(args.status_interval)
+            for core in cores:
+                print(status_line(core), flush=True)
+            if args.duration and time.perf_counter() - start_wall >= args.duration:
+                break
+    except KeyboardInterrupt:
+        pass
+    stop_event.set()
+    for worker in workers:
+        worker.join(1.0)
+    wall, cpu = time.perf_counter() - start_wall, time.process_time() - start_cpu
+    for core in cores:
+        core.close()
+    for store in trend_stores:
+        store.close()
+    for server in stream_servers:
+        server.stop()
+    for writer in shm_writers + edf_writers:
+        writer.close()
+    print(f"{len(cores)} devices, {wall:.1f}s wall, CPU {cpu / wall * 100:.2f}% total, "
+          f"{cpu / wall * 100 / len(cores):.3f}% per device")
+    return 0
+
+
+def bench(args):
+    """CPU cost of the headless pipeline per device at the firmware's packet rate."""
+    seconds = args.bench_seconds
+    source = SimulatedSource(realtime=False)
+    payload = source.encode(seconds * WAVE_RATE_HZ)
+    chunk = len(payload) // (seconds * 50)  # 20 ms reads, like a serial poll loop
+
+    results = []
+    for crosscheck, recording in ((False, False), (True, False), (True, True)):
+        core = MonitorCore(name="bench", crosscheck=crosscheck)
+        if recording:
+            core.start_recording(args.record_dir or os.path.join(os.path.dirname(os.path.abspath(__file__)), "logs"))
+        start = time.process_time()
+        for offset in range(0, len(payload), chunk):
+            core.process(payload[offset:offset + chunk])
+        cpu = time.process_time() - start
+        if recording:
+            path = core.recorder.path
+            core.stop_recording()
+            os.remove(path)
+        results.append((crosscheck, recording, cpu, core.decoder.rx_packets))
+
+    print(f"{seconds}s of data per device ({len(payload)} bytes)")
+    for crosscheck, recording, cpu, packets in results:
+        label = "decode+state+alarm" + ("+crosscheck" if crosscheck else "") + ("+record" if recording else "")
+        print(f"  {label:38s} {cpu * 1000 / seconds:7.3f} ms CPU per second of data "
+              f"= {cpu / seconds * 100:6.3f}% of one core per device, {packets / cpu:,.0f} packets/s max")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="TriVital Monitor 无界面采集服务")
+    parser.add_argument("--port", action="append", default=[], help="串口号，可重复指定多个设备")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--simulate", type=int, default=0, metavar="N", help="追加 N 个模拟设备")
+    parser.add_argument("--record-dir", help="将每个设备的解码数据包记录为 .tvr 文件")
+    parser.add_argument("--trend-dir", help="按设备写入 1 s/1 min/15 min 趋势数据")
+    parser.add_argument("--stream-port", type=int, default=0, help="本地 TCP 数据流端口，第 i 个设备使用 PORT+i")
+    parser.add_argument("--edf-dir", help="为每个设备边采集边写 EDF+ 文件")
+    parser.add_argument("--shm", metavar="NAME", help="将解码波形发布到共享内存环，多设备时追加 _设备名")
+    parser.add_argument("--no-crosscheck", dest="crosscheck", action="store_false",
+                        help="关闭主机端 HR/RR 交叉校验（不需要 numpy）")
+    parser.add_argument("--duration", type=float, default=0, help="运行秒数，0 表示直到 Ctrl+C")
+    parser.add_argument("--status-interval", type=float, default=5.0)
+    parser.add_argument("--bench", action="store_true", help="测量每个设备的解码 CPU 开销")
+    parser.add_argument("--bench-seconds", type=int, default=600)
+    args = parser.parse_args()
+    return bench(args) if args.bench else run(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
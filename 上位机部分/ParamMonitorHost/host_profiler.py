@@ -0,0 +1,164 @@
+"""Opt-in profiling of the GUI pipeline.
+
+StageProfiler swaps the pipeline's methods for timing wrappers only while it is enabled; disabled, the original
+bound methods are back in place and nothing is measured. Time is exclusive: a stage called from another (analyze
+inside data_process) is not counted again in the caller.
+
+SamplingProfiler samples the main thread's Python stack from a background thread for a fixed time and writes folded
+stacks ("frame;frame;frame count" per line), the input format of flamegraph.pl and speedscope. The sampler only runs
+when the main thread gives up the GIL, which at the default 5 ms switch interval is almost only when it goes idle;
+the interval is shortened while sampling so busy slots are caught mid-way.
+"""
+import os
+import sys
+import threading
+import time
+from collections import Counter
+from dataclasses import dataclass, field
+
+
+@dataclass
+class Target:
+    owner: object
+    name: str
+    stage: str
+    signals: tuple = ()     # Qt signals the bound method is connected to, reconnected to the wrapper
+    lists: tuple = ()       # listener lists holding the bound method
+    original: object = field(default=None, repr=False)
+    wrapper: object = field(default=None, repr=False)
+    shadowed: bool = False  # the owner already had an instance attribute of that name
+
+
+class StageProfiler:
+    def __init__(self):
+        self.targets = []
+        self.totals = Counter()
+        self.calls = Counter()
+        self.children = []          # time spent in wrapped callees of each active frame
+        self.mark = None            # (wall, process CPU) at the last report
+
+    @property
+    def enabled(self):
+        return bool(self.targets)
+
+    def enable(self, targets):
+        self.disable()
+        for target in targets:
+            target.original = getattr(target.owner, target.name)
+            target.shadowed = target.name in vars(target.owner)
+            target.wrapper = self.wrap(target.original, target.stage)
+            setattr(target.owner, target.name, target.wrapper)
+            for signal in target.signals:
+                signal.disconnect(target.original)
+                signal.connect(target.wrapper)
+            for listeners in target.lists:
+                listeners[listeners.index(target.original)] = target.wrapper
+        self.targets = list(targets)
+        self.reset()
+
+    def disable(self):
+        for target in self.targets:
+            for listeners in target.lists:
+                listeners[listeners.index(target.wrapper)] = target.original
+            for signal in target.signals:
+                signal.disconnect(target.wrapper)
+                signal.connect(target.original)
+            # removing the wrapper's instance attribute restores the class method lookup
+            if target.shadowed:
+                setattr(target.owner, target.name, target.original)
+            else:
+                delattr(target.owner, target.name)
+        self.targets = []
+
+    def reset(self):
+        self.totals.clear()
+        self.calls.clear()
+        self.mark = (time.perf_counter(), time.process_time())
+
+    def wrap(self, function, stage):
+        clock = time.perf_counter
+        totals, calls, children = self.totals, self.calls, self.children
+
+        def timed(*args, **kwargs):
+            children.append(0.0)
+            start = clock()
+            try:
+                return function(*args, **kwargs)
+            finally:
+                elapsed = clock() - start
+                totals[stage] += elapsed - children.pop()
+                calls[stage] += 1
+                if children:
+                    children[-1] += elapsed
+        return timed
+
+    def report(self):
+        """Per-stage ms per second and share of one core since the previous report, then reset."""
+        wall, cpu = time.perf_counter(), time.process_time()
+        span, cpu_span = wall - self.mark[0], cpu - self.mark[1]
+        if span <= 0:
+            return ""
+        lines = [f"{'stage':12s}{'ms/s':>8s}{'core%':>7s}{'calls/s':>9s}"]
+        for stage, total in sorted(self.totals.items(), key=lambda item: -item[1]):
+            lines.append(f"{stage:12s}{total * 1000 / span:8.2f}{total * 100 / span:7.2f}{self.calls[stage] / span:9.0f}")
+        measured = sum(self.totals.values())
+        lines.append(f"{'measured':12s}{measured * 1000 / span:8.2f}{measured * 100 / span:7.2f}")
+        lines.append(f"process CPU {cpu_span * 100 / span:.1f}% of one core")
+        self.reset()
+        return "\n".join(lines)
+
+
+SAMPLE_SWITCH_INTERVAL = 0.0002     # s, sys.setswitchinterval while sampling
+
+
+class SamplingProfiler:
+    def __init__(self, thread_id=None, interval=0.002):
+        self.thread_id = thread_id if thread_id is not None else threading.main_thread().ident
+        self.interval = interval
+        self.stacks = Counter()
+        self.thread = None
+        self.path = None
+        self.samples = 0
+
+    @property
+    def running(self):
+        return self.thread is not None and self.thread.is_alive()
+
+    def start(self, seconds, path):
+        if self.running:
+            return False
+        self.stacks.clear()
+        self.samples = 0
+        self.path = path
+        self.thread = threading.Thread(target=self.run, args=(seconds,), name="SamplingProfiler", daemon=True)
+        self.thread.start()
+        return True
+
+    def run(self, seconds):
+        switch_interval = sys.getswitchinterval()
+        sys.setswitchinterval(SAMPLE_SWITCH_INTERVAL)
+        try:
+            self.sample(seconds)
+        finally:
+            sys.setswitchinterval(switch_interval)
+        self.write(self.path)
+
+    def sample(self, seconds):
+        deadline = time.perf_counter() + seconds
+        while time.perf_counter() < deadline:
+            frame = sys._current_frames().get(self.thread_id)
+            stack = []
+            while frame is not None:
+                code = frame.f_code
+                stack.append(f"{code.co_name} ({os.path.basename(code.co_filename)}:{code.co_firstlineno})")
+                frame = frame.f_back
+            if stack:
+                self.stacks[";".join(reversed(stack))] += 1
+                self.samples += 1
+            time.sleep(self.interval)
+
+    def write(self, path):
+        os.makedirs(os.path.dirname(path) or ".", exist_ok=True)
+        with open(path, "w", encoding="utf-8") as f:
+            for stack, count in self.stacks.most_common():
+                f.write(f"{stack} {count}\n")
@@ -0,0 +1,157 @@
+"""Per-sample latency of the GUI pipeline: device sample -> serial read -> decode -> data_process -> ECG paint.
+
+Wave packets carry no sample index, so sample n is the n-th wave packet since the last reset, realigned on every
+QRS event (its 24-bit sample index plus lag is the device index of the wave packet just before it). Host and device
+clocks are not synchronised: the device time of sample n is taken as floor + n / 250, with floor the smallest
+read time - n / 250 over the last FLOOR_WINDOW_S. "sample->read" is therefore the delay above the fastest sample
+seen recently; the constant part (UART wire time, firmware send queue) is not included.
+"""
+import time
+from collections import deque
+
+import numpy as np
+
+from monitor_core import ID2_EVENT_QRS, MODULE_PARAM, MODULE_WAVE, WAVE_RATE_HZ
+
+STAGES = ("sample->read", "read->decode", "decode->process", "process->paint", "sample->paint")
+WINDOW = 2048                   # samples per stage kept for the percentiles, ~8 s
+FLOOR_WINDOW_S = 30             # clock drift between device and PC stays below ~2 ms within this
+HIST_EDGES_MS = (0, 1, 2, 4, 8, 16, 32, 64, float("inf"))
+BITS_PER_BYTE = 10              # 8N1
+
+
+def histogram(values):
+    """Share of values in each HIST_EDGES_MS bin, in %."""
+    if not values:
+        return [0.0] * (len(HIST_EDGES_MS) - 1)
+    counts, _ = np.histogram(np.fromiter(values, dtype=np.float64), bins=HIST_EDGES_MS)
+    return list(counts * 100.0 / counts.sum())
+
+
+def percentile(values, fraction):
+    """Nearest-rank percentile of values (fraction in 0..1); NaN when there are none. Shared by the bench scripts."""
+    if len(values) == 0:
+        return float("nan")
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * fraction))]
+
+
+def histogram_labels():
+    labels = []
+    for low, high in zip(HIST_EDGES_MS, HIST_EDGES_MS[1:]):
+        labels.append(f">{low:g}" if high == float("inf") else f"{low:g}-{high:g}")
+    return labels
+
+
+class LatencyStats:
+    def __init__(self, rate=WAVE_RATE_HZ):
+        self.rate = rate
+        self.samples = {stage: deque(maxlen=WINDOW) for stage in STAGES}
+        self.read_intervals = deque(maxlen=WINDOW)      # ms between serial reads that carried wave packets
+        self.floor_minima = deque(maxlen=FLOOR_WINDOW_S)  # (second, min of read time - n / rate)
+        self.decoded = deque()      # [first index, count, read, decoded] waiting for data_process
+        self.processed = deque()    # [first index, count, read, decoded, processed] waiting to be painted
+        self.wave_index = 0
+        self.last_read = None
+        self.link_mark = None
+
+    def clear(self, undrawn=0):
+        """Forget pending timestamps. `undrawn` samples already queued for painting are skipped when drawn."""
+        self.decoded.clear()
+        self.processed.clear()
+        if undrawn:
+            self.processed.append([None, undrawn, None, None, None])
+        self.last_read = None
+
+    def floor(self):
+        return min(m for _, m in self.floor_minima) if self.floor_minima else None
+
+    def on_decoded(self, packets, read, decoded):
+        count = 0
+        for packet in packets:
+            if packet[0] == MODULE_WAVE:
+                count += 1
+            elif packet[0] == MODULE_PARAM and packet[1] == ID2_EVENT_QRS:
+                # the event follows the wave packet of device sample index + lag
+                self.realign((packet[2] << 16 | packet[3] << 8 | packet[4]) + packet[5], count)
+        if not count:
+            return
+        first = self.wave_index
+        self.wave_index += count
+        self.decoded.append([first, count, read, decoded])
+        if self.last_read is not None:
+            self.read_intervals.append((read - self.last_read) * 1000)
+        self.last_read = read
+        second = int(read)
+        newest = read - (first + count - 1) / self.rate
+        if self.floor_minima and self.floor_minima[-1][0] == second:
+            self.floor_minima[-1] = (second, min(self.floor_minima[-1][1], newest))
+        else:
+            self.floor_minima.append((second, newest))
+
+    def realign(self, device, received):
+        """Set the index of the received-th wave packet of the current batch to the device's 24-bit index."""
+        current = (self.wave_index + received - 1) & 0xFFFFFF
+        shift = (device - current + (1 << 23)) % (1 << 24) - (1 << 23)
+        if shift:
+            self.wave_index += shift
+            self.floor_minima.clear()
+
+    def on_process(self, processed):
+        while self.decoded:
+            self.processed.append(self.decoded.popleft() + [processed])
+
+    def on_paint(self, drawn, painted):
+        """`drawn` samples at the head of the paint queue reached the ECG pixmap at `painted`."""
+        floor = self.floor()
+        samples = self.samples
+        while drawn > 0 and self.processed:
+            batch = self.processed[0]
+            first, count, read, decoded, processed = batch
+            take = min(drawn, count)
+            if first is not None:
+                samples["read->decode"].extend([(decoded - read) * 1000] * take)
+                samples["decode->process"].extend([(processed - decoded) * 1000] * take)
+                samples["process->paint"].extend([(painted - processed) * 1000] * take)
+                if floor is not None:
+                    for n in range(first, first + take):
+                        device = floor + n / self.rate
+                        samples["sample->read"].append((read - device) * 1000)
+                        samples["sample->paint"].append((painted - device) * 1000)
+                batch[0] = first + take
+            batch[1] = count - take
+            drawn -= take
+            if batch[1] == 0:
+                self.processed.popleft()
+
+    def percentiles(self):
+        """stage -> (p50, p95, p99) in ms, None for stages without data."""
+        result = {}
+        for stage, values in self.samples.items():
+            if values:
+                result[stage] = tuple(np.percentile(np.fromiter(values, dtype=np.float64), (50, 95, 99)))
+            else:
+                result[stage] = None
+        return result
+
+    def link_utilization(self, rx_bytes, baudrate, now=None):
+        """Share of the serial line's byte capacity used since the previous call, in %."""
+        now = time.perf_counter() if now is None else now
+        mark, self.link_mark = self.link_mark, (now, rx_bytes)
+        if mark is None or not baudrate or now <= mark[0]:
+            return None
+        return (rx_bytes - mark[1]) / (now - mark[0]) * BITS_PER_BYTE / baudrate * 100.0
+
+    def report(self, utilization=None):
+        lines = [f"{'latency ms':16s}{'p50':>7s}{'p95':>7s}{'p99':>7s}"]
+        for stage, values in self.percentiles().items():
+            if values is None:
+                lines.append(f"{stage:16s}{'--':>7s}{'--':>7s}{'--':>7s}")
+            else:
+                lines.append(f"{stage:16s}" + "".join(f"{v:7.1f}" for v in values))
+        lines.append("链路占用 " + ("--" if utilization is None else f"{utilization:.1f}%"))
+        labels = histogram_labels()
+        for title, values in (("读间隔", self.read_intervals), ("到达抖动", self.samples["sample->read"])):
+            shares = histogram(values)
+            lines.append(f"{title} ms " + " ".join(f"{label}:{share:.0f}%" for label, share in zip(labels, shares)))
+        return "\n".join(lines)
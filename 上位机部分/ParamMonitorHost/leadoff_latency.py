@@ -0,0 +1,79 @@
+import argparse
+import random
+import sys
+import time
+
+from PyQt5.QtCore import QEventLoop, QTimer
+from PyQt5.QtWidgets import QApplication
+
+from latency_stats import percentile
+from monitor_core import SimulatedSource
+
+
+def wait(ms):
+    loop = QEventLoop()
+    QTimer.singleShot(int(ms), loop.quit)
+    loop.exec_()
+
+
+def run_mode(window, status_on_change, events, seed):
+    """Unplug and replug the ECG lead of a simulated device and time each unplug until the
+    ECG status label reads 导联异常.
+
+    The unplug time is taken at the simulated device, so the latency covers the firmware
+    reporting cadence, the serial poll and the GUI processing timer.
+    """
+    source = SimulatedSource(status_on_change=status_on_change)
+    window.clear_wave_screen()
+    window.core.source = source
+    window.lead_off_latency_ms.clear()
+    rng = random.Random(seed)
+    total = []
+    pulled = []
+
+    def check():
+        if pulled and window.labelecg_status.text() == "导联异常":
+            total.append((time.perf_counter() - pulled.pop()) * 1000)
+
+    window.procDataTimer.timeout.connect(check)
+    window.serialPortTimer.start(2)
+    window.procDataTimer.start(10)
+    wait(1500)   # first STATUS packets show the leads connected
+    for _ in range(events):
+        wait(rng.uniform(200, 1200))   # random phase against the 1 s heartbeat
+        source.set_lead(0, False)
+        pulled.append(time.perf_counter())
+        wait(1300)
+        pulled.clear()
+        source.set_lead(0, True)
+        wait(1100)
+    window.serialPortTimer.stop()
+    window.procDataTimer.stop()
+    window.procDataTimer.timeout.disconnect(check)
+    return total, list(window.lead_off_latency_ms)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="导联脱落到界面显示的延迟：事件上报与每秒状态包对比")
+    parser.add_argument("--events", type=int, default=20, help="每种上报方式的脱落次数")
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    app = QApplication(sys.argv)
+    from ParamMonitor import ParamMonitor
+
+    window = ParamMonitor()
+    window.show()
+    app.processEvents()
+    window.finish_startup()
+    print(f"ECG lead-off -> status label, {args.events} events per mode")
+    for name, on_change in (("1 s STATUS", False), ("on change", True)):
+        total, host = run_mode(window, on_change, args.events, args.seed)
+        print(f"  {name:<10}  total ms p50 {percentile(total, 0.5):6.1f} p90 {percentile(total, 0.9):6.1f} "
+              f"max {max(total):6.1f}  host ms p50 {percentile(host, 0.5):5.1f} max {max(host, default=0):5.1f}")
+    window.trend_store.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,13 +1,28 @@
-from PyQt5.Qt import *
+from startup_timing import STARTUP
 import sys
+from PyQt5.QtCore import Qt, QTimer
+from PyQt5.QtGui import QFont
+from PyQt5.QtWidgets import QApplication
 from ParamMonitor import ParamMonitor
 
+
+def print_startup_and_quit(phase):
+    # --startup-exit: used by startup_bench.py, quits once the deferred start-up work is done
+    if phase == "ready":
+        print(STARTUP.report(), flush=True)
+        QTimer.singleShot(0, QApplication.instance().quit)
+
+
 if __name__ == '__main__':
+    STARTUP.mark("imports")
     QApplication.setAttribute(Qt.AA_EnableHighDpiScaling, True)
     QApplication.setAttribute(Qt.AA_UseHighDpiPixmaps, True)
     app = QApplication(sys.argv)
     default_font = QFont("SimHei", 10, 87)
     app.setFont(default_font)
+    STARTUP.mark("app")
+    if "--startup-exit" in sys.argv:
+        STARTUP.listeners.append(print_startup_and_quit)
     window = ParamMonitor()
     window.show()
     sys.exit(app.exec_())
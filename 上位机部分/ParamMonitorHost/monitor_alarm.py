@@ -18,7 +18,7 @@ class AlarmResult:
     spo2_alarm: bool
 
 
-def evaluate_alarm_state(hr, resp_rate, spo2, lead_status, limits):
+def evaluate_alarm_state(hr, resp_rate, spo2, lead_status, limits, technical=()):
     alarms = []
     hr_alarm = False
     resp_alarm = False
@@ -48,4 +48,6 @@ def evaluate_alarm_state(hr, resp_rate, spo2, lead_status, limits):
         if ok is False:
             alarms.append(f"{name}\u5bfc\u8054\u5f02\u5e38")
 
+    alarms.extend(technical)
+
     return AlarmResult(alarms, hr_alarm, resp_alarm, spo2_alarm)
@@ -0,0 +1,407 @@
+import logging
+import math
+import os
+import struct
+import time
+from dataclasses import dataclass, field
+
+from monitor_alarm import AlarmLimits, evaluate_alarm_state
+from PackUnpack import PackUnpack
+
+MODULE_SYS = 0x01
+MODULE_WAVE = 0x10
+MODULE_PARAM = 0x11
+MODULE_STATUS = 0x12
+
+DAT_SYS_TIME = 0x02
+ID2_PARAM = 0x02
+# EnumParamSecondID in PackUnpack.h: data[0..2] big-endian 24-bit sample index of the peak, data[3] samples
+# between the peak and the wave packet the event follows, data[4] amplitude in % of the recent peak-to-peak,
+# data[5] confidence 0..100
+ID2_EVENT_QRS = 0x03
+ID2_EVENT_BREATH = 0x04
+ID2_EVENT_PULSE = 0x05
+EVENT_NAMES = {ID2_EVENT_QRS: "QRS", ID2_EVENT_BREATH: "BREATH", ID2_EVENT_PULSE: "PULSE"}
+# EnumBootPhase in PackUnpack.h: DAT_SYS_TIME data[0] is the phase, data[2..5] big-endian µs since SysTick start
+BOOT_PHASES = ("clock", "acquisition", "main_loop", "first_wave", "oled", "first_hr", "first_rr", "first_spo2")
+
+PACKET_LEN = 10
+WAVE_RATE_HZ = 250
+LEAD_NAMES = ("ECG", "RESP", "SpO2")    # STATUS data[0], data[2], data[4]
+LEAD_DEBOUNCE_S = 0.02                  # ECG_LEAD_DEBOUNCE_MS in ECG.c
+
+TVR_MAGIC = b"TVR1"
+TVR_HEADER = struct.Struct("<4sHHd32s")
+TVR_RECORD = struct.Struct("<d10s")
+
+
+def setup_logger(name="TriVitalMonitor"):
+    log_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "logs")
+    os.makedirs(log_dir, exist_ok=True)
+    logger = logging.getLogger(name)
+    logger.setLevel(logging.INFO)
+    if not logger.handlers:
+        handler = logging.FileHandler(os.path.join(log_dir, "host_monitor.log"), encoding="utf-8")
+        handler.setFormatter(logging.Formatter("%(asctime)s [%(levelname)s] %(message)s"))
+        logger.addHandler(handler)
+    return logger
+
+
+def to_int16(high_byte, low_byte):
+    value = high_byte << 8 | low_byte
+    return value - 65536 if value >= 32768 else value
+
+
+def is_param_packet(packet):
+    return packet[0] == MODULE_PARAM and packet[1] == ID2_PARAM
+
+
+@dataclass
+class BeatEvent:
+    kind: str           # EVENT_NAMES value
+    sample_index: int   # device sample counter at the peak, wraps at 2**24
+    lag: int            # the peak is this many samples before the last wave sample received
+    amplitude: int
+    confidence: int
+
+
+def parse_event(packet):
+    if packet[0] != MODULE_PARAM or packet[1] not in EVENT_NAMES:
+        return None
+    return BeatEvent(EVENT_NAMES[packet[1]], packet[2] << 16 | packet[3] << 8 | packet[4],
+                     packet[5], packet[6], packet[7])
+
+
+def pack_frame(module_id, second_id, data, packer=None):
+    packer = packer or PackUnpack()
+    pack = [module_id, second_id] + list(data)
+    packer.packData(pack)
+    return bytes(pack)
+
+
+class SerialSource:
+    def __init__(self, ser):
+        self.ser = ser
+
+    def is_open(self):
+        return self.ser.isOpen()
+
+    def read(self, blocking=False):
+        num = self.ser.in_waiting
+        if num == 0 and blocking:
+            # pyserial timeout bounds the wait so the worker can notice shutdown
+            return self.ser.read(1) + self.ser.read(self.ser.in_waiting)
+        return self.ser.read(num) if num > 0 else b""
+
+    def write(self, data):
+        self.ser.write(bytes(data))
+
+    def close(self):
+        if self.ser.isOpen():
+            self.ser.close()
+
+
+class SimulatedSource:
+    """Byte stream of a synthetic patient in the firmware's packet format."""
+
+    def __init__(self, hr=72, resp_rate=16, spo2=98, realtime=True, seed=0, status_on_change=True):
+        self.hr = hr
+        self.resp_rate = resp_rate
+        self.spo2 = spo2
+        self.realtime = realtime
+        self.sample_index = 0
+        self.phase_offset = seed * 997
+        self.start = time.perf_counter()
+        self.packer = PackUnpack()
+        self.leads = [1, 1, 1]
+        self.status_on_change = status_on_change
+        self.status_due = None
+
+    def is_open(self):
+        return True
+
+    def set_lead(self, index, ok):
+        """Plug or unplug lead index (LEAD_NAMES order). Like the firmware, the STATUS packet follows
+        after the debounce time with status_on_change, otherwise with the next 1 s heartbeat."""
+        self.leads[index] = 1 if ok else 0
+        if self.status_on_change:
+            now = int((time.perf_counter() - self.start) * WAVE_RATE_HZ) if self.realtime else self.sample_index
+            self.status_due = max(now, self.sample_index) + round(LEAD_DEBOUNCE_S * WAVE_RATE_HZ)
+
+    def cycles(self, k):
+        """Heart and breath cycles completed at sample k, for placing the simulated events."""
+        t = (k + self.phase_offset) / WAVE_RATE_HZ
+        return t * self.hr / 60.0, t * self.resp_rate / 60.0
+
+    def events(self, k):
+        """Event packets due after sample k: QRS at ECG phase 0.2, pulse at PPG phase 0.3, breath at the
+        resp sine peak. Confirmed on the peak sample itself, so lag is 0."""
+        out = bytearray()
+        if k == 0:
+            return out
+        (heart, breath), (last_heart, last_breath) = self.cycles(k), self.cycles(k - 1)
+        for second_id, now, last, peak in ((ID2_EVENT_QRS, heart, last_heart, 0.2),
+                                           (ID2_EVENT_PULSE, heart, last_heart, 0.3),
+                                           (ID2_EVENT_BREATH, breath, last_breath, 0.25)):
+            if math.floor(now - peak) > math.floor(last - peak):
+                index = k & 0xFFFFFF
+                data = bytes([index >> 16, index >> 8 & 0xFF, index & 0xFF, 0, 100, 100])
+                out += pack_frame(MODULE_PARAM, second_id, data, self.packer)
+        return out
+
+    def sample(self, k):
+        t = (k + self.phase_offset) / WAVE_RATE_HZ
+        phase = (t * self.hr / 60.0) % 1.0
+        ecg = int(1200 * math.exp(-((phase - 0.2) / 0.02) ** 2) + 200 * math.exp(-((phase - 0.45) / 0.06) ** 2))
+        resp = int(1500 * math.sin(2 * math.pi * self.resp_rate / 60.0 * t))
+        ppg = int(600 * math.exp(-((phase - 0.3) / 0.1) ** 2))
+        return ecg, resp, ppg
+
+    def encode(self, count):
+        out = bytearray()
+        for _ in range(count):
+            k = self.sample_index
+            ecg, resp, ppg = self.sample(k)
+            out += pack_frame(MODULE_WAVE, 0x02, struct.pack(">hhh", ecg, resp, ppg), self.packer)
+            out += self.events(k)
+            if k % WAVE_RATE_HZ == 0:
+                out += pack_frame(MODULE_PARAM, ID2_PARAM, struct.pack(">HHH", self.hr, self.resp_rate, self.spo2), self.packer)
+            if k % WAVE_RATE_HZ == 0 or k == self.status_due:
+                status = bytes([self.leads[0], 0, self.leads[1], 0, self.leads[2], 0])
+                out += pack_frame(MODULE_STATUS, 0x02, status, self.packer)
+            self.sample_index += 1
+        return bytes(out)
+
+    def read(self, blocking=False):
+        if not self.realtime:
+            return self.encode(WAVE_RATE_HZ // 10)
+        due = int((time.perf_counter() - self.start) * WAVE_RATE_HZ) - self.sample_index
+        if due <= 0 and blocking:
+            time.sleep(0.02)
+            due = int((time.perf_counter() - self.start) * WAVE_RATE_HZ) - self.sample_index
+        return self.encode(due) if due > 0 else b""
+
+    def write(self, data):
+        pass
+
+    def close(self):
+        pass
+
+
+class FrameDecoder:
+    def __init__(self, sync_error_threshold=5):
+        self.unpacker = PackUnpack()
+        self.sync_error_threshold = sync_error_threshold
+        self.sync_error_count = 0
+        self.rx_bytes = 0
+        self.rx_packets = 0
+        self.checksum_error_count = 0
+        self.debug_listeners = []
+
+    def reset_sync(self):
+        self.unpacker.sGotPackId = False
+        self.unpacker.sPackLen = 0
+        self.unpacker.sRestByteNum = 0
+        self.unpacker.mBufList = [0] * PACKET_LEN
+
+    def _debug(self, kind, payload):
+        for listener in self.debug_listeners:
+            listener(kind, payload)
+
+    def idle(self):
+        if self.sync_error_count > self.sync_error_threshold:
+            self.reset_sync()
+            self.sync_error_count = 0
+
+    def feed(self, data):
+        packets = []
+        unpacker = self.unpacker
+        self.rx_bytes += len(data)
+        if self.debug_listeners:
+            self._debug("rx", data)
+        for byte in data:
+            if unpacker.sGotPackId:
+                if byte < 0x80 and unpacker.sPackLen < PACKET_LEN:
+                    self.sync_error_count += 1
+                    self.checksum_error_count += 1
+                    self._debug("sync", byte)
+                    unpacker.sGotPackId = False
+                    unpacker.sPackLen = 0
+                    unpacker.sRestByteNum = 0
+            elif byte < 0x80 and self.sync_error_count > self.sync_error_threshold:
+                self.reset_sync()
+                self.sync_error_count = 0
+            if unpacker.unpackData(byte):
+                self.sync_error_count = 0
+                packet = list(unpacker.getUnpackRslt())
+                packets.append(packet)
+                self.rx_packets += 1
+                if self.debug_listeners:
+                    self._debug("pack", packet)
+        return packets
+
+
+@dataclass
+class VitalsState:
+    hr: int = None
+    resp_rate: int = None
+    spo2: int = None
+    lead_status: dict = field(default_factory=lambda: {"ECG": None, "RESP": None, "SpO2": None})
+    packet_counts: dict = field(default_factory=lambda: {MODULE_WAVE: 0, MODULE_PARAM: 0, MODULE_STATUS: 0})
+    last_packet_time: float = None
+    boot_times: dict = field(default_factory=dict)
+    lead_change_time: dict = field(default_factory=dict)   # receive time of the STATUS that last changed each lead
+    last_event: dict = field(default_factory=dict)         # EVENT_NAMES value -> latest BeatEvent
+    technical_alarms: list = field(default_factory=list)   # from VitalsCrossCheck
+
+    def apply(self, packet, now):
+        module_id = packet[0]
+        self.last_packet_time = now
+        if module_id in self.packet_counts:
+            self.packet_counts[module_id] += 1
+        if module_id == MODULE_PARAM and packet[1] != ID2_PARAM:
+            event = parse_event(packet)
+            if event is not None:
+                self.last_event[event.kind] = event
+            return False
+        if module_id == MODULE_PARAM:
+            hr = (packet[2] << 8) | packet[3]
+            resp_rate = (packet[4] << 8) | packet[5]
+            spo2 = (packet[6] << 8) | packet[7]
+            self.hr = hr if 0 < hr < 300 else None
+            self.resp_rate = resp_rate if 0 < resp_rate < 120 else None
+            self.spo2 = spo2 if 0 <= spo2 <= 100 else None
+            return True
+        if module_id == MODULE_STATUS:
+            for name, value in zip(LEAD_NAMES, packet[2:8:2]):
+                if bool(value) != self.lead_status[name]:
+                    self.lead_change_time[name] = now
+                    self.lead_status[name] = bool(value)
+            return True
+        if module_id == MODULE_SYS and packet[1] == DAT_SYS_TIME and packet[2] < len(BOOT_PHASES):
+            self.boot_times[BOOT_PHASES[packet[2]]] = int.from_bytes(bytes(packet[4:8]), "big")
+        return False
+
+
+class AlarmEvaluator:
+    def __init__(self, limits=None):
+        self.limits = limits or AlarmLimits()
+        self.active_alarms = []
+        self.result = None
+
+    def evaluate(self, state):
+        self.result = evaluate_alarm_state(state.hr, state.resp_rate, state.spo2, state.lead_status, self.limits,
+                                           state.technical_alarms)
+        raised = sorted(set(self.result.alarms) - set(self.active_alarms))
+        self.active_alarms = self.result.alarms
+        return raised
+
+
+class SessionRecorder:
+    """Decoded packets with receive timestamps, one fixed-size record each (.tvr)."""
+
+    def __init__(self, path, device=""):
+        self.path = path
+        self.file = open(path, "wb", buffering=64 * 1024)
+        self.file.write(TVR_HEADER.pack(TVR_MAGIC, 1, 0, time.time(), device.encode("utf-8")[:32]))
+        self.records = 0
+
+    def write(self, t, packets):
+        pack = TVR_RECORD.pack
+        self.file.write(b"".join(pack(t, bytes(packet)) for packet in packets))
+        self.records += len(packets)
+
+    def close(self):
+        if not self.file.closed:
+            self.file.close()
+
+
+def read_recording(path):
+    with open(path, "rb") as f:
+        magic, version, _, start_time, device = TVR_HEADER.unpack(f.read(TVR_HEADER.size))
+        if magic != TVR_MAGIC:
+            raise ValueError(f"{path}: not a TriVital recording")
+        header = {"version": version, "start_time": start_time, "device": device.rstrip(b"\0").decode("utf-8")}
+        yield header
+        while True:
+            chunk = f.read(TVR_RECORD.size * 4096)
+            if not chunk:
+                break
+            for t, packet in TVR_RECORD.iter_unpack(chunk[:len(chunk) - len(chunk) % TVR_RECORD.size]):
+                yield t, packet
+
+
+class MonitorCore:
+    """One device: source -> decoder -> state/alarms -> recorder and listeners."""
+
+    def __init__(self, source=None, name="device", limits=None, logger=None, crosscheck=True):
+        self.source = source
+        self.name = name
+        self.decoder = FrameDecoder()
+        self.state = VitalsState()
+        self.alarms = AlarmEvaluator(limits)
+        self.crosscheck = None
+        if crosscheck:
+            self.enable_crosscheck()
+        self.recorder = None
+        self.logger = logger or logging.getLogger("TriVitalMonitor")
+        self.packet_listeners = []
+        self.alarm_listeners = []
+        self.start_time = time.time()
+
+    def enable_crosscheck(self):
+        if self.crosscheck is None:
+            from vitals_crosscheck import VitalsCrossCheck   # numpy, only once the cross-check runs
+            self.crosscheck = VitalsCrossCheck()
+
+    def start_recording(self, directory):
+        os.makedirs(directory, exist_ok=True)
+        stamp = time.strftime("%Y%m%d_%H%M%S")
+        safe_name = "".join(c if c.isalnum() else "_" for c in self.name)
+        self.recorder = SessionRecorder(os.path.join(directory, f"{safe_name}_{stamp}.tvr"), self.name)
+        self.logger.info("%s 开始记录: %s", self.name, self.recorder.path)
+        return self.recorder.path
+
+    def stop_recording(self):
+        if self.recorder is not None:
+            self.recorder.close()
+            self.logger.info("%s 停止记录: %s (%d 包)", self.name, self.recorder.path, self.recorder.records)
+            self.recorder = None
+
+    def process(self, data, now=None):
+        now = time.time() if now is None else now
+        packets = self.decoder.feed(data)
+        if not packets:
+            return packets
+        changed = False
+        for packet in packets:
+            changed |= self.state.apply(packet, now)
+            if packet[0] == MODULE_SYS and packet[1] == DAT_SYS_TIME and packet[2] < len(BOOT_PHASES):
+                phase = BOOT_PHASES[packet[2]]
+                self.logger.info("%s 启动阶段 %s: %.3f ms", self.name, phase, self.state.boot_times[phase] / 1000)
+        if self.crosscheck is not None and self.crosscheck.feed([p[2:8] for p in packets if p[0] == MODULE_WAVE], self.state):
+            self.state.technical_alarms = self.crosscheck.alarms
+            changed = True
+        if self.recorder is not None:
+            self.recorder.write(now, packets)
+        for listener in self.packet_listeners:
+            listener(self, packets)
+        if changed:
+            raised = self.alarms.evaluate(self.state)
+            for alarm in raised:
+                self.logger.warning("%s 报警触发: %s", self.name, alarm)
+            for listener in self.alarm_listeners:
+                listener(self, self.alarms.result, raised)
+        return packets
+
+    def poll(self, blocking=False):
+        data = self.source.read(blocking)
+        if not data:
+            self.decoder.idle()
+            return []
+        return self.process(data)
+
+    def close(self):
+        self.stop_recording()
+        if self.source is not None:
+            self.source.close()
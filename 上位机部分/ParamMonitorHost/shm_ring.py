@@ -0,0 +1,142 @@
+import os
+import struct
+import time
+from multiprocessing import resource_tracker, shared_memory
+
+import numpy as np
+
+from monitor_core import MODULE_WAVE, WAVE_RATE_HZ
+
+SHM_MAGIC = b"TVSM"
+SHM_VERSION = 1
+CHANNELS = ("ECG", "RESP", "SpO2")
+DEFAULT_NAME = "trivital_wave"
+DEFAULT_CAPACITY = 1 << 16          # samples per channel, about 262 s at 250 Hz
+
+# 64-byte header; the u64 fields are 8-byte aligned so each store is a single write
+HEADER = struct.Struct("<4sHHIIQQd")   # magic, version, channels, capacity, rate, seq, write_index, write_time
+HEADER_SIZE = 64
+
+_created = set()   # segments owned by a writer in this process
+SEQ_WORD, INDEX_WORD, TIME_WORD = 2, 3, 4  # positions in the header viewed as 8-byte words
+
+
+def attach_shared_memory(name):
+    try:
+        return shared_memory.SharedMemory(name=name, track=False)
+    except TypeError:
+        # before Python 3.13 every attach is registered with the resource tracker,
+        # which would unlink the writer's segment when this reader exits
+        shm = shared_memory.SharedMemory(name=name)
+        if os.name == "posix" and name not in _created:
+            resource_tracker.unregister(shm._name, "shared_memory")
+        return shm
+
+
+class ShmRingWriter:
+    """Single writer of per-channel int16 rings in shared memory.
+
+    Layout: header, then CHANNELS consecutive rings of `capacity` int16. The header
+    is guarded by a sequence lock: seq is odd while the writer updates samples and
+    write_index, even otherwise. Readers never block the writer.
+    """
+
+    def __init__(self, name=DEFAULT_NAME, capacity=DEFAULT_CAPACITY):
+        if capacity & (capacity - 1):
+            raise ValueError("capacity must be a power of two")
+        size = HEADER_SIZE + len(CHANNELS) * capacity * 2
+        try:
+            self.shm = shared_memory.SharedMemory(name=name, create=True, size=size)
+        except FileExistsError:
+            stale = shared_memory.SharedMemory(name=name)
+            stale.close()
+            stale.unlink()
+            self.shm = shared_memory.SharedMemory(name=name, create=True, size=size)
+        _created.add(name)
+        self.name = name
+        self.capacity = capacity
+        self.mask = capacity - 1
+        self.shm.buf[:HEADER.size] = HEADER.pack(SHM_MAGIC, SHM_VERSION, len(CHANNELS), capacity, WAVE_RATE_HZ, 0, 0, 0.0)
+        self.words = np.ndarray((HEADER_SIZE // 8,), dtype=np.uint64, buffer=self.shm.buf)
+        self.times = np.ndarray((HEADER_SIZE // 8,), dtype=np.float64, buffer=self.shm.buf)
+        self.rings = np.ndarray((len(CHANNELS), capacity), dtype=np.int16, buffer=self.shm.buf, offset=HEADER_SIZE)
+        self.write_index = 0
+
+    def attach(self, core):
+        core.packet_listeners.append(self.on_packets)
+
+    def on_packets(self, core, packets):
+        wave = [p for p in packets if p[0] == MODULE_WAVE]
+        if wave:
+            raw = np.array(wave, dtype=np.uint8)[:, 2:8].astype(np.uint16)
+            self.publish((raw[:, 0::2] << 8 | raw[:, 1::2]).view(np.int16))
+
+    def publish(self, samples):
+        """samples: (n, channels) int16."""
+        n = min(len(samples), self.capacity)
+        samples = samples[-n:]
+        start = self.write_index & self.mask
+        first = min(n, self.capacity - start)
+        self.words[SEQ_WORD] += 1
+        self.rings[:, start:start + first] = samples[:first].T
+        self.rings[:, :n - first] = samples[first:].T
+        self.write_index += n
+        self.words[INDEX_WORD] = self.write_index
+        self.times[TIME_WORD] = time.time()
+        self.words[SEQ_WORD] += 1
+
+    def close(self):
+        del self.words, self.times, self.rings
+        self.shm.close()
+        self.shm.unlink()
+        _created.discard(self.name)
+
+
+class ShmRingReader:
+    """Zero-copy reader: poll() returns numpy views straight into the shared ring.
+
+    A view stays valid until the writer laps it; check `valid(start)` after using
+    the data (or copy it) when the consumer may fall more than `capacity` behind.
+    """
+
+    def __init__(self, name=DEFAULT_NAME):
+        self.shm = attach_shared_memory(name)
+        magic, version, channels, capacity, rate, _, _, _ = HEADER.unpack_from(self.shm.buf)
+        if magic != SHM_MAGIC or version != SHM_VERSION:
+            raise ValueError(f"{name}: not a TriVital wave ring")
+        self.capacity = capacity
+        self.mask = capacity - 1
+        self.sample_rate = rate
+        self.words = np.ndarray((HEADER_SIZE // 8,), dtype=np.uint64, buffer=self.shm.buf)
+        self.times = np.ndarray((HEADER_SIZE // 8,), dtype=np.float64, buffer=self.shm.buf)
+        self.rings = np.ndarray((channels, capacity), dtype=np.int16, buffer=self.shm.buf, offset=HEADER_SIZE)
+        self.cursor = int(self.snapshot()[0])
+
+    def snapshot(self):
+        """Consistent (write_index, write_time) under the sequence lock."""
+        while True:
+            seq = int(self.words[SEQ_WORD])
+            if seq & 1:
+                continue
+            index, written = int(self.words[INDEX_WORD]), float(self.times[TIME_WORD])
+            if int(self.words[SEQ_WORD]) == seq:
+                return index, written
+
+    def valid(self, start):
+        return int(self.words[INDEX_WORD]) - start <= self.capacity
+
+    def poll(self):
+        """(start_index, [views]) of samples written since the last poll; views are (channels, k)."""
+        index, _ = self.snapshot()
+        start = max(self.cursor, index - self.capacity)
+        self.cursor = index
+        if index == start:
+            return start, []
+        first, last = start & self.mask, index & self.mask
+        if first < last:
+            return start, [self.rings[:, first:last]]
+        return start, [view for view in (self.rings[:, first:], self.rings[:, :last]) if view.shape[1]]
+
+    def close(self):
+        del self.words, self.times, self.rings
+        self.shm.close()
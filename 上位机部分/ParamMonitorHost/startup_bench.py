@@ -0,0 +1,69 @@
+import argparse
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def run_once(extra_args):
+    """Start main.py --startup-exit; returns (ms from spawn to ready, {phase: ms since main.py started})."""
+    start = time.perf_counter()
+    out = subprocess.run([sys.executable, *extra_args, "main.py", "--startup-exit"], cwd=HERE,
+                         capture_output=True, text=True, encoding="utf-8", timeout=120)
+    wall = (time.perf_counter() - start) * 1000
+    phases = {}
+    for line in out.stdout.splitlines():
+        fields = line.split()
+        if len(fields) >= 2:
+            try:
+                phases[fields[0]] = float(fields[1])
+            except ValueError:
+                pass
+    if "ready" not in phases:
+        raise RuntimeError(f"main.py 未输出启动耗时:\n{out.stdout}{out.stderr}")
+    return wall, phases
+
+
+def import_costs(top):
+    """Modules imported directly by ParamMonitor with the largest cumulative time under -X importtime, in ms."""
+    out = subprocess.run([sys.executable, "-X", "importtime", "-c", "import ParamMonitor"], cwd=HERE,
+                         capture_output=True, text=True, encoding="utf-8", timeout=120)
+    costs = []
+    for line in out.stderr.splitlines():
+        fields = line.removeprefix("import time:").split("|")
+        if len(fields) != 3 or not fields[1].strip().isdigit():
+            continue
+        name = fields[2][1:]
+        depth = (len(name) - len(name.lstrip())) // 2      # pyimport indents each nesting level by two spaces
+        if depth <= 1:
+            costs.append((int(fields[1]) / 1000, name.strip()))
+    return sorted(costs, reverse=True)[:top]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="上位机冷启动耗时：主窗口首次绘制和延迟加载完成的时间")
+    parser.add_argument("--runs", type=int, default=5)
+    parser.add_argument("--imports", type=int, default=10, help="列出导入耗时最多的顶层模块数，0 表示不列")
+    args = parser.parse_args()
+
+    walls, runs = [], []
+    for _ in range(args.runs):
+        wall, phases = run_once([])
+        walls.append(wall)
+        runs.append(phases)
+    print(f"{args.runs} runs, median (max) ms; phases counted from the start of main.py")
+    print(f"  {'process->ready':16s}{statistics.median(walls):8.1f} ({max(walls):.1f})  含解释器启动和退出")
+    for phase in runs[0]:
+        values = [phases[phase] for phases in runs if phase in phases]
+        print(f"  {phase:16s}{statistics.median(values):8.1f} ({max(values):.1f})")
+    if args.imports:
+        print("top-level imports, cumulative ms:")
+        for ms, name in import_costs(args.imports):
+            print(f"  {name:24s}{ms:8.1f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,47 @@
+"""Start-up phase timing of the GUI.
+
+main.py imports this module first, so times are counted from the start of the script; interpreter start-up before
+that is not included (startup_bench.py measures it from outside). Each phase is recorded once, the first time it is
+reached, like the firmware's boot phases: a reconnect does not move "first packet".
+"""
+import time
+
+# phase -> description, in the order they are normally reached
+PHASES = {
+    "imports": "模块导入",
+    "app": "QApplication",
+    "constructed": "主窗口构造",
+    "window": "主窗口首次绘制",
+    "ready": "延迟加载完成",
+    "serial_open": "串口打开",
+    "first_packet": "第一个数据包",
+}
+
+
+class StartupTimer:
+    def __init__(self):
+        self.origin = time.perf_counter()
+        self.marks = {}
+        self.listeners = []     # callables taking the phase name, called on its first mark
+
+    def mark(self, phase):
+        if phase in self.marks:
+            return False
+        self.marks[phase] = time.perf_counter() - self.origin
+        for listener in self.listeners:
+            listener(phase)
+        return True
+
+    def ms(self, phase):
+        return None if phase not in self.marks else self.marks[phase] * 1000
+
+    def report(self):
+        """One line per reached phase: time since start and since the previous phase, in ms."""
+        lines, previous = [], 0.0
+        for phase, seconds in sorted(self.marks.items(), key=lambda item: item[1]):
+            lines.append(f"{phase:13s}{seconds * 1000:9.1f}{(seconds - previous) * 1000:9.1f}  {PHASES.get(phase, '')}")
+            previous = seconds
+        return "\n".join(lines)
+
+
+STARTUP = StartupTimer()
@@ -0,0 +1,128 @@
+import argparse
+import multiprocessing
+import selectors
+import socket
+import sys
+import threading
+import time
+
+from latency_stats import percentile
+from monitor_core import MonitorCore, SimulatedSource
+from stream_server import KIND_WAVE, StreamReader, StreamServer
+
+
+def subscriber_process(address, count, duration, slow, results):
+    """`count` connections in one process; slow ones read 256 B every 500 ms (below the stream rate)."""
+    selector = selectors.DefaultSelector()
+    readers = []
+    for _ in range(count):
+        sock = socket.socket()
+        if slow:
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 2048)
+        sock.connect(address)
+        sock.setblocking(False)
+        reader = {"sock": sock, "stream": StreamReader(), "latency": [], "samples": 0, "next_read": 0.0}
+        selector.register(sock, selectors.EVENT_READ, reader)
+        readers.append(reader)
+    end = time.time() + duration
+    while time.time() < end:
+        for key, _ in selector.select(timeout=0.05):
+            reader = key.data
+            now = time.time()
+            if slow:
+                if now < reader["next_read"]:
+                    continue
+                reader["next_read"] = now + 0.5
+            try:
+                data = reader["sock"].recv(256 if slow else 65536)
+            except BlockingIOError:
+                continue
+            if not data:
+                selector.unregister(reader["sock"])
+                continue
+            for kind, t, body in reader["stream"].feed(data):
+                if kind == KIND_WAVE:
+                    reader["latency"].append((now - t) * 1000)
+                    reader["samples"] += len(body)
+        if slow:
+            time.sleep(0.01)
+    for reader in readers:
+        reader["sock"].close()
+        results.put((slow, reader["samples"], reader["latency"]))
+
+
+def run(args):
+    core = MonitorCore(SimulatedSource(), name="loadtest")
+    server = StreamServer(port=args.port, device="loadtest", queue_limit=args.queue_limit,
+                          send_buffer=args.send_buffer)
+    server.attach(core)
+    address = server.start()
+
+    results = multiprocessing.Queue()
+    groups = []
+    for slow, total in ((False, args.clients), (True, args.slow_clients)):
+        while total > 0:
+            count = min(total, args.per_process)
+            groups.append(multiprocessing.Process(target=subscriber_process,
+                                                  args=(address, count, args.duration, slow, results)))
+            total -= count
+    for process in groups:
+        process.start()
+    while len(server.clients) < args.clients + args.slow_clients:
+        time.sleep(0.01)
+
+    stop = threading.Event()
+
+    def acquire():
+        while not stop.is_set():
+            core.poll(blocking=True)
+
+    start_wall, start_cpu = time.perf_counter(), time.process_time()
+    worker = threading.Thread(target=acquire, daemon=True)
+    worker.start()
+    stats = []
+    deadline = time.time() + args.duration
+    while time.time() < deadline:
+        time.sleep(0.2)
+        stats = server.stats() or stats
+    wall, cpu = time.perf_counter() - start_wall, time.process_time() - start_cpu
+    stop.set()
+
+    fast, slow = [], []
+    for _ in range(args.clients + args.slow_clients):
+        is_slow, samples, latency = results.get()
+        (slow if is_slow else fast).append((samples, latency))
+    for process in groups:
+        process.join()
+    server.stop()
+
+    expected = core.decoder.rx_packets
+    fast_latency = [value for _, values in fast for value in values]
+    print(f"{args.clients} subscribers + {args.slow_clients} slow, {wall:.1f}s, {expected} packets decoded")
+    print(f"  server process CPU {cpu / wall * 100:.2f}% of one core "
+          f"({cpu / wall * 100 / max(1, args.clients + args.slow_clients):.3f}% per subscriber)")
+    print(f"  fan-out latency ms: p50 {percentile(fast_latency, 0.5):.2f} "
+          f"p99 {percentile(fast_latency, 0.99):.2f} max {max(fast_latency, default=float('nan')):.2f}")
+    if fast:
+        print(f"  fast subscribers received {min(s for s, _ in fast)}..{max(s for s, _ in fast)} wave samples")
+    if slow:
+        dropped = sum(s["dropped"] for s in stats)
+        print(f"  slow subscribers received {min(s for s, _ in slow)}..{max(s for s, _ in slow)} wave samples, "
+              f"server dropped {dropped} messages for them")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="数据流服务负载测试：多个本地订阅者的扇出延迟与 CPU")
+    parser.add_argument("--clients", type=int, default=64)
+    parser.add_argument("--slow-clients", type=int, default=4)
+    parser.add_argument("--per-process", type=int, default=16, help="每个订阅进程的连接数")
+    parser.add_argument("--duration", type=float, default=10.0)
+    parser.add_argument("--port", type=int, default=0, help="0 表示随机端口")
+    parser.add_argument("--queue-limit", type=int, default=128)
+    parser.add_argument("--send-buffer", type=int, default=4096, help="服务端每连接 SO_SNDBUF，调小以便尽快看到慢订阅者丢包")
+    return run(parser.parse_args())
+
+
+if __name__ == "__main__":
+    sys.exit(main())
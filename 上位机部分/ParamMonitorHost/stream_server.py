@@ -0,0 +1,239 @@
+import selectors
+import socket
+import struct
+import threading
+import time
+from collections import deque
+
+from monitor_core import MODULE_STATUS, MODULE_WAVE, is_param_packet, to_int16
+
+STREAM_MAGIC = b"TVS1"
+STREAM_HELLO = struct.Struct("<4sH32s")      # magic, version, device name
+MESSAGE_HEADER = struct.Struct("<BHd")       # kind, sample count, host timestamp
+WAVE_SAMPLE = struct.Struct("<hhh")          # ECG, RESP, SpO2
+PARAM_BODY = struct.Struct("<HHHB")          # HR, RR, SpO2 (0xFFFF invalid), lead bits ECG|RESP<<1|SpO2<<2
+
+KIND_WAVE = 1
+KIND_PARAM = 2
+
+DEFAULT_PORT = 5760
+QUEUE_LIMIT = 512          # messages per client, oldest dropped first
+BATCH_BYTES = 64 * 1024    # coalesced into one send() per client per wakeup
+SEND_BUFFER = 64 * 1024    # caps kernel-side buffering so QUEUE_LIMIT is what bounds a stalled client
+INVALID = 0xFFFF
+
+
+def encode_packets(packets, state, now):
+    """Wave samples of one decode batch as one message, plus a PARAM message if vitals changed."""
+    messages = []
+    body = b"".join(WAVE_SAMPLE.pack(to_int16(p[2], p[3]), to_int16(p[4], p[5]), to_int16(p[6], p[7]))
+                    for p in packets if p[0] == MODULE_WAVE)
+    if body:
+        messages.append(MESSAGE_HEADER.pack(KIND_WAVE, len(body) // WAVE_SAMPLE.size, now) + body)
+    if any(p[0] == MODULE_STATUS or is_param_packet(p) for p in packets):
+        lead = state.lead_status
+        bits = (lead["ECG"] is True) | (lead["RESP"] is True) << 1 | (lead["SpO2"] is True) << 2
+        value = lambda v: INVALID if v is None else v
+        messages.append(MESSAGE_HEADER.pack(KIND_PARAM, 1, now) +
+                        PARAM_BODY.pack(value(state.hr), value(state.resp_rate), value(state.spo2), bits))
+    return messages
+
+
+class StreamReader:
+    """Client-side framing: feed received bytes, get (kind, timestamp, body) tuples."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.hello = None
+
+    def feed(self, data):
+        self.buffer += data
+        messages = []
+        offset = 0
+        if self.hello is None:
+            if len(self.buffer) < STREAM_HELLO.size:
+                return messages
+            magic, version, device = STREAM_HELLO.unpack_from(self.buffer)
+            if magic != STREAM_MAGIC:
+                raise ValueError("not a TriVital stream")
+            self.hello = {"version": version, "device": device.rstrip(b"\0").decode("utf-8")}
+            offset = STREAM_HELLO.size
+        while len(self.buffer) - offset >= MESSAGE_HEADER.size:
+            kind, count, t = MESSAGE_HEADER.unpack_from(self.buffer, offset)
+            size = count * WAVE_SAMPLE.size if kind == KIND_WAVE else PARAM_BODY.size
+            end = offset + MESSAGE_HEADER.size + size
+            if end > len(self.buffer):
+                break
+            body = bytes(self.buffer[offset + MESSAGE_HEADER.size:end])
+            if kind == KIND_WAVE:
+                messages.append((kind, t, list(WAVE_SAMPLE.iter_unpack(body))))
+            else:
+                messages.append((kind, t, PARAM_BODY.unpack(body)))
+            offset = end
+        del self.buffer[:offset]
+        return messages
+
+
+class StreamClient:
+    def __init__(self, sock, address, queue_limit):
+        self.sock = sock
+        self.address = address
+        self.queue = deque(maxlen=queue_limit)
+        self.pending = b""
+        self.dropped = 0
+        self.sent_bytes = 0
+        self.writing = False
+
+
+class StreamServer:
+    """Local TCP fan-out of decoded frames.
+
+    publish() only appends to per-client bounded deques and pokes the server
+    thread, so acquisition never waits on a socket. The server thread coalesces
+    each client's queue into one non-blocking send(); a client that cannot keep
+    up loses its oldest messages (counted in `dropped`), never anybody else's.
+    """
+
+    def __init__(self, host="127.0.0.1", port=DEFAULT_PORT, device="", queue_limit=QUEUE_LIMIT, send_buffer=SEND_BUFFER,
+                 logger=None):
+        self.address = (host, port)
+        self.send_buffer = send_buffer
+        self.device = device
+        self.queue_limit = queue_limit
+        self.logger = logger
+        self.clients = ()
+        self.selector = None
+        self.thread = None
+        self.running = False
+
+    def attach(self, core):
+        core.packet_listeners.append(self.on_packets)
+
+    def on_packets(self, core, packets):
+        if self.clients:
+            for message in encode_packets(packets, core.state, time.time()):
+                self.publish(message)
+
+    def publish(self, message):
+        for client in self.clients:
+            if len(client.queue) == client.queue.maxlen:
+                client.dropped += 1
+            client.queue.append(message)
+        self._wake()
+
+    def start(self):
+        self.listener = socket.create_server(self.address)
+        self.listener.setblocking(False)
+        self.address = self.listener.getsockname()
+        self.wake_r, self.wake_w = socket.socketpair()
+        self.wake_r.setblocking(False)
+        self.wake_w.setblocking(False)
+        self.selector = selectors.DefaultSelector()
+        self.selector.register(self.listener, selectors.EVENT_READ)
+        self.selector.register(self.wake_r, selectors.EVENT_READ)
+        self.running = True
+        self.thread = threading.Thread(target=self._run, name="StreamServer", daemon=True)
+        self.thread.start()
+        if self.logger:
+            self.logger.info("数据流服务启动: %s:%d", *self.address[:2])
+        return self.address
+
+    def stop(self):
+        if not self.running:
+            return
+        self.running = False
+        self._wake()
+        self.thread.join(2.0)
+        for client in self.clients:
+            client.sock.close()
+        self.clients = ()
+        self.selector.close()
+        self.listener.close()
+        self.wake_r.close()
+        self.wake_w.close()
+
+    def stats(self):
+        return [{"address": c.address, "queued": len(c.queue), "dropped": c.dropped, "sent_bytes": c.sent_bytes}
+                for c in self.clients]
+
+    def _wake(self):
+        try:
+            self.wake_w.send(b"\0")
+        except (BlockingIOError, OSError):
+            pass
+
+    def _run(self):
+        while self.running:
+            for key, events in self.selector.select(timeout=0.5):
+                if key.fileobj is self.listener:
+                    self._accept()
+                elif key.fileobj is self.wake_r:
+                    try:
+                        while self.wake_r.recv(4096):
+                            pass
+                    except BlockingIOError:
+                        pass
+                elif events & selectors.EVENT_READ:
+                    self._read(key.data)
+            for client in self.clients:
+                self._flush(client)
+
+    def _accept(self):
+        try:
+            sock, address = self.listener.accept()
+        except BlockingIOError:
+            return
+        sock.setblocking(False)
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, self.send_buffer)
+        client = StreamClient(sock, address, self.queue_limit)
+        client.pending = memoryview(STREAM_HELLO.pack(STREAM_MAGIC, 1, self.device.encode("utf-8")[:32]))
+        self.selector.register(sock, selectors.EVENT_READ, client)
+        self.clients = self.clients + (client,)
+        if self.logger:
+            self.logger.info("数据流客户端接入: %s:%d", *address[:2])
+
+    def _drop(self, client):
+        self.clients = tuple(c for c in self.clients if c is not client)
+        self.selector.unregister(client.sock)
+        client.sock.close()
+        if self.logger:
+            self.logger.info("数据流客户端断开: %s:%d (丢弃 %d 条)", client.address[0], client.address[1], client.dropped)
+
+    def _read(self, client):
+        try:
+            data = client.sock.recv(4096)
+        except BlockingIOError:
+            return
+        except OSError:
+            data = b""
+        if not data:
+            self._drop(client)
+
+    def _flush(self, client):
+        while True:
+            if not client.pending:
+                if not client.queue:
+                    break
+                batch, size = [], 0
+                while client.queue and size < BATCH_BYTES:
+                    message = client.queue.popleft()
+                    batch.append(message)
+                    size += len(message)
+                client.pending = memoryview(b"".join(batch))
+            try:
+                sent = client.sock.send(client.pending)
+            except BlockingIOError:
+                sent = 0
+            except OSError:
+                self._drop(client)
+                return
+            client.sent_bytes += sent
+            client.pending = client.pending[sent:]
+            if client.pending:
+                break
+        writing = bool(client.pending)
+        if writing != client.writing:
+            client.writing = writing
+            events = selectors.EVENT_READ | (selectors.EVENT_WRITE if writing else 0)
+            self.selector.modify(client.sock, events, client)
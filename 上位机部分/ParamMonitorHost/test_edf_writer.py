@@ -0,0 +1,31 @@
+import os
+import tempfile
+import unittest
+
+from edf_writer import ANNOTATION_BYTES, EdfWriter, SAMPLE_RATE, SIGNALS
+
+
+class EdfWriterTest(unittest.TestCase):
+    def setUp(self):
+        handle, self.path = tempfile.mkstemp(suffix=".edf")
+        os.close(handle)
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def test_oversized_annotation_is_shortened(self):
+        writer = EdfWriter(self.path, start=0)
+        writer.write_samples([[0] * len(SIGNALS)] * (SAMPLE_RATE // 2))
+        writer.annotate(0.2, "报警 " + "超长" * ANNOTATION_BYTES)
+        writer.annotate(0.3, "ECG导联脱落")
+        writer.close()
+        self.assertEqual(writer.records, 2)
+        self.assertFalse(writer.annotations)
+        with open(self.path, "rb") as f:
+            data = f.read()
+        self.assertIn("ECG导联脱落".encode("utf-8"), data)
+        self.assertEqual(data[236:244].strip(), b"2")
+
+
+if __name__ == "__main__":
+    unittest.main()
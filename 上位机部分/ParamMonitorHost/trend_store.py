@@ -0,0 +1,128 @@
+import os
+
+import numpy as np
+
+VITALS = ("hr", "resp_rate", "spo2")
+STAT_MIN, STAT_MEAN, STAT_MAX = 0, 1, 2
+
+# (bucket seconds, bucket count): 1 s for 72 h, 1 min for 30 days, 15 min for a year
+TIERS = ((1, 72 * 3600), (60, 30 * 24 * 60), (900, 365 * 96))
+FLUSH_INTERVAL = 60.0
+
+
+class TrendTier:
+    """Ring of fixed-width buckets on disk, indexed by bucket number modulo capacity.
+
+    keys[slot] holds the bucket number stored in that slot (-1 when empty), so a
+    range query touches exactly the slots it asks for and never scans history.
+    """
+
+    def __init__(self, directory, resolution, capacity):
+        self.resolution = resolution
+        self.capacity = capacity
+        prefix = os.path.join(directory, f"trend_{resolution}s")
+        self.values = self._open(prefix + "_values.npy", np.float32, (capacity, len(VITALS), 3), np.nan)
+        self.keys = self._open(prefix + "_keys.npy", np.int64, (capacity,), -1)
+        self.acc_bucket = None
+        self.acc_count = np.zeros(len(VITALS))
+        self.acc_sum = np.zeros(len(VITALS))
+        self.acc_min = np.full(len(VITALS), np.inf)
+        self.acc_max = np.full(len(VITALS), -np.inf)
+
+    @staticmethod
+    def _open(path, dtype, shape, fill):
+        if os.path.exists(path):
+            array = np.load(path, mmap_mode="r+")
+            if array.shape == shape and array.dtype == dtype:
+                return array
+        array = np.lib.format.open_memmap(path, mode="w+", dtype=dtype, shape=shape)
+        array[:] = fill
+        return array
+
+    def _pending(self):
+        count = np.where(self.acc_count > 0, self.acc_count, np.nan)
+        return np.stack([self.acc_min, self.acc_sum / count, self.acc_max], axis=1).astype(np.float32)
+
+    def _commit(self):
+        if self.acc_bucket is None:
+            return
+        values = self._pending()
+        values[self.acc_count == 0] = np.nan
+        slot = self.acc_bucket % self.capacity
+        self.values[slot] = values
+        self.keys[slot] = self.acc_bucket
+        self.acc_count[:] = 0
+        self.acc_sum[:] = 0
+        self.acc_min[:] = np.inf
+        self.acc_max[:] = -np.inf
+
+    def add(self, t, sample):
+        bucket = int(t // self.resolution)
+        if bucket != self.acc_bucket:
+            self._commit()
+            self.acc_bucket = bucket
+        for i, value in enumerate(sample):
+            if value is None:
+                continue
+            self.acc_count[i] += 1
+            self.acc_sum[i] += value
+            self.acc_min[i] = min(self.acc_min[i], value)
+            self.acc_max[i] = max(self.acc_max[i], value)
+
+    def query(self, t0, t1):
+        """Bucket start times and (n, vitals, min/mean/max) values for [t0, t1]."""
+        first, last = int(t0 // self.resolution), int(t1 // self.resolution)
+        first = max(first, last - self.capacity + 1)
+        buckets = np.arange(first, last + 1, dtype=np.int64)
+        slots = buckets % self.capacity
+        values = self.values[slots]
+        values[self.keys[slots] != buckets] = np.nan
+        if self.acc_bucket is not None and first <= self.acc_bucket <= last:
+            pending = self._pending()
+            pending[self.acc_count == 0] = np.nan
+            values[self.acc_bucket - first] = pending
+        return buckets * self.resolution, values
+
+    def flush(self):
+        self.values.flush()
+        self.keys.flush()
+
+
+class TrendStore:
+    """Tiered min/mean/max history of HR/RR/SpO2, fed once per PARAM packet."""
+
+    def __init__(self, directory, tiers=TIERS):
+        os.makedirs(directory, exist_ok=True)
+        self.directory = directory
+        self.tiers = [TrendTier(directory, resolution, capacity) for resolution, capacity in tiers]
+        self.last_flush = 0.0
+
+    def add(self, t, hr, resp_rate, spo2):
+        sample = (hr, resp_rate, spo2)
+        for tier in self.tiers:
+            tier.add(t, sample)
+        if t - self.last_flush >= FLUSH_INTERVAL:
+            self.flush()
+            self.last_flush = t
+
+    def tier_for(self, span, max_points):
+        for tier in self.tiers:
+            if span / tier.resolution <= max_points and span <= tier.resolution * tier.capacity:
+                return tier
+        return self.tiers[-1]
+
+    def query(self, t0, t1, max_points=2000):
+        """Finest tier that covers [t0, t1] in at most max_points buckets."""
+        tier = self.tier_for(max(t1 - t0, 1), max_points)
+        times, values = tier.query(t0, t1)
+        return tier.resolution, times, values
+
+    def flush(self):
+        for tier in self.tiers:
+            tier.flush()
+
+    def close(self):
+        for tier in self.tiers:
+            tier._commit()
+        self.flush()
+
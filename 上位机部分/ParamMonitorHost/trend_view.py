@@ -0,0 +1,115 @@
+import time
+
+import numpy as np
+from PyQt5 import QtWidgets
+from PyQt5.QtCore import QPointF, QRectF, Qt, QTimer
+from PyQt5.QtGui import QColor, QPainter, QPen, QPolygonF
+
+from trend_store import STAT_MAX, STAT_MEAN, STAT_MIN
+from ui_theme import COLORS, MONO_FONT, debug_controls_style
+
+TREND_SPANS = (("1 小时", 3600), ("8 小时", 8 * 3600), ("24 小时", 24 * 3600), ("72 小时", 72 * 3600))
+TREND_ROWS = (("HR", "bpm", COLORS["ecg"], 30, 180), ("RR", "rpm", COLORS["resp"], 0, 40), ("SpO2", "%", COLORS["spo2"], 80, 100))
+
+
+class TrendPlot(QtWidgets.QWidget):
+    """HR/RR/SpO2 trend: min-max band plus mean line per bucket."""
+
+    def __init__(self, parent=None):
+        super().__init__(parent)
+        self.setMinimumSize(640, 360)
+        self.t0 = self.t1 = 0
+        self.times = None
+        self.values = None
+
+    def set_data(self, t0, t1, times, values):
+        self.t0, self.t1 = t0, t1
+        self.times, self.values = times, values
+        self.update()
+
+    def paintEvent(self, event):
+        painter = QPainter(self)
+        painter.fillRect(self.rect(), QColor(COLORS["surface"]))
+        painter.setRenderHint(QPainter.Antialiasing, True)
+        row_height = self.height() / len(TREND_ROWS)
+        for row, (name, unit, color, low, high) in enumerate(TREND_ROWS):
+            area = QRectF(56, row * row_height + 14, self.width() - 64, row_height - 28)
+            self._draw_axes(painter, area, f"{name} {unit}", color, low, high)
+            if self.times is not None and len(self.times):
+                self._draw_series(painter, area, self.values[:, row, :], color, low, high)
+        painter.end()
+
+    def _draw_axes(self, painter, area, title, color, low, high):
+        painter.setPen(QPen(QColor(COLORS["border"]), 1, Qt.DotLine))
+        for fraction in (0.0, 0.5, 1.0):
+            y = area.top() + area.height() * fraction
+            painter.drawLine(QPointF(area.left(), y), QPointF(area.right(), y))
+        painter.setPen(QColor(COLORS["text_muted"]))
+        painter.drawText(QRectF(0, area.top() - 6, 52, 14), Qt.AlignRight, str(high))
+        painter.drawText(QRectF(0, area.bottom() - 8, 52, 14), Qt.AlignRight, str(low))
+        painter.setPen(QColor(color))
+        painter.drawText(QRectF(area.left() + 4, area.top(), 200, 16), Qt.AlignLeft, title)
+
+    def _draw_series(self, painter, area, stats, color, low, high):
+        span = max(self.t1 - self.t0, 1)
+        xs = area.left() + (self.times - self.t0) / span * area.width()
+        scale = lambda v: area.bottom() - (np.clip(v, low, high) - low) / (high - low) * area.height()
+        band = QColor(color)
+        band.setAlpha(70)
+        valid = ~np.isnan(stats[:, STAT_MEAN])
+        # draw each run of consecutive valid buckets separately so gaps stay visible
+        edges = np.flatnonzero(np.diff(np.concatenate(([0], valid.view(np.int8), [0]))))
+        for start, stop in zip(edges[::2], edges[1::2]):
+            x = xs[start:stop]
+            top, mean, bottom = scale(stats[start:stop, STAT_MAX]), scale(stats[start:stop, STAT_MEAN]), scale(stats[start:stop, STAT_MIN])
+            outline = [QPointF(px, py) for px, py in zip(x, top)] + [QPointF(px, py) for px, py in zip(x[::-1], bottom[::-1])]
+            painter.setPen(Qt.NoPen)
+            painter.setBrush(band)
+            painter.drawPolygon(QPolygonF(outline))
+            painter.setPen(QPen(QColor(color), 1.5))
+            painter.setBrush(Qt.NoBrush)
+            painter.drawPolyline(QPolygonF([QPointF(px, py) for px, py in zip(x, mean)]))
+
+
+class TrendView(QtWidgets.QWidget):
+    def __init__(self, store, parent=None):
+        super().__init__(parent, Qt.Window)
+        self.store = store
+        self.setWindowTitle("生命体征趋势")
+        self.setStyleSheet(f"background-color: {COLORS['panel']}; color: {COLORS['text']}; font-family: {MONO_FONT};")
+        layout = QtWidgets.QVBoxLayout(self)
+        controls = QtWidgets.QHBoxLayout()
+        self.spanCombo = QtWidgets.QComboBox()
+        for label, seconds in TREND_SPANS:
+            self.spanCombo.addItem(label, seconds)
+        self.spanCombo.setCurrentIndex(2)
+        self.spanCombo.currentIndexChanged.connect(self.refresh)
+        self.tierLabel = QtWidgets.QLabel()
+        self.tierLabel.setStyleSheet(f"color: {COLORS['text_muted']};")
+        controls.addWidget(self.spanCombo)
+        controls.addWidget(self.tierLabel, 1)
+        controls_box = QtWidgets.QGroupBox("TREND")
+        controls_box.setStyleSheet(debug_controls_style())
+        controls_box.setLayout(controls)
+        self.plot = TrendPlot()
+        layout.addWidget(controls_box)
+        layout.addWidget(self.plot, 1)
+        self.refreshTimer = QTimer(self)
+        self.refreshTimer.timeout.connect(self.refresh)
+
+    def showEvent(self, event):
+        self.refresh()
+        self.refreshTimer.start(1000)
+        super().showEvent(event)
+
+    def hideEvent(self, event):
+        self.refreshTimer.stop()
+        super().hideEvent(event)
+
+    def refresh(self):
+        span = self.spanCombo.currentData()
+        t1 = time.time()
+        t0 = t1 - span
+        resolution, times, values = self.store.query(t0, t1, max_points=max(2 * self.plot.width(), 400))
+        self.tierLabel.setText(f"  {resolution} s/点，{len(times)} 点")
+        self.plot.set_data(t0, t1, times, values)
@@ -185,6 +185,36 @@ def main_window_style():
     """
 
 
+def central_widget_style():
+    """The selector-less background this sheet replaced reached every child of the central widget and overrode
+    the window sheet, so the state rules driven by dynamic properties (see view_model.py) live here."""
+    return f"""
+        * {{
+            background-color: {COLORS["window"]};
+        }}
+        QLabel#metricValue {{
+            background: transparent;
+        }}
+        QLabel#metricValue[channel="ecg"] {{ color: {COLORS["ecg"]}; }}
+        QLabel#metricValue[channel="spo2"] {{ color: {COLORS["spo2"]}; }}
+        QLabel#metricValue[channel="resp"] {{ color: {COLORS["resp"]}; }}
+        QLabel#metricValue[state="alarm"] {{ color: {COLORS["alarm"]}; }}
+        QLabel#metricValue[state="invalid"] {{ color: {COLORS["text_dim"]}; }}
+        QLabel#statusText {{
+            {status_label_style(False)}
+        }}
+        QLabel#statusText[alarm="true"] {{
+            {status_label_style(True)}
+        }}
+        QLabel#alarmTitle {{
+            {alarm_title_style(False)}
+        }}
+        QLabel#alarmTitle[alarm="true"] {{
+            {alarm_title_style(True)}
+        }}
+    """
+
+
 def menu_bar_style():
     return f"""
         QMenuBar {{
@@ -239,10 +269,6 @@ def metric_card_style():
     """
 
 
-def metric_value_style(color):
-    return f"color: {color}; background: transparent;"
-
-
 def metric_name_style(color=None):
     text_color = color or COLORS["text_dim"]
     return f"""
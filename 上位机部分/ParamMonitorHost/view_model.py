@@ -0,0 +1,66 @@
+"""Change-driven updates of the parameter panel, lead labels, alarm title and status bar.
+
+Every key remembers the last value pushed to its widgets, and set() touches the widgets only when the value
+differs. Colours follow dynamic properties matched by the window style sheet (ui_theme.main_window_style), so a
+state change re-polishes that one widget instead of parsing a new per-widget style sheet.
+"""
+INVALID_TEXT = "---"
+_MISSING = object()
+
+
+def value_text(value):
+    return INVALID_TEXT if value is None else str(value)
+
+
+def metric_state(alarm, invalid):
+    """Value of the metricValue "state" property."""
+    if invalid:
+        return "invalid"
+    return "alarm" if alarm else "normal"
+
+
+def lead_text(ok):
+    return "导联正常" if ok else "导联异常"
+
+
+def alarm_title_text(active):
+    return "报警状态: 异常" if active else "报警状态: 正常"
+
+
+def repolish(widget):
+    style = widget.style()
+    style.unpolish(widget)
+    style.polish(widget)
+    widget.update()
+
+
+class ViewModel:
+    def __init__(self):
+        self.bindings = {}      # key -> [apply(value)]
+        self.values = {}
+        self.updates = 0        # widget updates actually made, for view_update_bench.py
+
+    def bind(self, key, apply):
+        self.bindings.setdefault(key, []).append(apply)
+
+    def bind_text(self, key, label, text=value_text):
+        self.bind(key, lambda value: label.setText(text(value)))
+
+    def bind_property(self, key, widget, name, convert=lambda value: value):
+        def apply(value):
+            widget.setProperty(name, convert(value))
+            repolish(widget)
+        self.bind(key, apply)
+
+    def get(self, key, default=None):
+        return self.values.get(key, default)
+
+    def set(self, key, value):
+        """Push value to the widgets bound to key; returns False without touching them when it is unchanged."""
+        if self.values.get(key, _MISSING) == value:
+            return False
+        self.values[key] = value
+        for apply in self.bindings.get(key, ()):
+            apply(value)
+            self.updates += 1
+        return True
@@ -0,0 +1,74 @@
+import argparse
+import os
+import sys
+import time
+
+from PyQt5.QtCore import QEventLoop, QTimer
+from PyQt5.QtWidgets import QApplication
+
+from host_profiler import StageProfiler, Target
+from monitor_core import SimulatedSource
+
+VITALS_METHODS = ("analyzeParamData", "analyzeStatusData")
+
+
+def targets(window):
+    """The window's profiler targets with the parameter and lead updates split out of "analyze"."""
+    result = window.profiler_targets()
+    for target in result:
+        if target.name in VITALS_METHODS:
+            target.stage = "vitals"
+    result.append(Target(window, "evaluate_alarms", "vitals"))
+    return result
+
+
+def run(app, window, source, seconds):
+    """Stage times of the GUI thread on a simulated device, after a warm-up of the same length is discarded."""
+    window.core.source = source
+    window.serialPortTimer.start(2)
+    window.procDataTimer.start(10)
+    loop = QEventLoop()
+    QTimer.singleShot(int(seconds * 1000), loop.quit)
+    loop.exec_()
+    view = getattr(window, "view", None)
+    updates = view.updates if view is not None else 0
+    profiler = StageProfiler()
+    profiler.enable(targets(window))
+    QTimer.singleShot(int(seconds * 1000), loop.quit)
+    wall, cpu = time.perf_counter(), time.process_time()
+    loop.exec_()
+    wall, cpu = time.perf_counter() - wall, time.process_time() - cpu
+    report = profiler.report()
+    profiler.disable()
+    window.serialPortTimer.stop()
+    window.procDataTimer.stop()
+    if view is not None:
+        report += f"\nwidget updates {(view.updates - updates) / wall:.1f}/s"
+    return cpu / wall * 100, report
+
+
+def main():
+    parser = argparse.ArgumentParser(description="参数区与状态栏刷新的稳态开销：各阶段每秒占用主线程的时间")
+    parser.add_argument("--seconds", type=float, default=20.0, help="每种场景的测量时长（之前另有同样长的预热）")
+    args = parser.parse_args()
+
+    app = QApplication(sys.argv)
+    from ParamMonitor import ParamMonitor
+
+    window = ParamMonitor()
+    window.resize(1280, 760)
+    window.show()
+    app.processEvents()
+    window.finish_startup()
+    window.alarm_muted = True       # QApplication.beep() would dominate the alarm case
+    print(f"{os.environ.get('QT_QPA_PLATFORM', 'default')} platform, {args.seconds:.0f} s per case")
+    for name, source in (("normal", SimulatedSource()), ("HR alarm", SimulatedSource(hr=150))):
+        cpu, report = run(app, window, source, args.seconds)
+        print(f"{name}: process CPU {cpu:.1f}%")
+        print("  " + report.replace("\n", "\n  "))
+    window.trend_store.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,157 @@
+"""Host-side recomputation of HR, RR and pulse rate from the wave stream, compared with the device's PARAM packet.
+
+Samples are buffered and analysed in fixed blocks (250 ms by default) with NumPy. Each block touches only the new
+samples plus a short tail of the previous block, and the peak/interval histories are bounded, so the cost per block
+is constant however long the session runs. MonitorCore owns one per device and feeds it the wave packets.
+"""
+from collections import deque
+from dataclasses import dataclass
+
+import numpy as np
+
+WAVE_RATE_HZ = 250
+BLOCK_S = 0.25
+MISMATCH_S = 10.0       # disagreement must last this long before it is an alarm
+
+
+@dataclass(frozen=True)
+class DetectorParams:
+    smooth_s: float         # moving-average length applied before peak picking
+    slope_energy: bool      # square the first difference first (QRS: polarity-free, suppresses T waves)
+    threshold: float        # fraction of the recent min..max range a peak must exceed
+    refractory_s: float     # shortest accepted interval
+    envelope_s: float       # span of the min/max envelope
+    intervals: int          # intervals in the rate median
+
+
+ECG_PARAMS = DetectorParams(smooth_s=0.08, slope_energy=True, threshold=0.3, refractory_s=0.25, envelope_s=3.0, intervals=8)
+RESP_PARAMS = DetectorParams(smooth_s=0.4, slope_energy=False, threshold=0.6, refractory_s=1.5, envelope_s=12.0, intervals=4)
+PULSE_PARAMS = DetectorParams(smooth_s=0.08, slope_energy=False, threshold=0.6, refractory_s=0.3, envelope_s=3.0, intervals=8)
+
+
+@dataclass(frozen=True)
+class Tolerance:
+    absolute: float         # per minute
+    relative: float         # fraction of the device value
+
+
+# host value name -> (device VitalsState attribute, tolerance, alarm text)
+CHECKS = {
+    "hr": ("hr", Tolerance(5, 0.10), "心率交叉校验不符"),
+    "resp_rate": ("resp_rate", Tolerance(3, 0.15), "呼吸率交叉校验不符"),
+    # the firmware reports no pulse rate; the PPG rate must agree with the ECG heart rate instead
+    "pulse_rate": ("hr", Tolerance(5, 0.10), "脉率交叉校验不符"),
+}
+
+
+class PeakDetector:
+    """Incremental peak picking on one channel. Peaks are absolute sample indices."""
+
+    def __init__(self, params, rate=WAVE_RATE_HZ, block=int(BLOCK_S * WAVE_RATE_HZ)):
+        self.params = params
+        self.rate = rate
+        self.smooth = max(1, int(params.smooth_s * rate))
+        self.kernel = np.ones(self.smooth) / self.smooth
+        self.refractory = int(params.refractory_s * rate)
+        self.tail = np.zeros(0)
+        self.tail_len = self.smooth + 4     # enough for the next block to rescan what this one could not decide
+        self.position = 0                   # absolute index of the next sample fed
+        self.scanned = 0                    # absolute index of the first sample not yet tested as a peak
+        self.envelope = deque(maxlen=max(1, int(params.envelope_s * rate / block)))
+        self.last_peak = None
+        self.peaks = deque(maxlen=params.intervals + 1)
+
+    def feed(self, samples):
+        """Pick the peaks in a block of samples. A sample is tested once both its smoothed neighbours are complete,
+        so the last few samples of each block are decided with the next one."""
+        p = self.params
+        start = self.position - len(self.tail)
+        x = np.concatenate((self.tail, samples.astype(np.float64)))
+        self.position += len(samples)
+        self.tail = x[-self.tail_len:]
+        if p.slope_energy:
+            x = np.diff(x, prepend=x[0]) ** 2
+        y = np.convolve(x, self.kernel, mode="same")
+        # the moving average is complete, and clear of the first difference, only on y[a:b]
+        a, b = self.smooth // 2 + 1, len(y) - self.smooth // 2 - 1
+        if b - a < 3:
+            return
+        valid = y[a:b]
+        self.envelope.append((valid.min(), valid.max()))
+        low = min(e[0] for e in self.envelope)
+        high = max(e[1] for e in self.envelope)
+        if high > low:
+            mid = valid[1:-1]
+            is_peak = (mid > valid[:-2]) & (mid >= valid[2:]) & (mid > low + p.threshold * (high - low))
+            for index in np.flatnonzero(is_peak) + start + a + 1:
+                if index < self.scanned or (self.last_peak is not None and index - self.last_peak < self.refractory):
+                    continue
+                self.last_peak = int(index)
+                self.peaks.append(self.last_peak)
+        self.scanned = start + b - 1
+
+    def rate_per_min(self):
+        """Median interval of the recent peaks, or None without enough beats or after a pause of three intervals."""
+        if len(self.peaks) < 3:
+            return None
+        intervals = np.diff(np.fromiter(self.peaks, dtype=np.int64))
+        median = float(np.median(intervals))
+        if self.position - self.peaks[-1] > 3 * median:
+            return None
+        return 60.0 * self.rate / median
+
+
+class VitalsCrossCheck:
+    """Buffers wave samples and runs the three detectors once per block."""
+
+    def __init__(self, block_s=BLOCK_S, mismatch_s=MISMATCH_S, rate=WAVE_RATE_HZ):
+        self.block = int(block_s * rate)
+        self.mismatch_blocks = int(mismatch_s / block_s)
+        self.buffer = np.zeros((self.block * 8, 3), dtype=np.int16)
+        self.fill = 0
+        self.detectors = {
+            "hr": PeakDetector(ECG_PARAMS, rate, self.block),
+            "resp_rate": PeakDetector(RESP_PARAMS, rate, self.block),
+            "pulse_rate": PeakDetector(PULSE_PARAMS, rate, self.block),
+        }
+        self.rates = dict.fromkeys(self.detectors)
+        self.mismatch_count = dict.fromkeys(CHECKS, 0)
+        self.alarms = []
+
+    def feed(self, payloads, state):
+        """Add the 6-byte data of a batch of wave packets; returns True when the technical alarms changed."""
+        if not payloads:
+            return False
+        samples = np.array(payloads, dtype=np.uint8).view(">i2")
+        changed = False
+        while len(samples):
+            take = min(len(samples), len(self.buffer) - self.fill)
+            self.buffer[self.fill:self.fill + take] = samples[:take]
+            self.fill += take
+            samples = samples[take:]
+            while self.fill >= self.block:
+                changed |= self.process_block(self.buffer[:self.block], state)
+                self.buffer[:self.fill - self.block] = self.buffer[self.block:self.fill]
+                self.fill -= self.block
+        return changed
+
+    def process_block(self, block, state):
+        for channel, (name, detector) in enumerate(self.detectors.items()):
+            detector.feed(block[:, channel])
+            self.rates[name] = detector.rate_per_min()
+        alarms = []
+        for name, (device_attr, tolerance, text) in CHECKS.items():
+            host, device = self.rates[name], getattr(state, device_attr)
+            if host is None or device is None:
+                self.mismatch_count[name] = 0
+                continue
+            if abs(host - device) > max(tolerance.absolute, tolerance.relative * device):
+                self.mismatch_count[name] += 1
+            else:
+                self.mismatch_count[name] = 0
+            if self.mismatch_count[name] >= self.mismatch_blocks:
+                alarms.append(text)
+        if alarms == self.alarms:
+            return False
+        self.alarms = alarms
+        return True
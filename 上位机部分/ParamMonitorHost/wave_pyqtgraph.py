@@ -0,0 +1,146 @@
+import numpy as np
+from PyQt5.QtCore import QTimer
+
+from monitor_core import WAVE_RATE_HZ
+from ui_theme import COLORS
+
+try:
+    import pyqtgraph as pg
+except ImportError:         # optional backend; the QPixmap sweep stays the default
+    pg = None
+
+AVAILABLE = pg is not None
+WINDOW_SECONDS = 8          # visible sweep width
+REFRESH_HZ = 30             # plots are redrawn at this rate however fast packets arrive
+GAP_SECONDS = 0.16          # blank gap ahead of the sweep cursor
+
+
+class WaveRing:
+    """Sweep buffer: samples are written at a wrapping index into a fixed x grid.
+
+    The slots just ahead of the write position hold NaN, so with connect="finite"
+    the newest trace overwrites the oldest one behind a moving gap, like the
+    QPixmap sweep. Writes are vectorised; nothing is reallocated per packet.
+    marks holds the sample value at marked slots (QRS peaks) and NaN elsewhere;
+    a mark is erased when the sweep overwrites its slot.
+    """
+
+    def __init__(self, length, gap):
+        self.y = np.full(length, np.nan)
+        self.marks = np.full(length, np.nan)
+        self.gap = gap
+        self.index = 0
+        self.dirty = False
+
+    def extend(self, samples, marks=()):
+        """marks: indices into samples; negative ones fall on samples pushed earlier."""
+        samples = np.asarray(samples, dtype=np.float64)
+        dropped = max(len(samples) - len(self.y), 0)
+        samples = samples[dropped:]
+        n = len(samples)
+        if not n:
+            return
+        start = self.index
+        positions = (start + np.arange(n + self.gap)) % len(self.y)
+        self.y[positions[:n]] = samples
+        self.y[positions[n:]] = np.nan
+        self.marks[positions] = np.nan
+        for index in marks:
+            index -= dropped
+            if n + self.gap - len(self.y) <= index < n:     # older slots were just overwritten
+                position = (start + index) % len(self.y)
+                self.marks[position] = self.y[position]
+        self.index = (self.index + n) % len(self.y)
+        self.dirty = True
+
+    def clear(self):
+        self.y[:] = np.nan
+        self.marks[:] = np.nan
+        self.index = 0
+        self.dirty = True
+
+    def y_range(self):
+        """Visible min/max with the same 10% margin as the QPixmap adaptive scale."""
+        if np.isnan(self.y).all():
+            return -1.0, 1.0
+        low, high = float(np.nanmin(self.y)), float(np.nanmax(self.y))
+        if high == low:
+            low, high = low - 100, high + 100
+        margin = (high - low) * 0.1
+        return low - margin, high + margin
+
+
+class PyqtgraphWaves:
+    """pyqtgraph rendering of the three wave rows, swapped in for the QLabel pixmaps.
+
+    Each row is a PlotDataItem over a WaveRing with clipToView and peak-mode auto
+    downsampling, so the drawn point count follows the widget width rather than
+    the window length. The first (ECG) row also carries a ScatterPlotItem for the
+    QRS marks. A QTimer pushes dirty rings to the plots at REFRESH_HZ.
+    """
+
+    def __init__(self, rows, parent=None):
+        """rows: (layout, wave_label, color) per channel, in push() order."""
+        pg.setConfigOptions(antialias=True)
+        length = WINDOW_SECONDS * WAVE_RATE_HZ
+        self.x = np.arange(length) / WAVE_RATE_HZ
+        self.rows = []
+        for layout, label, color in rows:
+            plot = pg.PlotWidget(parent, background=COLORS["surface"])
+            plot.setMinimumHeight(label.minimumHeight())
+            plot.setSizePolicy(label.sizePolicy())
+            item = plot.getPlotItem()
+            item.hideAxis("left")
+            item.hideAxis("bottom")
+            item.hideButtons()
+            item.setMenuEnabled(False)
+            item.setMouseEnabled(x=False, y=False)
+            item.showGrid(x=True, y=True, alpha=0.25)
+            item.setXRange(0, WINDOW_SECONDS, padding=0)
+            ring = WaveRing(length, int(GAP_SECONDS * WAVE_RATE_HZ))
+            curve = item.plot(self.x, ring.y, pen=pg.mkPen(color, width=2), connect="finite")
+            curve.setClipToView(True)
+            curve.setDownsampling(auto=True, method="peak")
+            marks = None
+            if not self.rows:
+                marks = pg.ScatterPlotItem(symbol="t", size=9, pen=pg.mkPen(None), brush=pg.mkBrush(COLORS["white"]))
+                item.addItem(marks)
+            layout.insertWidget(layout.indexOf(label) + 1, plot, 1)
+            plot.hide()
+            self.rows.append((label, plot, item, curve, ring, marks))
+        self.timer = QTimer(parent)
+        self.timer.timeout.connect(self.refresh)
+        self.active = False
+
+    def widgets(self):
+        return [plot for _, plot, _, _, _, _ in self.rows]
+
+    def activate(self, active):
+        self.active = active
+        for label, plot, _, _, _, _ in self.rows:
+            label.setVisible(not active)
+            plot.setVisible(active)
+        if active:
+            self.timer.start(1000 // REFRESH_HZ)
+        else:
+            self.timer.stop()
+
+    def push(self, *channels, marks=()):
+        """marks: QRS indices into the first channel's samples, as collected for the QPixmap sweep."""
+        for row, ((_, _, _, _, ring, _), samples) in enumerate(zip(self.rows, channels)):
+            ring.extend(samples, marks if row == 0 else ())
+
+    def refresh(self):
+        for _, _, item, curve, ring, marks in self.rows:
+            if ring.dirty:
+                ring.dirty = False
+                curve.setData(self.x, ring.y, connect="finite")
+                item.setYRange(*ring.y_range(), padding=0)
+                if marks is not None:
+                    shown = ~np.isnan(ring.marks)
+                    marks.setData(self.x[shown], ring.marks[shown])
+
+    def clear(self):
+        for _, _, _, _, ring, _ in self.rows:
+            ring.clear()
+        self.refresh()
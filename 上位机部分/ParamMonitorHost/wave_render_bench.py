@@ -0,0 +1,99 @@
+import argparse
+import os
+import sys
+import time
+
+from PyQt5.QtCore import QEventLoop, QTimer
+from PyQt5.QtWidgets import QApplication
+
+from latency_stats import percentile
+from monitor_core import SimulatedSource
+
+
+def run_backend(app, window, use_pyqtgraph, seconds):
+    """Run the real GUI timers on a simulated 250 Hz device and time each drawn frame.
+
+    A frame is what makes new samples visible: data_process() plus a synchronous
+    repaint of the wave labels on the QPixmap path, the fixed-rate refresh() plus a
+    repaint of the plots on the pyqtgraph path (packet ingest is timed separately).
+    """
+    window.clear_wave_screen()
+    window.actionWaveBackend.setChecked(use_pyqtgraph)
+    window.toggle_wave_backend(use_pyqtgraph)
+    window.core.source = SimulatedSource()
+    frames, ingest = [], []
+    labels = (window.ecg1WaveLabel, window.spo2WaveLabel, window.respWaveLabel)
+
+    def process():
+        start = time.perf_counter()
+        window.data_process()
+        if window.wave_backend is None:
+            for label in labels:
+                label.repaint()
+            frames.append((time.perf_counter() - start) * 1000)
+        else:
+            ingest.append((time.perf_counter() - start) * 1000)
+
+    def refresh():
+        start = time.perf_counter()
+        backend.refresh()
+        for plot in backend.widgets():
+            plot.repaint()
+        frames.append((time.perf_counter() - start) * 1000)
+
+    backend = window.wave_backend
+    window.procDataTimer.timeout.disconnect()
+    window.procDataTimer.timeout.connect(process)
+    if backend is not None:
+        backend.timer.timeout.disconnect()
+        backend.timer.timeout.connect(refresh)
+    window.serialPortTimer.start(2)
+    window.procDataTimer.start(10)
+    loop = QEventLoop()
+    QTimer.singleShot(int(seconds * 1000), loop.quit)
+    wall, cpu = time.perf_counter(), time.process_time()
+    loop.exec_()
+    wall, cpu = time.perf_counter() - wall, time.process_time() - cpu
+    window.serialPortTimer.stop()
+    window.procDataTimer.stop()
+    window.procDataTimer.timeout.disconnect()
+    window.procDataTimer.timeout.connect(window.data_process)
+    if backend is not None:
+        backend.timer.timeout.disconnect()
+        backend.timer.timeout.connect(backend.refresh)
+    return {"cpu": cpu / wall * 100, "fps": len(frames) / wall, "frames": frames, "ingest": ingest}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="波形绘制对比：QPixmap 扫描与 pyqtgraph 的 CPU 占用和每帧耗时")
+    parser.add_argument("--seconds", type=float, default=20.0, help="每种绘制方式的运行时长")
+    parser.add_argument("--size", default="1280x760", help="窗口尺寸 WxH")
+    args = parser.parse_args()
+
+    app = QApplication(sys.argv)
+    from ParamMonitor import ParamMonitor
+    from wave_pyqtgraph import AVAILABLE
+
+    window = ParamMonitor()
+    window.resize(*(int(v) for v in args.size.split("x")))
+    window.show()
+    app.processEvents()
+    window.finish_startup()
+    print(f"{os.environ.get('QT_QPA_PLATFORM', 'default')} platform, window {args.size}, {args.seconds:.0f} s per backend")
+    backends = [("QPixmap", False)] + ([("pyqtgraph", True)] if AVAILABLE else [])
+    for name, use_pyqtgraph in backends:
+        result = run_backend(app, window, use_pyqtgraph, args.seconds)
+        frames = result["frames"]
+        line = (f"  {name:<9} CPU {result['cpu']:5.1f}%  {result['fps']:5.1f} frames/s  frame ms p50 "
+                f"{percentile(frames, 0.5):.2f} p99 {percentile(frames, 0.99):.2f} max {max(frames, default=0):.2f}")
+        if result["ingest"]:
+            line += f"  ingest ms p50 {percentile(result['ingest'], 0.5):.3f}"
+        print(line)
+    if not AVAILABLE:
+        print("  pyqtgraph 未安装，只测量了 QPixmap 路径")
+    window.trend_store.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -19,6 +19,7 @@
 *********************************************************************************************************/
 #include "SysTick.h"
 #include "stm32f10x_conf.h"
+#include "Timer.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -31,33 +32,14 @@
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
-static  __IO  u32 s_iTimDelayCnt = 0;   //ʱs_iTimDelayCntĳʼֵΪ0
 
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
-static  void TimDelayDec(void); //ʱ
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
-/*********************************************************************************************************
-* ƣTimDelayDec
-* ܣʱ  
-* void
-* void
-*   ֵvoid
-* ڣ20180101
-* ע    ⣺SysTickжϷSysTick_Handlerе
-*********************************************************************************************************/
-static  void TimDelayDec(void)
-{
-  if(s_iTimDelayCnt != 0) //ʱֵΪ0
-  {                       
-    s_iTimDelayCnt--;     //ʱֵ1
-  }
-}
-
 /*********************************************************************************************************
 * ƣSysTick_Handler
 * ܣSysTickжϷ 
@@ -65,11 +47,11 @@ static  void TimDelayDec(void)
 * void
 *   ֵvoid
 * ڣ20180101
-* ע    ⣺
+* ע    ⣺ϵͳΨһ1msжϣʱʱTimerģʱִ
 *********************************************************************************************************/
 void  SysTick_Handler(void)
 {
-  TimDelayDec();  //ʱ
+  TimerTick();
 }
 
 /*********************************************************************************************************
@@ -86,6 +68,7 @@ void  SysTick_Handler(void)
 *           SystemCoreClock / 4000      0.25msжһΣ4000Ϊ1sÿһλ1/4000s=0.25ms
 *           SystemCoreClock / 100000    10usжһΣ100000Ϊ1sÿһλ1/100000s=10us
 *           SystemCoreClock / 1000000   1usжһΣ1000000Ϊ1sÿһλ1/1000000s=1us
+*           жϳеSPO2 LEDʱȼԭTIM2ͬռȼ0ȼ3
 *********************************************************************************************************/
 void InitSysTick( void )
 {
@@ -96,6 +79,8 @@ void InitSysTick( void )
       
     }
   }
+
+  NVIC_SetPriority(SysTick_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0, 3));
 }
 
 /*********************************************************************************************************
@@ -105,13 +90,13 @@ void InitSysTick( void )
 * void
 *   ֵvoid
 * ڣ20180101
-* ע    ⣺
+* ע    ⣺1msļʱʵʱnms-1nms֮䣬ڽже
 *********************************************************************************************************/
 void  DelayNms(__IO u32 nms)
 {
-  s_iTimDelayCnt = nms;       //ʱs_iTimDelayCntֵΪnms
+  u32 start = GetTimeCounter(); //ʼ
                               
-  while(s_iTimDelayCnt != 0)  //ʱֵΪ0ʱʾʱnmswhile
+  while(GetTimeCounter() - start < nms)
   {  
     
   }    
@@ -141,3 +126,35 @@ void  DelayNus(__IO u32 nus)
     s_iTimCnt--;           //ɹʱ1uss_iTimCnt1
   }    
 }
+
+/*********************************************************************************************************
+* ƣGetSysTickUs
+* ܣȡSysTick΢
+* void
+* void
+*   ֵ΢Լ71ӻһ
+* ڣ20261017
+* ע    ⣺1msļSysTickǰֵϳɣڼ䷢жʱض
+*           жϱʱװļδ1ʱSysTickжϹضǰֵ1ms
+*           CTRLCOUNTFLAGñ־
+*********************************************************************************************************/
+u32   GetSysTickUs(void)
+{
+  u32 ms;   //ļ
+  u32 val;  //SysTickǰֵ¼
+
+  do
+  {
+    ms  = GetTimeCounter();
+    val = SysTick->VAL;
+  }while(ms != GetTimeCounter());
+
+  //λλ˵װѾضĵǰֵһװ֮
+  if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+  {
+    val = SysTick->VAL;
+    ms++;
+  }
+
+  return ms * 1000 + (SysTick->LOAD - val) / (SystemCoreClock / 1000000);
+}
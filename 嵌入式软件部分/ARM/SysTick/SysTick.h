@@ -36,5 +36,6 @@
 void  InitSysTick(void);      //ʼSysTickģ
 void  DelayNus(__IO u32 nus); //΢뼶ʱ
 void  DelayNms(__IO u32 nms); //뼶ʱ
+u32   GetSysTickUs(void);      //SysTick΢
  
 #endif
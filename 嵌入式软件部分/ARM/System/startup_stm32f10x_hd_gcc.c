@@ -0,0 +1,241 @@
+/*********************************************************************************************************
+* 模块名称：startup_stm32f10x_hd_gcc.c
+* 文件说明：STM32F10x 大容量产品 GCC 启动文件
+*           向量表与 startup_stm32f10x_hd.s 一致，复位后搬运 .data、清零 .bss，调用 SystemInit 后进入 main
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：仅用于 arm-none-eabi-gcc 构建，Keil 工程仍使用 startup_stm32f10x_hd.s；
+*           栈、堆大小由 stm32f103rc_flash.ld 定义，与 .s 文件保持一致（0x400/0x200）
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "stm32f10x.h"
+
+/*********************************************************************************************************
+*                                           外部符号
+*********************************************************************************************************/
+extern u32 _sidata;   // .data 在 Flash 中的加载地址
+extern u32 _sdata;
+extern u32 _edata;
+extern u32 _sbss;
+extern u32 _ebss;
+extern u32 _estack;
+
+extern int  main(void);
+extern void __libc_init_array(void);
+
+/*********************************************************************************************************
+*                                           内部函数声明
+*********************************************************************************************************/
+void Reset_Handler(void);
+void Default_Handler(void);
+
+#define WEAK_HANDLER(name)  void name(void) __attribute__((weak, alias("Default_Handler")))
+
+WEAK_HANDLER(NMI_Handler);
+WEAK_HANDLER(HardFault_Handler);
+WEAK_HANDLER(MemManage_Handler);
+WEAK_HANDLER(BusFault_Handler);
+WEAK_HANDLER(UsageFault_Handler);
+WEAK_HANDLER(SVC_Handler);
+WEAK_HANDLER(DebugMon_Handler);
+WEAK_HANDLER(PendSV_Handler);
+WEAK_HANDLER(SysTick_Handler);
+
+WEAK_HANDLER(WWDG_IRQHandler);
+WEAK_HANDLER(PVD_IRQHandler);
+WEAK_HANDLER(TAMPER_IRQHandler);
+WEAK_HANDLER(RTC_IRQHandler);
+WEAK_HANDLER(FLASH_IRQHandler);
+WEAK_HANDLER(RCC_IRQHandler);
+WEAK_HANDLER(EXTI0_IRQHandler);
+WEAK_HANDLER(EXTI1_IRQHandler);
+WEAK_HANDLER(EXTI2_IRQHandler);
+WEAK_HANDLER(EXTI3_IRQHandler);
+WEAK_HANDLER(EXTI4_IRQHandler);
+WEAK_HANDLER(DMA1_Channel1_IRQHandler);
+WEAK_HANDLER(DMA1_Channel2_IRQHandler);
+WEAK_HANDLER(DMA1_Channel3_IRQHandler);
+WEAK_HANDLER(DMA1_Channel4_IRQHandler);
+WEAK_HANDLER(DMA1_Channel5_IRQHandler);
+WEAK_HANDLER(DMA1_Channel6_IRQHandler);
+WEAK_HANDLER(DMA1_Channel7_IRQHandler);
+WEAK_HANDLER(ADC1_2_IRQHandler);
+WEAK_HANDLER(USB_HP_CAN1_TX_IRQHandler);
+WEAK_HANDLER(USB_LP_CAN1_RX0_IRQHandler);
+WEAK_HANDLER(CAN1_RX1_IRQHandler);
+WEAK_HANDLER(CAN1_SCE_IRQHandler);
+WEAK_HANDLER(EXTI9_5_IRQHandler);
+WEAK_HANDLER(TIM1_BRK_IRQHandler);
+WEAK_HANDLER(TIM1_UP_IRQHandler);
+WEAK_HANDLER(TIM1_TRG_COM_IRQHandler);
+WEAK_HANDLER(TIM1_CC_IRQHandler);
+WEAK_HANDLER(TIM2_IRQHandler);
+WEAK_HANDLER(TIM3_IRQHandler);
+WEAK_HANDLER(TIM4_IRQHandler);
+WEAK_HANDLER(I2C1_EV_IRQHandler);
+WEAK_HANDLER(I2C1_ER_IRQHandler);
+WEAK_HANDLER(I2C2_EV_IRQHandler);
+WEAK_HANDLER(I2C2_ER_IRQHandler);
+WEAK_HANDLER(SPI1_IRQHandler);
+WEAK_HANDLER(SPI2_IRQHandler);
+WEAK_HANDLER(USART1_IRQHandler);
+WEAK_HANDLER(USART2_IRQHandler);
+WEAK_HANDLER(USART3_IRQHandler);
+WEAK_HANDLER(EXTI15_10_IRQHandler);
+WEAK_HANDLER(RTCAlarm_IRQHandler);
+WEAK_HANDLER(USBWakeUp_IRQHandler);
+WEAK_HANDLER(TIM8_BRK_IRQHandler);
+WEAK_HANDLER(TIM8_UP_IRQHandler);
+WEAK_HANDLER(TIM8_TRG_COM_IRQHandler);
+WEAK_HANDLER(TIM8_CC_IRQHandler);
+WEAK_HANDLER(ADC3_IRQHandler);
+WEAK_HANDLER(FSMC_IRQHandler);
+WEAK_HANDLER(SDIO_IRQHandler);
+WEAK_HANDLER(TIM5_IRQHandler);
+WEAK_HANDLER(SPI3_IRQHandler);
+WEAK_HANDLER(UART4_IRQHandler);
+WEAK_HANDLER(UART5_IRQHandler);
+WEAK_HANDLER(TIM6_IRQHandler);
+WEAK_HANDLER(TIM7_IRQHandler);
+WEAK_HANDLER(DMA2_Channel1_IRQHandler);
+WEAK_HANDLER(DMA2_Channel2_IRQHandler);
+WEAK_HANDLER(DMA2_Channel3_IRQHandler);
+WEAK_HANDLER(DMA2_Channel4_5_IRQHandler);
+
+/*********************************************************************************************************
+*                                           向量表
+*********************************************************************************************************/
+__attribute__((section(".isr_vector"), used))
+static void (* const s_arrVectors[])(void) =
+{
+  (void (*)(void))&_estack,
+  Reset_Handler,
+  NMI_Handler,
+  HardFault_Handler,
+  MemManage_Handler,
+  BusFault_Handler,
+  UsageFault_Handler,
+  0, 0, 0, 0,
+  SVC_Handler,
+  DebugMon_Handler,
+  0,
+  PendSV_Handler,
+  SysTick_Handler,
+
+  WWDG_IRQHandler,
+  PVD_IRQHandler,
+  TAMPER_IRQHandler,
+  RTC_IRQHandler,
+  FLASH_IRQHandler,
+  RCC_IRQHandler,
+  EXTI0_IRQHandler,
+  EXTI1_IRQHandler,
+  EXTI2_IRQHandler,
+  EXTI3_IRQHandler,
+  EXTI4_IRQHandler,
+  DMA1_Channel1_IRQHandler,
+  DMA1_Channel2_IRQHandler,
+  DMA1_Channel3_IRQHandler,
+  DMA1_Channel4_IRQHandler,
+  DMA1_Channel5_IRQHandler,
+  DMA1_Channel6_IRQHandler,
+  DMA1_Channel7_IRQHandler,
+  ADC1_2_IRQHandler,
+  USB_HP_CAN1_TX_IRQHandler,
+  USB_LP_CAN1_RX0_IRQHandler,
+  CAN1_RX1_IRQHandler,
+  CAN1_SCE_IRQHandler,
+  EXTI9_5_IRQHandler,
+  TIM1_BRK_IRQHandler,
+  TIM1_UP_IRQHandler,
+  TIM1_TRG_COM_IRQHandler,
+  TIM1_CC_IRQHandler,
+  TIM2_IRQHandler,
+  TIM3_IRQHandler,
+  TIM4_IRQHandler,
+  I2C1_EV_IRQHandler,
+  I2C1_ER_IRQHandler,
+  I2C2_EV_IRQHandler,
+  I2C2_ER_IRQHandler,
+  SPI1_IRQHandler,
+  SPI2_IRQHandler,
+  USART1_IRQHandler,
+  USART2_IRQHandler,
+  USART3_IRQHandler,
+  EXTI15_10_IRQHandler,
+  RTCAlarm_IRQHandler,
+  USBWakeUp_IRQHandler,
+  TIM8_BRK_IRQHandler,
+  TIM8_UP_IRQHandler,
+  TIM8_TRG_COM_IRQHandler,
+  TIM8_CC_IRQHandler,
+  ADC3_IRQHandler,
+  FSMC_IRQHandler,
+  SDIO_IRQHandler,
+  TIM5_IRQHandler,
+  SPI3_IRQHandler,
+  UART4_IRQHandler,
+  UART5_IRQHandler,
+  TIM6_IRQHandler,
+  TIM7_IRQHandler,
+  DMA2_Channel1_IRQHandler,
+  DMA2_Channel2_IRQHandler,
+  DMA2_Channel3_IRQHandler,
+  DMA2_Channel4_5_IRQHandler
+};
+
+/*********************************************************************************************************
+*                                           函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：Reset_Handler
+* 函数功能：复位入口
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：与 .s 版本相同，先调用 SystemInit 再进入 C 运行环境
+*********************************************************************************************************/
+void Reset_Handler(void)
+{
+  u32 *pSrc = &_sidata;
+  u32 *pDst = &_sdata;
+
+  while(pDst < &_edata)
+  {
+    *pDst++ = *pSrc++;
+  }
+
+  for(pDst = &_sbss; pDst < &_ebss; pDst++)
+  {
+    *pDst = 0;
+  }
+
+  SystemInit();
+  __libc_init_array();
+  main();
+
+  while(1)
+  {
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：Default_Handler
+* 函数功能：未实现的中断入口
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：与 .s 版本的 B . 行为一致
+*********************************************************************************************************/
+void Default_Handler(void)
+{
+  while(1)
+  {
+  }
+}
@@ -0,0 +1,207 @@
+/*********************************************************************************************************
+* ģƣBeatEvent.c
+* ļ˵Ĳ//¼ʵ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ2026-10-17
+* עֻȡֵıģ˲//ʼ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           ͷļ
+*********************************************************************************************************/
+#include "BeatEvent.h"
+
+/*********************************************************************************************************
+*                                           궨
+*********************************************************************************************************/
+#define AMP_FULL_DEV      0.3   // Էƫ1ֵʱȵ÷Ϊ
+#define AMP_ZERO_DEV      1.0   // Էƫ1ﵽֵʱȵ÷Ϊ0
+#define INTERVAL_FULL_DEV 0.1   // ƫƽֵñʱڵ÷Ϊ
+#define INTERVAL_ZERO_DEV 0.6   // ƫƽֵﵽñʱڵ÷Ϊ0
+#define INTERVAL_UNKNOWN  50    // ûƽʱļڵ÷
+#define INTERVAL_AVG_DIV  8     // ƽÿ¼ڿ 1/8
+
+/*********************************************************************************************************
+*                                           ڲ
+*********************************************************************************************************/
+static u8   Score(double dev, double fullDev, double zeroDev);  // ƫΪ0100ĵ÷
+static void Confirm(StructBeatEvent* pEvent, u32 sampleIdx, double waveMin, double peak2peak); // ȷϷ嶥
+
+/*********************************************************************************************************
+*                                           ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣScore
+* ܣƫfullDev100ﵽzeroDev0
+* dev-ƫǸfullDevzeroDev-ֵƫ
+* void
+*   ֵ0100
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+static u8 Score(double dev, double fullDev, double zeroDev)
+{
+  if(dev <= fullDev)
+  {
+    return 100;
+  }
+  if(dev >= zeroDev)
+  {
+    return 0;
+  }
+  return (u8)(100.0 * (zeroDev - dev) / (zeroDev - fullDev));
+}
+
+/*********************************************************************************************************
+* ƣConfirm
+* ܣȷϷ嶥ԷȺŶȲƽ
+* pEvent-¼sampleIdx-ǰţwaveMin/peak2peak-һڵСֵͷֵ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ŶΪȵ÷ڵ÷֮һ¼ûмڣڵ÷ȡ INTERVAL_UNKNOWN
+*********************************************************************************************************/
+static void Confirm(StructBeatEvent* pEvent, u32 sampleIdx, double waveMin, double peak2peak)
+{
+  double ratio = 0;
+  double dev;
+  u32    interval;
+  u8     ampScore;
+  u8     intervalScore = INTERVAL_UNKNOWN;
+
+  if(peak2peak > 0)
+  {
+    ratio = (pEvent->peakVal - waveMin) / peak2peak;
+  }
+  if(ratio < 0)
+  {
+    ratio = 0;
+  }
+  dev      = (ratio > 1.0) ? (ratio - 1.0) : (1.0 - ratio);
+  ampScore = Score(dev, AMP_FULL_DEV, AMP_ZERO_DEV);
+
+  if(pEvent->lastIdx != 0)
+  {
+    interval = pEvent->peakIdx - pEvent->lastIdx;
+    if(pEvent->avgInterval == 0)
+    {
+      pEvent->avgInterval = interval;
+    }
+    else
+    {
+      dev = ((double)interval - (double)pEvent->avgInterval) / (double)pEvent->avgInterval;
+      intervalScore = Score((dev < 0) ? -dev : dev, INTERVAL_FULL_DEV, INTERVAL_ZERO_DEV);
+      pEvent->avgInterval = (u32)((i32)pEvent->avgInterval + (((i32)interval - (i32)pEvent->avgInterval) / INTERVAL_AVG_DIV));
+    }
+  }
+
+  pEvent->sampleIdx  = pEvent->peakIdx;
+  pEvent->confirmIdx = sampleIdx;
+  pEvent->amplitude  = (ratio >= 2.55) ? 255 : (u8)(ratio * 100.0);
+  pEvent->confidence = (u8)((u16)ampScore * intervalScore / 100);
+  pEvent->ready      = TRUE;
+  pEvent->lastIdx    = pEvent->peakIdx;
+  pEvent->armed      = FALSE;
+}
+
+/*********************************************************************************************************
+*                                           APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣInitBeatEvent
+* ܣ¼״̬ƽ
+* pEvent-¼maxWait-кĲ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ɸģ Init 
+*********************************************************************************************************/
+void InitBeatEvent(StructBeatEvent* pEvent, u16 maxWait)
+{
+  pEvent->sampleIdx   = 0;
+  pEvent->confirmIdx  = 0;
+  pEvent->amplitude   = 0;
+  pEvent->confidence  = 0;
+  pEvent->ready       = FALSE;
+  pEvent->armed       = FALSE;
+  pEvent->maxWait     = maxWait;
+  pEvent->waitCnt     = 0;
+  pEvent->peakVal     = 0;
+  pEvent->peakIdx     = 0;
+  pEvent->lastIdx     = 0;
+  pEvent->avgInterval = 0;
+}
+
+/*********************************************************************************************************
+* ƣBeatEventArm
+* ܣ⵽Уӵǰʼ沨ҷ嶥
+* pEvent-¼value-ǰֵsampleIdx-ǰ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺һιδȷʱ¿ʼ
+*********************************************************************************************************/
+void BeatEventArm(StructBeatEvent* pEvent, double value, u32 sampleIdx)
+{
+  pEvent->armed   = TRUE;
+  pEvent->waitCnt = 0;
+  pEvent->peakVal = value;
+  pEvent->peakIdx = sampleIdx;
+}
+
+/*********************************************************************************************************
+* ƣBeatEventTrack
+* ܣһοʼ½򳬹 maxWait ʱȷϷ嶥
+* pEvent-¼value-ǰֵsampleIdx-ǰţ
+*           waveMin/peak2peak-һڵСֵͷֵԷ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺δʱֱӷأģڹм֮ǰãеĲ
+*********************************************************************************************************/
+void BeatEventTrack(StructBeatEvent* pEvent, double value, u32 sampleIdx, double waveMin, double peak2peak)
+{
+  if(!pEvent->armed)
+  {
+    return;
+  }
+
+  if(value > pEvent->peakVal)
+  {
+    pEvent->peakVal = value;
+    pEvent->peakIdx = sampleIdx;
+  }
+  else if(value < pEvent->peakVal)
+  {
+    Confirm(pEvent, sampleIdx, waveMin, peak2peak);
+    return;
+  }
+
+  pEvent->waitCnt++;
+  if(pEvent->waitCnt >= pEvent->maxWait)
+  {
+    Confirm(pEvent, sampleIdx, waveMin, peak2peak);
+  }
+}
+
+/*********************************************************************************************************
+* ƣBeatEventGet
+* ܣȡȷϵ¼
+* pEvent-¼
+* pOut-¼ʹ sampleIdxconfirmIdxamplitudeconfidence
+*   ֵTRUE-¼FALSE-û
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+u8 BeatEventGet(StructBeatEvent* pEvent, StructBeatEvent* pOut)
+{
+  if(!pEvent->ready)
+  {
+    return FALSE;
+  }
+
+  *pOut = *pEvent;
+  pEvent->ready = FALSE;
+  return TRUE;
+}
@@ -0,0 +1,47 @@
+/*********************************************************************************************************
+* ģƣBeatEvent.h
+* ļ˵Ĳ//¼
+*           ECGRESPSPO2 ڹм⴦ BeatEventArm֮ÿ BeatEventTrack 沨ε嶥
+*           嶥ȷϺһ¼嶥šԷȺŶȣѭȡߺϱ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ2026-10-17
+* עÿģֻһδȡߵ¼ʱÿȷһ¼ᶪʧ
+*********************************************************************************************************/
+#ifndef _BEAT_EVENT_H_
+#define _BEAT_EVENT_H_
+
+/*********************************************************************************************************
+*                                           ͷļ
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                           öٽṹ嶨
+*********************************************************************************************************/
+typedef struct
+{
+  u32    sampleIdx;     // 嶥ĲţģѴĲ
+  u32    confirmIdx;    // ȷϷ嶥ʱĲţ¼ڸòĲΰ֮󷢳
+  u8     amplitude;     // 嶥һСֵĸ߶ȣռڷֵİٷֱȣ255
+  u8     confidence;    // Ŷ0100ԷȺƽڵƫó
+  u8     ready;         // δȡߵ¼
+
+  u8     armed;         // ѹУڸ沨ҷ嶥
+  u16    maxWait;       // кĲʱҵֵȷ
+  u16    waitCnt;       // кѸĲ
+  double peakVal;       // ֵ
+  u32    peakIdx;       // ֵڲ
+  u32    lastIdx;       // һ¼ķ嶥ţ0ʾû¼
+  u32    avgInterval;   // ¼ڵĻƽ0ʾûм
+}StructBeatEvent;
+
+/*********************************************************************************************************
+*                                           API
+*********************************************************************************************************/
+void  InitBeatEvent(StructBeatEvent* pEvent, u16 maxWait);                //¼״̬
+void  BeatEventArm(StructBeatEvent* pEvent, double value, u32 sampleIdx); //Уʼ
+void  BeatEventTrack(StructBeatEvent* pEvent, double value, u32 sampleIdx, double waveMin, double peak2peak); //һ
+u8    BeatEventGet(StructBeatEvent* pEvent, StructBeatEvent* pOut);       //ȡ¼û¼FALSE
+
+#endif
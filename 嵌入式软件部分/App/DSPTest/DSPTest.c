@@ -0,0 +1,256 @@
+/*********************************************************************************************************
+* ģƣDSPTest.c
+* ļ˵Ӳڻģʽʵ
+*           ProcHostCmd յ MODULE_TEST ñģ飻֡黺壬ε
+*           ECGProcessBlockRESPProcessBlockSPO2ProcessBlock DWT ڼֱʱ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ2026-10-17
+* עÿһ͵ȴÿ SPO2 ڰ鴦ڼ䴮ûݣնв
+*           ڼ䷢ SysTickUART жϣSPO2 LED ʱУԼռٷ֮
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           ͷļ
+*********************************************************************************************************/
+#include "DSPTest.h"
+#include "stm32f10x.h"
+#include "PackUnpack.h"
+#include "SendDataToHost.h"
+#include "ECG.h"
+#include "RESP.h"
+#include "SPO2.h"
+
+/*********************************************************************************************************
+*                                           궨
+*********************************************************************************************************/
+#if defined(BENCH_HAL)
+#define CYCLE_COUNT()   0u                              // û DWTֻ֤Э
+#else
+#define DWT_CTRL        (*(volatile u32*)0xE0001000)    // DWT
+#define DWT_CYCCNT      (*(volatile u32*)0xE0001004)    // DWTڼ
+#define CYCLE_COUNT()   DWT_CYCCNT
+#endif
+
+/*********************************************************************************************************
+*                                           ڲ
+*********************************************************************************************************/
+static u8  s_iActive   = FALSE;   // ģʽ
+static u8  s_iBlockLen = 1;       // 鳤
+static u8  s_iFrameCnt = 0;       // ǰյ֡
+
+static u16 s_arrECGIn[DSP_TEST_MAX_BLOCK];    // ע ECG 
+static u16 s_arrRESPIn[DSP_TEST_MAX_BLOCK];   // ע RESP 
+static u16 s_arrREDIn[DSP_TEST_MAX_BLOCK];    // עĺ
+static u16 s_arrIRIn[DSP_TEST_MAX_BLOCK];     // עĺ
+static i16 s_arrECGOut[DSP_TEST_MAX_BLOCK];   // ECG 
+static i16 s_arrRESPOut[DSP_TEST_MAX_BLOCK];  // RESP 
+static i16 s_arrSPO2Out[DSP_TEST_MAX_BLOCK];  // SPO2 
+
+/*********************************************************************************************************
+*                                           ڲ
+*********************************************************************************************************/
+static void ResetDSP(void);                        // ·㷨ָϵ״̬
+static void RunBlock(void);                        // һ鲢ؽ
+static void SendCycles(u8 module, u32 cycles);     // һģĿ鴦
+
+/*********************************************************************************************************
+*                                           ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣResetDSP
+* ܣ³ʼ·㷨ʹԴϵͬ״̬ʼ
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺οlibTriVitalDSPͬӳʼ״̬ʼλȶԡ
+*           ֻλ㷨״̬GPIOEXTI0Ӳñϵʱ
+*********************************************************************************************************/
+static void ResetDSP(void)
+{
+  ResetECGState();
+  InitRESP();
+  ResetSPO2State();
+  s_iFrameCnt = 0;
+}
+
+/*********************************************************************************************************
+* ƣSendCycles
+* ܣһģ鴦һõ
+* module-0 ECG1 RESP2 SPO2cycles-
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+static void SendCycles(u8 module, u32 cycles)
+{
+  u8 arrData[PACK_DATA_LEN];
+
+  arrData[0] = module;
+  arrData[1] = s_iBlockLen;
+  arrData[2] = (u8)(cycles >> 24);
+  arrData[3] = (u8)(cycles >> 16);
+  arrData[4] = (u8)(cycles >> 8);
+  arrData[5] = (u8)cycles;
+  SendTestPackHost(DAT_TEST_CYCLES, arrData);
+}
+
+/*********************************************************************************************************
+* ƣRunBlock
+* ܣÿ鴦ӿڴһעĲظĩ͸ģ
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ֻ鴦üʱͷͲ
+*********************************************************************************************************/
+static void RunBlock(void)
+{
+  u8  arrData[PACK_DATA_LEN];
+  u32 arrCycles[3];
+  u32 start;
+  u16 value;
+  u8  i;
+
+  start = CYCLE_COUNT();
+  ECGProcessBlock(s_arrECGIn, s_arrECGOut, s_iBlockLen);
+  arrCycles[0] = CYCLE_COUNT() - start;
+
+  start = CYCLE_COUNT();
+  RESPProcessBlock(s_arrRESPIn, s_arrRESPOut, s_iBlockLen);
+  arrCycles[1] = CYCLE_COUNT() - start;
+
+  start = CYCLE_COUNT();
+  SPO2ProcessBlock(s_arrREDIn, s_arrIRIn, s_arrSPO2Out, s_iBlockLen);
+  arrCycles[2] = CYCLE_COUNT() - start;
+
+  for(i = 0; i < s_iBlockLen; i++)
+  {
+    arrData[0] = (u8)((u16)s_arrECGOut[i] >> 8);
+    arrData[1] = (u8)s_arrECGOut[i];
+    arrData[2] = (u8)((u16)s_arrRESPOut[i] >> 8);
+    arrData[3] = (u8)s_arrRESPOut[i];
+    arrData[4] = (u8)((u16)s_arrSPO2Out[i] >> 8);
+    arrData[5] = (u8)s_arrSPO2Out[i];
+    SendTestPackHost(DAT_TEST_WAVE, arrData);
+  }
+
+  value = ECGGetHeartRate();
+  arrData[0] = (u8)(value >> 8);
+  arrData[1] = (u8)value;
+  value = RESPGetRespRate();
+  arrData[2] = (u8)(value >> 8);
+  arrData[3] = (u8)value;
+  value = SPO2GetSPO2Value();
+  arrData[4] = (u8)(value >> 8);
+  arrData[5] = (u8)value;
+  SendTestPackHost(DAT_TEST_PARAM, arrData);
+
+  for(i = 0; i < 3; i++)
+  {
+    SendCycles(i, arrCycles[i]);
+  }
+
+  s_iFrameCnt = 0;
+}
+
+/*********************************************************************************************************
+*                                           APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣInitDSPTest
+* ܣʼDSPTestģ
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+void InitDSPTest(void)
+{
+  s_iActive   = FALSE;
+  s_iBlockLen = 1;
+  s_iFrameCnt = 0;
+}
+
+/*********************************************************************************************************
+* ƣDSPTestIsActive
+* ܣѯǷڲģʽ
+* void
+* void
+*   ֵTRUE-ģʽFALSE-ɼ
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+u8 DSPTestIsActive(void)
+{
+  return s_iActive;
+}
+
+/*********************************************************************************************************
+* ƣDSPTestStart
+* ܣģʽ³ʼ DSP ģ鲢 DWT ڼ
+* blockLen-鳤1DSP_TEST_MAX_BLOCK
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺鳤 ProcHostCmd 飻ڲģʽʱ൱¿鳤¿ʼ
+*********************************************************************************************************/
+void DSPTestStart(u8 blockLen)
+{
+#if !defined(BENCH_HAL)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT_CTRL         |= 1;
+#endif
+
+  s_iActive   = TRUE;
+  s_iBlockLen = blockLen;
+  SPO2HoldDAC(TRUE);        // עĲܸıʵʵ LED 
+  ResetDSP();
+}
+
+/*********************************************************************************************************
+* ƣDSPTestStop
+* ܣ˳ģʽDSP ģ³ʼѭָ ADC ɼ
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺δһֱ֡ӶڼԶⲻд DAC˳ʱ DAC дΪֵ
+*********************************************************************************************************/
+void DSPTestStop(void)
+{
+  s_iActive = FALSE;
+  ResetDSP();
+  SPO2HoldDAC(FALSE);       // DAC дΪλĵֵָɼʱӲ㷨һ
+}
+
+/*********************************************************************************************************
+* ƣDSPTestPutFrame
+* ܣһ֡עĲһʱ
+* pData-CMD_TEST_FRAME  6 ݣECGRESPREDIR  12 λλǰ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ڲģʽʱ
+*********************************************************************************************************/
+void DSPTestPutFrame(const u8* pData)
+{
+  if(!s_iActive)
+  {
+    return;
+  }
+
+  s_arrECGIn[s_iFrameCnt]  = (u16)((pData[0] << 4) | (pData[1] >> 4));
+  s_arrRESPIn[s_iFrameCnt] = (u16)(((pData[1] & 0x0F) << 8) | pData[2]);
+  s_arrREDIn[s_iFrameCnt]  = (u16)((pData[3] << 4) | (pData[4] >> 4));
+  s_arrIRIn[s_iFrameCnt]   = (u16)(((pData[4] & 0x0F) << 8) | pData[5]);
+  s_iFrameCnt++;
+
+  if(s_iFrameCnt >= s_iBlockLen)
+  {
+    RunBlock();
+  }
+}
@@ -0,0 +1,33 @@
+/*********************************************************************************************************
+* ģƣDSPTest.h
+* ļ˵Ӳڻģʽ
+*            UART1  ECG/RESP//֡λ ADCһÿ鴦ӿھ촦
+*           ÿ·ÿģĴͿʱĲʵολȶ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ2026-10-17
+* עЭ PackUnpack.h  MODULE_TEST˹Ϊ Bench/hil_bench.py
+*********************************************************************************************************/
+#ifndef _DSP_TEST_H_
+#define _DSP_TEST_H_
+
+/*********************************************************************************************************
+*                                           ͷļ
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                           궨
+*********************************************************************************************************/
+#define DSP_TEST_MAX_BLOCK  64  // 鳤ޣ TriVitalBench -b 鳤ͬ
+
+/*********************************************************************************************************
+*                                           API
+*********************************************************************************************************/
+void  InitDSPTest(void);                 //ʼDSPTestģ
+u8    DSPTestIsActive(void);             //Ƿڲģʽģʽѭ ADC 
+void  DSPTestStart(u8 blockLen);         //ģʽ³ʼ DSP ģ
+void  DSPTestStop(void);                 //˳ģʽ³ʼ DSP ģָɼ
+void  DSPTestPutFrame(const u8* pData);  //һ֡һʱؽ
+
+#endif
@@ -48,6 +48,22 @@ typedef long                LONG;
 //һ
 #define MAKEWORD(hwH, hwL)  ((WORD)(((HWORD)(hwL)) | ((WORD)((HWORD)(hwH))) << 16))
 
+//ȵ㺯˲⡢жϣGCC бΪ hotԴļ Os  CMakeLists.txt  -O2 룬Keil Ϊ
+#if defined(__GNUC__) && !defined(__CC_ARM)
+  #define HOT_FUNC    __attribute__((hot))
+#else
+  #define HOT_FUNC
+#endif
+
+//ǿ鴦ĺڵnumΪ1ʱѭͷֶжϱȥ
+#if defined(__CC_ARM)
+  #define FORCE_INLINE  __forceinline
+#elif defined(__GNUC__)
+  #define FORCE_INLINE  inline __attribute__((always_inline))
+#else
+  #define FORCE_INLINE
+#endif
+
 #define TRUE          1
 #define FALSE         0
 #define NULL          0
@@ -2,6 +2,7 @@
 * ģƣECG.c
 * ļ˵ĵ磨ECGźŴģ
 *           ʵ ECG ź˲R ⡢ʼ㡢״̬жϼʾ
+*            PB0  EXTI0 ˫жϼ⣬µ״̬ ECG_ZERO
 * ǰ汾1.0.0
 *     ߣChill
 * ڣ2026-04-16
@@ -17,6 +18,7 @@
 #include "UART1.h"
 #include "OLED.h"
 #include "Timer.h"
+#include "FastIO.h"
 
 /*********************************************************************************************************
 *                                           궨
@@ -25,6 +27,10 @@
 #define SmoothWindowsLen 8  // ƽ˲ڳ
 #define MedianWindowsLen 5  // ֵ˲ڳ
 #define HR_WAVE_LEN 600     // ֵ㴰ڳ
+#define HR_WARMUP_LEN 300   // ʱһֵڳȣ֮μӱ HR_WAVE_LEN
+#define ECG_SAMPLE_MS 4     // msProc2msTask ÿ 4ms һ
+#define ECG_LEAD_DEBOUNCE_MS 20 // ʱ䣨msغ뱣ָʱȷ
+#define ECG_QRS_MAX_WAIT 25     // R к 25 100msҷ嶥
 
 /*********************************************************************************************************
 *                                           ڲ
@@ -48,10 +54,29 @@ static double IIRHighpass_a[N+1] = {1.000000, -1.964461, 0.965081};
 // ʼر
 static double arr_ECG_Wave[HR_WAVE_LEN] = {0}; // ECG λ
 static int ECG_Wave_index = 0;                 // 
+static int ECG_Wave_len = HR_WARMUP_LEN;       // ǰֵڳ
 static double peakThreshold = 0;               // R ֵ
+static u8 thresholdReady = 0;                  // һֵڼǰ R 
+static u8 filterPrimed = 0;                    // ˲ѰһԤõ̬
 static u32 lastPeak_index = 0;                 // һ R ʱ
 static u32 currentPeak_index = 0;              // ǰ R ʱ
+static u32 ECG_Sample_cnt = 0;                 // ѴĲR ʱ㣬ʱ޹
 static int heartRate = 0;                      // ʣBPM
+static volatile u8 s_iLeadOn = 0;              // ĵ״̬0-䣬1-
+static double s_waveMin = 0;                   // һֵڵСֵ
+static double s_peak2peak = 0;                 // һֵڵķֵ
+static StructBeatEvent s_structQRS;            // R ¼
+
+// ƽֵ˲ֵ״̬ļԱ ResetECGState ȫ
+static double Smooth_buf[SmoothWindowsLen] = {0};
+static int Smooth_idx = 0;
+static int Smooth_count = 0;
+static double Smooth_sum = 0;
+static double Median_buf[MedianWindowsLen] = {0};
+static int Median_idx = 0;
+static int Rate_buf[5] = {0};
+static int Rate_idx = 0;
+static int Rate_count = 0;
 
 /*********************************************************************************************************
 *                                           ڲ
@@ -61,9 +86,13 @@ static int heartRate = 0;                      // 
  * ECG_ZERO  -- PB1  (Ӳ߿)
  */
 static void ConfigECGGPIO(void);
+static u8   ReadLeadPin(void);          // ȡ LEAD_OFF Ųͬ ECG_ZEROص״̬
+#if !defined(BENCH_HAL)
+static void ConfigLeadOffEXTI(void);    // PB0 Ϊ EXTI0 ˫ж
+static void LeadDebounceDone(void);     // ʱڣȷϵ״̬
+#endif
 
-static double IIRNotch(double input, double *arrtemp);		// 50HzƵݲ
-static double IIRHighpass(double input, double *arrtemp);	// 2IIRͨ˲
+static double IIRSteadyState(double input, double *arrtemp, double *a, double *b); // Ԥ˲̬
 static double SmoothingFilter(double newData);						// ƽ˲
 static double MedianFIlter(double newData);						    // ֵ˲
 
@@ -92,66 +121,103 @@ static void ConfigECGGPIO(void)
   GPIO_InitStructure.GPIO_Mode  = GPIO_Mode_Out_PP;
   GPIO_Init(GPIOB, &GPIO_InitStructure);
   GPIO_WriteBit(GPIOB, GPIO_Pin_1, Bit_SET);
+
+  s_iLeadOn = ReadLeadPin();
+
+#if !defined(BENCH_HAL)
+  ConfigLeadOffEXTI();
+#endif
 }
 
 /*********************************************************************************************************
-* ƣ50HzƵݲ˲
-* ܣ50HzƵ
+* ƣȡ
+* ܣȡ LEAD_OFF ţʱλ ECG_ZERO ʹӲ߹㣬ʱͷ
 * void
 * void
-*   ֵvoid
-* ڣ20260416
-* ע    ⣺
+*   ֵ0-䣬1-
+* ڣ20261017
+* ע    ⣺ԭ OLED_ECG ÿһ ECG_ZERO 1s δĲ
 *********************************************************************************************************/
-static double IIRNotch(double input, double *arrtemp)
+static u8 ReadLeadPin(void)
 {
-  double output = 0;
-  int i = 0;
-
-  arrtemp[0] = input
-             - IIRNotch_a[1] * arrtemp[1]
-             - IIRNotch_a[2] * arrtemp[2];
-
-  output = IIRNotch_b[0] * arrtemp[0]
-         + IIRNotch_b[1] * arrtemp[1]
-         + IIRNotch_b[2] * arrtemp[2];
-
-  for(i = N; i > 0; i--)
+  if(GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 1)
   {
-    arrtemp[i] = arrtemp[i - 1];
+    PinSet(GPIOB, GPIO_Pin_1);
+    return 0;
   }
 
-  return output;
+  PinClr(GPIOB, GPIO_Pin_1);
+  return 1;
 }
 
+#if !defined(BENCH_HAL)
 /*********************************************************************************************************
-* ƣ2IIRͨ˲
-* ܣźŽ2׸ͨ˲
+* ƣõж
+* ܣ PB0 ӳ䵽 EXTI0أ䣩½أָж
 * void
 * void
 *   ֵvoid
-* ڣ20260416
-* ע    ⣺
+* ڣ20261017
+* ע    ⣺ռȼ 2  SysTick0EXTI0_IRQHandler  AddTimer ʱʱֵı
 *********************************************************************************************************/
-static double IIRHighpass(double input, double *arrtemp)
+static void ConfigLeadOffEXTI(void)
 {
-  double output = 0;
-  int i = 0;
+  EXTI_InitTypeDef EXTI_InitStructure;
+  NVIC_InitTypeDef NVIC_InitStructure;
+
+  RCC_APB2PeriphClockCmd(RCC_APB2Periph_AFIO, ENABLE);
+  GPIO_EXTILineConfig(GPIO_PortSourceGPIOB, GPIO_PinSource0);
+
+  EXTI_InitStructure.EXTI_Line    = EXTI_Line0;
+  EXTI_InitStructure.EXTI_Mode    = EXTI_Mode_Interrupt;
+  EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising_Falling;
+  EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+  EXTI_Init(&EXTI_InitStructure);
+  EXTI_ClearITPendingBit(EXTI_Line0);
+
+  NVIC_InitStructure.NVIC_IRQChannel                   = EXTI0_IRQn;
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 2;
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority        = 0;
+  NVIC_InitStructure.NVIC_IRQChannelCmd                = ENABLE;
+  NVIC_Init(&NVIC_InitStructure);
+}
 
-  arrtemp[0] = input
-             - IIRHighpass_a[1] * arrtemp[1]
-             - IIRHighpass_a[2] * arrtemp[2];
+/*********************************************************************************************************
+* ƣ
+* ܣʱںȡţȷϵ״̬´ EXTI0
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ڽжִСλжٶţ֮ıػ´ᶪʧ
+*********************************************************************************************************/
+static void LeadDebounceDone(void)
+{
+  EXTI->PR   = EXTI_Line0;
+  EXTI->IMR |= EXTI_Line0;
+  s_iLeadOn  = ReadLeadPin();
+}
+#endif
 
-  output = IIRHighpass_b[0] * arrtemp[0]
-         + IIRHighpass_b[1] * arrtemp[1]
-         + IIRHighpass_b[2] * arrtemp[2];
+/*********************************************************************************************************
+* ƣԤIIR˲̬
+* ܣֱIIͶ׽ڵ״̬ΪΪ input ʱֵ̬
+* input-ֱ룬arrtemp-˲״̬a/b-ĸ/ϵ
+* arrtemp
+*   ֵ̬ input ֱ棬ֱԤһ
+* ڣ20261017
+* ע    ⣺ȫ״̬Լ 2000  ADC ֱƫ൱һԾ1Hz ͨҪ룻
+*           Ԥúһʹ̬
+*********************************************************************************************************/
+static double IIRSteadyState(double input, double *arrtemp, double *a, double *b)
+{
+  double w = input / (a[0] + a[1] + a[2]);
 
-  for(i = N; i > 0; i--)
-  {
-    arrtemp[i] = arrtemp[i - 1];
-  }
+  arrtemp[0] = w;
+  arrtemp[1] = w;
+  arrtemp[2] = w;
 
-  return output;
+  return (b[0] + b[1] + b[2]) * w;
 }
 
 /*********************************************************************************************************
@@ -163,23 +229,18 @@ static double IIRHighpass(double input, double *arrtemp)
 * ڣ20260416
 * ע    ⣺
 *********************************************************************************************************/
-static double SmoothingFilter(double newData)
+static HOT_FUNC double SmoothingFilter(double newData)
 {
-  static double buf[SmoothWindowsLen] = {0};
-  static int idx = 0;
-  static int count = 0;
-  static double sum = 0;
+  Smooth_sum -= Smooth_buf[Smooth_idx];
+  Smooth_buf[Smooth_idx] = newData;
+  Smooth_sum += newData;
 
-  sum -= buf[idx];
-  buf[idx] = newData;
-  sum += newData;
+  Smooth_idx++;
+  if(Smooth_idx >= SmoothWindowsLen) Smooth_idx = 0;
 
-  idx++;
-  if(idx >= SmoothWindowsLen) idx = 0;
+  if(Smooth_count < SmoothWindowsLen) Smooth_count++;
 
-  if(count < SmoothWindowsLen) count++;
-
-  return sum / count;
+  return Smooth_sum / Smooth_count;
 }
 
 /*********************************************************************************************************
@@ -191,21 +252,19 @@ static double SmoothingFilter(double newData)
 * ڣ20260416
 * ע    ⣺
 *********************************************************************************************************/
-static double MedianFIlter(double newData)
+static HOT_FUNC double MedianFIlter(double newData)
 {
-  static double buf[MedianWindowsLen] = {0};
-  static int idx = 0;
   int i = 0;
   int j = 0;
   double temp[MedianWindowsLen];
   
   // д뻷λ
-  buf[idx++] = newData;
-  if(idx >= MedianWindowsLen) idx = 0;
+  Median_buf[Median_idx++] = newData;
+  if(Median_idx >= MedianWindowsLen) Median_idx = 0;
 
   // һ
   for(i = 0; i < MedianWindowsLen; i++)
-    temp[i] = buf[i];
+    temp[i] = Median_buf[i];
 
   // ð
   for(i = 0; i < MedianWindowsLen - 1; i++)
@@ -234,7 +293,7 @@ static double MedianFIlter(double newData)
 * ڣ20260416
 * ע    ⣺
 *********************************************************************************************************/
-static void Update_Threshold(double *data_window, int windowSize, double *threshold_output)
+static HOT_FUNC void Update_Threshold(double *data_window, int windowSize, double *threshold_output)
 {
   int i;
   double peakMax = 0.0;
@@ -246,6 +305,8 @@ static void Update_Threshold(double *data_window, int windowSize, double *thresh
     if(data_window[i] < peakMin) peakMin = data_window[i];
   }
 
+  s_waveMin = peakMin;
+  s_peak2peak = peakMax - peakMin;
   *threshold_output = peakMax - (peakMax - peakMin) / 4;
 }
 
@@ -258,29 +319,26 @@ static void Update_Threshold(double *data_window, int windowSize, double *thresh
 * ڣ20260416
 * ע    ⣺
 *********************************************************************************************************/
-static void calRate(double ppdistance, int *rate_output)
+static HOT_FUNC void calRate(double ppdistance, int *rate_output)
 {
-  static int arrRates[5] = {0};
-  static int idx = 0;
-  static int count = 0;
   int temp[5];
   int i, j;
   int currentRate;
 
   currentRate = (int)(60000.0 / ppdistance);
-  arrRates[idx] = currentRate;
-  idx = (idx + 1) % 5;
+  Rate_buf[Rate_idx] = currentRate;
+  Rate_idx = (Rate_idx + 1) % 5;
   
-  if(count < 5) count++;
+  if(Rate_count < 5) Rate_count++;
 
-  for(i = 0; i < count; i++)
+  for(i = 0; i < Rate_count; i++)
   {
-    temp[i] = arrRates[i];
+    temp[i] = Rate_buf[i];
   }
 
-  for(i = 0; i < count - 1; i++)
+  for(i = 0; i < Rate_count - 1; i++)
   {
-    for(j = 0; j < count - 1 - i; j++)
+    for(j = 0; j < Rate_count - 1 - i; j++)
     {
       if(temp[j] > temp[j + 1])
       {
@@ -291,8 +349,8 @@ static void calRate(double ppdistance, int *rate_output)
     }
   }
 
-  // ȡλ
-  *rate_output = temp[2];
+  // ȡλ 5 ʱȡֵλһڼ
+  *rate_output = temp[(Rate_count - 1) / 2];
 }
 
 /*********************************************************************************************************
@@ -305,69 +363,181 @@ static void calRate(double ppdistance, int *rate_output)
 * void
 *   ֵvoid
 * ڣ20260416
-* ע    ⣺
+* ע    ⣺GPIOEXTI0ֻڴһ
 *********************************************************************************************************/
 void InitECG(void)
 {
   ConfigECGGPIO();
+  ResetECGState();
+}
 
+/*********************************************************************************************************
+* ƣResetECGState
+* ܣ㷨״ָ̬ϵ״̬
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺Ӳ͵״̬s_iLeadOnEXTI0еĵζʱճڣDSPTestģʽʱ
+*********************************************************************************************************/
+void ResetECGState(void)
+{
   memset(IIRNotch_win, 0, sizeof(IIRNotch_win));
   memset(IIRHighpass_win, 0, sizeof(IIRHighpass_win));
   memset(arr_ECG_Wave, 0, sizeof(arr_ECG_Wave));
 
   ECG_Wave_index = 0;
+  ECG_Wave_len = HR_WARMUP_LEN;
   peakThreshold = 0;
+  thresholdReady = 0;
+  filterPrimed = 0;
   lastPeak_index = 0;
   currentPeak_index = 0;
+  ECG_Sample_cnt = 0;
   heartRate = 0;
+
+  memset(Smooth_buf, 0, sizeof(Smooth_buf));
+  memset(Median_buf, 0, sizeof(Median_buf));
+  memset(Rate_buf, 0, sizeof(Rate_buf));
+  Smooth_idx = 0;
+  Smooth_count = 0;
+  Smooth_sum = 0;
+  Median_idx = 0;
+  Rate_idx = 0;
+  Rate_count = 0;
+
+  s_waveMin = 0;
+  s_peak2peak = 0;
+  InitBeatEvent(&s_structQRS, ECG_QRS_MAX_WAIT);
 }
 
-/*********************************************************************************************************
-* ƣECGʵʱ
-* ܣECGźŽʵʱ˲ƽʼ
-* void
-* void
-*   ֵvoid
-* ڣ20260416
-* ע    ⣺
-*********************************************************************************************************/
-/*
-  ƣECGʵʱ
-  ܣECGźŽʵʱ˲ƽʼ
-*/
-int ECGTask(u16 inp)
+/* 鴦ģECGProcessBlock  ECGTask ã ECGProcessBlock ˵ */
+static HOT_FUNC FORCE_INLINE void ECGBlock(const u16* pIn, i16* pOut, int num)
 {
-  double output1;
-  double output2;
-  double output3;
-  double output4;
-  
-  output1 = IIRNotch(inp, IIRNotch_win);
-  output2 = IIRHighpass(output1, IIRHighpass_win);
-  output3 = MedianFIlter(output2);
-  output4 = SmoothingFilter(output3);
-  
-  arr_ECG_Wave[ECG_Wave_index++] = output4;
+  const double na1 = IIRNotch_a[1], na2 = IIRNotch_a[2];
+  const double nb0 = IIRNotch_b[0], nb1 = IIRNotch_b[1], nb2 = IIRNotch_b[2];
+  const double ha1 = IIRHighpass_a[1], ha2 = IIRHighpass_a[2];
+  const double hb0 = IIRHighpass_b[0], hb1 = IIRHighpass_b[1], hb2 = IIRHighpass_b[2];
+  double n1 = IIRNotch_win[1], n2 = IIRNotch_win[2];        // ݲ״̬ w[n-1]w[n-2]
+  double h1 = IIRHighpass_win[1], h2 = IIRHighpass_win[2];  // ͨ״̬
+  double w;
+  double y;
+  int i = 0;
+  int end;
 
-  if(ECG_Wave_index >= HR_WAVE_LEN)
+  while(i < num)
   {
-    ECG_Wave_index = 0;
-    Update_Threshold(arr_ECG_Wave, HR_WAVE_LEN, &peakThreshold);
-  }
+    // ֵʱ
+    end = i + (ECG_Wave_len - ECG_Wave_index);
+    if(end > num) end = num;
 
-  // R ؼ
-  if((ECG_Wave_index > 1) && (ECG_Wave_index < HR_WAVE_LEN - 1))
-  {
-    if((arr_ECG_Wave[ECG_Wave_index - 2] <= peakThreshold) &&
-       (arr_ECG_Wave[ECG_Wave_index - 1] >= peakThreshold))
+    for(; i < end; i++)
     {
-      currentPeak_index = GetTimeCounter();
-      calRate(currentPeak_index - lastPeak_index, &heartRate);
-      lastPeak_index = currentPeak_index;
+      if(!filterPrimed && pIn[i] != 0)
+      {
+        IIRSteadyState(IIRSteadyState(pIn[i], IIRNotch_win, IIRNotch_a, IIRNotch_b),
+                       IIRHighpass_win, IIRHighpass_a, IIRHighpass_b);
+        n1 = IIRNotch_win[1];
+        n2 = IIRNotch_win[2];
+        h1 = IIRHighpass_win[1];
+        h2 = IIRHighpass_win[2];
+        filterPrimed = 1;
+      }
+
+      // 50Hz ݲ
+      w  = pIn[i] - na1 * n1 - na2 * n2;
+      y  = nb0 * w + nb1 * n1 + nb2 * n2;
+      n2 = n1;
+      n1 = w;
+
+      // 1Hz ͨ
+      w  = y - ha1 * h1 - ha2 * h2;
+      y  = hb0 * w + hb1 * h1 + hb2 * h2;
+      h2 = h1;
+      h1 = w;
+
+      y = SmoothingFilter(MedianFIlter(y));
+      pOut[i] = (i16)y;
+
+      arr_ECG_Wave[ECG_Wave_index++] = y;
+      ECG_Sample_cnt++;
+
+      if(s_structQRS.armed)
+      {
+        BeatEventTrack(&s_structQRS, y, ECG_Sample_cnt, s_waveMin, s_peak2peak);
+      }
+
+      // R ؼ⣬һֵº㣬
+      if(thresholdReady && (ECG_Wave_index > 1) && (ECG_Wave_index < ECG_Wave_len - 1))
+      {
+        if((arr_ECG_Wave[ECG_Wave_index - 2] <= peakThreshold) &&
+           (arr_ECG_Wave[ECG_Wave_index - 1] >= peakThreshold))
+        {
+          currentPeak_index = ECG_Sample_cnt * ECG_SAMPLE_MS;
+          if(lastPeak_index != 0)   // һ R ֻ¼ʱ䣬ûм
+          {
+            calRate(currentPeak_index - lastPeak_index, &heartRate);
+          }
+          lastPeak_index = currentPeak_index;
+          BeatEventArm(&s_structQRS, y, ECG_Sample_cnt);
+        }
+      }
+    }
+
+    if(ECG_Wave_index >= ECG_Wave_len)
+    {
+      Update_Threshold(arr_ECG_Wave, ECG_Wave_len, &peakThreshold);
+      ECG_Wave_index = 0;
+      thresholdReady = 1;
+      if(ECG_Wave_len < HR_WAVE_LEN)
+      {
+        ECG_Wave_len = (ECG_Wave_len * 2 < HR_WAVE_LEN) ? ECG_Wave_len * 2 : HR_WAVE_LEN;
+      }
     }
   }
 
-  return (int)output4;
+  IIRNotch_win[0] = n1;
+  IIRNotch_win[1] = n1;
+  IIRNotch_win[2] = n2;
+  IIRHighpass_win[0] = h1;
+  IIRHighpass_win[1] = h1;
+  IIRHighpass_win[2] = h2;
+}
+
+/*********************************************************************************************************
+* ƣECG鴦
+* ܣ num ݲֵͨƽֵº R 
+* pIn-ADC num-
+* pOut-˲ĲΣ ECGTask ķֵӦ
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ IIR ״̬ϵڿڱھֲУʱдأ
+*           ֵڷֶδжÿһζÿһΣ
+*           һʱԤ˲ֵ̬ڴ HR_WARMUP_LEN ʼμӱ
+*           һ R-R ڼʣֵ֮ 5 
+*           R ʱ䰴  ECG_SAMPLE_MS 㣬һһʱȻȷ
+*********************************************************************************************************/
+HOT_FUNC void ECGProcessBlock(const u16* pIn, i16* pOut, int num)
+{
+  ECGBlock(pIn, pOut, num);
+}
+
+/*********************************************************************************************************
+* ƣECGʵʱ
+* ܣһECG˲ƽʼ
+* inp-ADC 
+* void
+*   ֵ˲Ĳֵ
+* ڣ20260416
+* ע    ⣺ãȼ num Ϊ 1  ECGProcessBlock
+*********************************************************************************************************/
+HOT_FUNC int ECGTask(u16 inp)
+{
+  i16 out;
+
+  ECGBlock(&inp, &out, 1);
+
+  return out;
 }
 
 /*********************************************************************************************************
@@ -384,6 +554,20 @@ u16 ECGGetHeartRate(void)
   return heartRate;
 }
 
+/*********************************************************************************************************
+* ƣȡR¼
+* ܣȡһȷϵ R ¼
+* void
+* pEvent-R 嶥ĲšȷʱĲšԷȺŶ
+*   ֵTRUE-¼FALSE-û
+* ڣ20261017
+* ע    ⣺R عʱ⣬֮浽嶥 ECG_QRS_MAX_WAIT ȷ
+*********************************************************************************************************/
+u8 ECGGetBeatEvent(StructBeatEvent* pEvent)
+{
+  return BeatEventGet(&s_structQRS, pEvent);
+}
+
 /*********************************************************************************************************
 * ƣȡ״̬
 * ܣȡǰ״̬
@@ -391,15 +575,39 @@ u16 ECGGetHeartRate(void)
 * void
 *   ֵvoid
 * ڣ20260416
-* ע    ⣺0-䣬1-
+* ע    ⣺0-䣬1- EXTI0 ״̬ٶ
 *********************************************************************************************************/
 u8 ECGGetLeadStatus(void)
 {
-  u8 leadFlag;
-  leadFlag = (u8)(1 - (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0)));
-  return leadFlag;
+#if defined(BENCH_HAL)
+  s_iLeadOn = ReadLeadPin();  // ׼Թû EXTIֱӶ
+#endif
+  return s_iLeadOn;
 }
 
+#if !defined(BENCH_HAL)
+/*********************************************************************************************************
+* ƣEXTI0_IRQHandler
+* ܣűжϣ EXTI0 ʱ
+* void
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺Ŷڼ EXTI0 Σÿβֻռһζʱ
+*           ECG_LEAD_DEBOUNCE_MS  LeadDebounceDone ȡȶƽ
+*********************************************************************************************************/
+void EXTI0_IRQHandler(void)
+{
+  EXTI->IMR &= ~EXTI_Line0;
+  EXTI->PR   = EXTI_Line0;
+
+  if(AddTimer(ECG_LEAD_DEBOUNCE_MS, 0, LeadDebounceDone, 0) < 0)
+  {
+    LeadDebounceDone();     // ʱʱ֤©״̬仯
+  }
+}
+#endif
+
 /*********************************************************************************************************
 * ƣʾLED ECGģϢ
 * ܣLEDʾʾǰʡ״̬Ϣ
@@ -415,17 +623,15 @@ void OLED_ECG(void)
   OLEDShowString(64, 0, (u8*)"BPM");
   OLEDShowString(0, 16, (u8*)"ECG_LEAD:");
 
-  // 
-  if(GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 1)
+  // 䣬ECG_ZERO ʱ
+  if(!s_iLeadOn)
   {
-    GPIO_WriteBit(GPIOB, GPIO_Pin_1, Bit_SET);
     OLEDShowString(88, 16, (u8*)"Noob");
     OLEDShowString(32, 0, (u8*)"Err");
     // printf("[[1,Err]]\r\n");
   }
   else
   {
-    GPIO_WriteBit(GPIOB, GPIO_Pin_1, Bit_RESET);
     OLEDShowString(88, 16, (u8*)"Good");
 
     if(heartRate >= 20 && heartRate <= 250)
@@ -21,6 +21,7 @@
 *********************************************************************************************************/
 #include "DataType.h"
 #include "Main.h"
+#include "BeatEvent.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -35,8 +36,11 @@ extern WaveMode_t g_displayMode;
 *                                              API
 *********************************************************************************************************/
 void  InitECG(void);        //ʼECGģ
+void  ResetECGState(void);  //㷨״ָ̬ϵ״̬Ӳ
+void  ECGProcessBlock(const u16* pIn, i16* pOut, int num); //num
 int   ECGTask(u16 inp);     //ECGʵʱ
 u16   ECGGetHeartRate(void);   //ȡ
+u8    ECGGetBeatEvent(StructBeatEvent* pEvent); //ȡһR¼
 u8    ECGGetLeadStatus(void); //ȡ״̬
 void  OLED_ECG(void);	      //OLEDʾĵϢ
 
@@ -19,6 +19,7 @@
 *********************************************************************************************************/
 #include "LED.h"
 #include "stm32f10x_conf.h"
+#include "FastIO.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -108,9 +109,9 @@ void LEDFlicker(u16 cnt)
     s_iCnt = 0;       //üļֵΪ0
 
     //LED1״̬ȡʵLED0˸
-    GPIO_WriteBit(GPIOC, GPIO_Pin_4, (BitAction)(1 - GPIO_ReadOutputDataBit(GPIOC, GPIO_Pin_4)));
+    PinToggle(GPIOC, GPIO_Pin_4);
     
     //LED2״̬ȡʵLED1˸
-    GPIO_WriteBit(GPIOC, GPIO_Pin_5, (BitAction)(1 - GPIO_ReadOutputDataBit(GPIOC, GPIO_Pin_5)));
+    PinToggle(GPIOC, GPIO_Pin_5);
   }
 }
@@ -29,6 +29,7 @@
 #include "PackUnpack.h"
 #include "SendDataToHost.h"
 #include "ProcHostCmd.h"
+#include "DSPTest.h"
 
 /*********************************************************************************************************
 *                                           全局变量
@@ -36,6 +37,15 @@
 /* 当前OLED显示的波形模式（心电 / 呼吸 / 血氧） */
 WaveMode_t g_displayMode = WAVE_ECG;
 
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+static u32 s_arrBootTime[BOOT_PHASE_MAX];  // 各启动阶段的时间戳（us，从 SysTick 启动算起）
+static u8  s_iBootMarked = 0;              // 已记录的阶段，按位
+static u8  s_iBootSent   = 0;              // 已上报主机的阶段，按位
+static u8  s_iOLEDReady  = FALSE;          // OLED 后台初始化完成后才刷新显示
+static u8  s_arrLeadSent[3] = {0xFF, 0xFF, 0xFF}; // 上次发送的 ECG/RESP/SpO2 导联状态，初值保证第一次必发
+
 /*********************************************************************************************************
 *                                       内部函数声明
 *********************************************************************************************************/
@@ -43,6 +53,11 @@ static void InitSoftware(void);   // 软件模块初始化
 static void InitHardware(void);   // 硬件外设初始化
 static void Proc2msTask(void);    // 2ms 周期任务
 static void Proc1SecTask(void);   // 1s 周期任务
+static void MarkBootPhase(u8 phase); // 记录启动阶段时间戳
+static void ProcBootTask(void);   // 推进 OLED 初始化并上报启动时间
+static void ProcStatusTask(u8 heartbeat); // 导联状态变化时立即上报，heartbeat 为真时无条件上报
+static void ProcEventTask(void);  // 取走心搏/呼吸/脉搏事件并上报
+static void SendBeatEvent(u8 secondId, const StructBeatEvent* pEvent); // 发送一个事件包
 
 /*********************************************************************************************************
 * 函数名称：InitSoftware
@@ -58,22 +73,154 @@ static void InitSoftware(void)
 /*********************************************************************************************************
 * 函数名称：InitHardware
 * 功    能：初始化所有硬件外设
+* 说    明：SystemInit 已由启动文件在 main 之前调用，这里不再重复配置时钟；
+*           先启动采集链路，OLED 只拉低复位脚，剩余初始化由 ProcBootTask 在主循环中完成
 *********************************************************************************************************/
 static void InitHardware(void)
 {
-	SystemInit();           // STM32 系统时钟初始化
 	InitRCC();              // RCC 时钟配置
 	InitNVIC();             // 中断优先级配置
+	InitTimer();            // 软件定时器初始化（时间轮，注册 2ms / 1s 事件）
+	InitSysTick();          // SysTick 1ms 节拍，系统唯一的定时中断
+	MarkBootPhase(BOOT_PHASE_CLOCK);
+
 	InitUART1(115200);      // 串口1初始化，用于调试和指令接收
-	InitTimer();            // 定时器初始化
-	InitLED();              // LED 指示灯初始化
-	InitSysTick();          // SysTick 定时器（2ms / 1s 任务基准）
 	InitDAC();              // DAC 初始化
 	InitADC();              // ADC 初始化
-	InitOLED();             // OLED 显示初始化
 	InitECG();              // ECG 采集模块初始化
 	InitRESP();             // 呼吸信号采集初始化
 	InitSPO2();             // 血氧模块初始化
+	AddTimer(1, 1, SPO2_LED_Task, 0);  // 红光/红外 LED 时序，每 1ms 在节拍中断中推进一步
+	MarkBootPhase(BOOT_PHASE_ACQ);
+
+	InitLED();              // LED 指示灯初始化
+	InitOLED();             // OLED 显示初始化（非阻塞）
+}
+
+/*********************************************************************************************************
+* 函数名称：MarkBootPhase
+* 功    能：记录启动阶段的时间戳
+* 说    明：每个阶段只记录第一次，由 ProcBootTask 上报主机
+*********************************************************************************************************/
+static void MarkBootPhase(u8 phase)
+{
+	if (!(s_iBootMarked & (1 << phase)))
+	{
+		s_arrBootTime[phase] = GetSysTickUs();
+		s_iBootMarked |= 1 << phase;
+	}
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcBootTask
+* 功    能：推进 OLED 后台初始化，并把新记录的启动时间戳发送给主机
+* 说    明：每次主循环调用，各阶段成功发送一次；发送缓冲区满而丢弃的阶段下次再发；全部发送后只剩一次位比较
+*********************************************************************************************************/
+static void ProcBootTask(void)
+{
+	u8 phase;
+
+	if (!s_iOLEDReady && OLEDInitTask())
+	{
+		s_iOLEDReady = TRUE;
+		MarkBootPhase(BOOT_PHASE_OLED);
+	}
+
+	if (s_iBootMarked != s_iBootSent)
+	{
+		for (phase = 0; phase < BOOT_PHASE_MAX; phase++)
+		{
+			if ((s_iBootMarked & ~s_iBootSent) & (1 << phase))
+			{
+				if (SendBootTimePackHost(phase, s_arrBootTime[phase]))
+				{
+					s_iBootSent |= 1 << phase;
+				}
+			}
+		}
+	}
+}
+
+/*********************************************************************************************************
+* 函数名称：SendBeatEvent
+* 功    能：把一个事件打包发送给主机
+* 说    明：lag 为确认采样与峰顶采样之差，各模块的最长跟随采样数都不超过 255
+*********************************************************************************************************/
+static void SendBeatEvent(u8 secondId, const StructBeatEvent* pEvent)
+{
+	u32 lag = pEvent->confirmIdx - pEvent->sampleIdx;
+
+	SendEventPackHost(secondId, pEvent->sampleIdx, (u8)(lag > 255 ? 255 : lag), pEvent->amplitude, pEvent->confidence);
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcEventTask
+* 功    能：取走 ECG、RESP、SPO2 各自确认的事件并上报主机
+* 说    明：每个采样之后调用，每个模块每个采样最多确认一个事件
+*********************************************************************************************************/
+static void ProcEventTask(void)
+{
+	StructBeatEvent event;
+
+	if (ECGGetBeatEvent(&event))
+	{
+		SendBeatEvent(ID2_EVENT_QRS, &event);
+	}
+	if (RESPGetBreathEvent(&event))
+	{
+		SendBeatEvent(ID2_EVENT_BREATH, &event);
+	}
+	if (SPO2GetPulseEvent(&event))
+	{
+		SendBeatEvent(ID2_EVENT_PULSE, &event);
+	}
+}
+
+/*********************************************************************************************************
+* 函数名称：ProcStatusTask
+* 功    能：组装导联/异常状态数据包，导联状态与上次发送的不同时立即发送给主机
+* 说    明：Proc2msTask 每 2ms 调用一次，导联脱落（ECG 为 EXTI0 消抖后的状态）最迟 2ms 后上报；
+*           Proc1SecTask 以 heartbeat 调用，保留每秒一次的状态包作为心跳；
+*           下位机不做报警判断，异常状态字节恒为 0，不作为立即上报的条件；
+*           只有状态包进入发送缓冲区后才更新 s_arrLeadSent，缓冲区满而丢弃的变化 2ms 后重发
+*********************************************************************************************************/
+static void ProcStatusTask(u8 heartbeat)
+{
+	u8 statusDataPack[6];
+	u8 i;
+
+	// 0导联脱落 1导联正常；奇数字节为各模块异常状态，目前恒为 0
+	statusDataPack[0] = ECGGetLeadStatus();
+	statusDataPack[1] = 0;
+	statusDataPack[2] = RESPGetLeadStatus();
+	statusDataPack[3] = 0;
+	statusDataPack[4] = SPO2GetLeadStatus();
+	statusDataPack[5] = 0;
+
+	if (!heartbeat)
+	{
+		for (i = 0; i < 3; i++)
+		{
+			if (statusDataPack[2 * i] != s_arrLeadSent[i])
+			{
+				break;
+			}
+		}
+		if (i == 3)
+		{
+			return;
+		}
+	}
+
+	// 发送状态数据包到主机
+	if (!SendStatusPackHost(statusDataPack))
+	{
+		return;
+	}
+	for (i = 0; i < 3; i++)
+	{
+		s_arrLeadSent[i] = statusDataPack[2 * i];
+	}
 }
 
 /*********************************************************************************************************
@@ -90,11 +237,22 @@ static void Proc2msTask(void)
 	int ecgWaveData;        // 心电 ADC 数据
 	int respWaveData;       // 呼吸 ADC 数据
 	int spo2WaveData;       // 血氧 ADC 数据
+	u8  uart1RecData;       // 串口接收到的数据
 
 	if (Get2msFlag())
 	{
-		/* 每 4ms 执行一次信号处理任务 */
-		if (s_iCnt2 >= 1)
+		// 处理主机命令，硬件在环测试的块处理也在这里完成
+		while (ReadUART1(&uart1RecData, 1))
+		{
+			ProcHostCmd(uart1RecData);
+		}
+
+		/* 每 4ms 执行一次信号处理任务，测试模式下采样由主机注入，不处理 ADC */
+		if (DSPTestIsActive())
+		{
+			s_iCnt2 = 0;
+		}
+		else if (s_iCnt2 >= 1)
 		{
 			// 获取波形数据
 			ecgWaveData = ECGTask(ReadECGADC());
@@ -110,6 +268,8 @@ static void Proc2msTask(void)
 			s_waveDataPack[5] = spo2WaveData & 0xFF;
 			// 发送波形数据包到主机
 			SendWavePackHost(s_waveDataPack);
+			ProcEventTask();    // 事件紧跟在确认它的采样的波形包之后
+			MarkBootPhase(BOOT_PHASE_FIRST_WAVE);
 
 			s_iCnt2 = 0;
 		}
@@ -118,6 +278,10 @@ static void Proc2msTask(void)
 			s_iCnt2++;
 		}
 
+		if (!DSPTestIsActive())
+		{
+			ProcStatusTask(FALSE); // 导联状态变化立即上报
+		}
 		LEDFlicker(250);    // LED 心跳指示
 		Clr2msFlag();       // 清除 2ms 标志
 	}
@@ -126,36 +290,42 @@ static void Proc2msTask(void)
 /*********************************************************************************************************
 * 函数名称：Proc1SecTask
 * 功    能：1s 周期执行的低频任务
-* 说    明：主要用于 OLED 显示刷新
+* 说    明：主要用于 OLED 显示刷新、参数上报和状态心跳
 *********************************************************************************************************/
 static void Proc1SecTask(void)
 {
 	static u8 s_paramDataPack[6] = {0, 0, 0, 0, 0, 0};	// 参数数据包
-	static u8 s_statusDataPack[6] = {0, 0, 0, 0, 0, 0};	// 状态数据包
 	u16 heartRate;
 	u16 respRate;
 	u16 spo2Value;
-	u8 ecgLeadStatus;
-	u8 ecgErrStatus;
-	u8 respLeadStatus;
-	u8 respErrStatus;
-	u8 spo2LeadStatus;
-	u8 spo2ErrStatus;
 	
 	if (Get1SecFlag())
 	{
-		OLEDClear();        // 清屏
-		OLED_ECG();         // 显示 ECG 信息
-		OLED_RESP();        // 显示 RESP 信息
-		OLED_SPO2();        // 显示 SPO2 信息
-		OLEDRefreshGRAM();	// 刷新 OLED 显存
+		if (s_iOLEDReady)
+		{
+			OLEDClear();        // 清屏
+			OLED_ECG();         // 显示 ECG 信息
+			OLED_RESP();        // 显示 RESP 信息
+			OLED_SPO2();        // 显示 SPO2 信息
+			OLEDRefreshGRAM();	// 刷新 OLED 显存
+		}
 
 		// printf("TriVital-Monitor is ready!\r\n");
 
+		// 测试模式下串口只返回测试结果
+		if (DSPTestIsActive())
+		{
+			Clr1SecFlag();
+			return;
+		}
+
 		// 获取参数数据
 		heartRate = ECGGetHeartRate();
 		respRate = RESPGetRespRate();
 		spo2Value = SPO2GetSPO2Value();
+		if (heartRate > 0) MarkBootPhase(BOOT_PHASE_FIRST_HR);
+		if (respRate > 0)  MarkBootPhase(BOOT_PHASE_FIRST_RR);
+		if (spo2Value > 0) MarkBootPhase(BOOT_PHASE_FIRST_SPO2);
 	
 		// 组装参数数据包
 		s_paramDataPack[0] = heartRate >> 8;		//心率高位
@@ -167,22 +337,8 @@ static void Proc1SecTask(void)
 		// 发送参数数据包到主机
 		SendParamPackHost(s_paramDataPack);
 
-		// 获取状态数据
-		ecgLeadStatus = ECGGetLeadStatus();
-		ecgErrStatus = 0;
-		respLeadStatus = RESPGetLeadStatus();
-		respErrStatus = 0;
-		spo2LeadStatus = SPO2GetLeadStatus();
-		spo2ErrStatus = 0;
-		// 组装状态数据包
-		s_statusDataPack[0] = ecgLeadStatus;	//0导联脱落 1导联正常
-		s_statusDataPack[1] = ecgErrStatus;
-		s_statusDataPack[2] = respLeadStatus;	//0导联脱落 1导联正常
-		s_statusDataPack[3] = respErrStatus;
-		s_statusDataPack[4] = spo2LeadStatus;	//0导联脱落 1导联正常
-		s_statusDataPack[5] = spo2ErrStatus;
-		// 发送状态数据包到主机
-		SendStatusPackHost(s_statusDataPack);
+		// 状态数据包作为心跳每秒发送一次
+		ProcStatusTask(TRUE);
 
 		Clr1SecFlag();
 	}
@@ -197,11 +353,12 @@ int main(void)
 	InitHardware();         // 硬件初始化
 	InitSoftware();         // 软件初始化
 
-	DelayNms(300);          // 等待系统稳定
 	// printf("Init System has been finished.\r\n");
+	MarkBootPhase(BOOT_PHASE_LOOP);
 
 	while (1)
 	{
+		ProcBootTask();     // 启动收尾：OLED 初始化、启动时间上报
 		Proc2msTask();      // 实时任务
 		Proc1SecTask();     // 显示任务
 	}
@@ -28,8 +28,11 @@
 *********************************************************************************************************/
 #include "OLED.h"
 #include "stm32f10x_conf.h"
+#include "FastIO.h"
 #include "OLEDFont.h"
+#include <string.h>
 #include "SysTick.h"
+#include "Timer.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -37,30 +40,42 @@
 #define OLED_CMD    0 //
 #define OLED_DATA   1 //
 
-//OLED˿ڶ  
-#define CLR_OLED_CS()   GPIO_ResetBits(GPIOB, GPIO_Pin_12)  //CSƬѡ
-#define SET_OLED_CS()   GPIO_SetBits  (GPIOB, GPIO_Pin_12)
+//OLED˿ڶ壬ֱдBSRR/BRR
+#define CLR_OLED_CS()   PinClr(GPIOB, GPIO_Pin_12)  //CSƬѡ
+#define SET_OLED_CS()   PinSet(GPIOB, GPIO_Pin_12)
 
-#define CLR_OLED_RES()  GPIO_ResetBits(GPIOB, GPIO_Pin_14)  //RESλ
-#define SET_OLED_RES()  GPIO_SetBits  (GPIOB, GPIO_Pin_14)
+#define CLR_OLED_RES()  PinClr(GPIOB, GPIO_Pin_14)  //RESλ
+#define SET_OLED_RES()  PinSet(GPIOB, GPIO_Pin_14)
 
-#define CLR_OLED_DC()   GPIO_ResetBits(GPIOC, GPIO_Pin_3)   //DCݱ־0-/1-ݣ
-#define SET_OLED_DC()   GPIO_SetBits  (GPIOC, GPIO_Pin_3)
+#define CLR_OLED_DC()   PinClr(GPIOC, GPIO_Pin_3)   //DCݱ־0-/1-ݣ
+#define SET_OLED_DC()   PinSet(GPIOC, GPIO_Pin_3)
  
-#define CLR_OLED_SCK()  GPIO_ResetBits(GPIOB, GPIO_Pin_13)  //SCKʱ
-#define SET_OLED_SCK()  GPIO_SetBits  (GPIOB, GPIO_Pin_13)
+#define CLR_OLED_SCK()  PinClr(GPIOB, GPIO_Pin_13)  //SCKʱ
+#define SET_OLED_SCK()  PinSet(GPIOB, GPIO_Pin_13)
 
-#define CLR_OLED_DIN()  GPIO_ResetBits(GPIOB, GPIO_Pin_15)  //DIN
-#define SET_OLED_DIN()  GPIO_SetBits  (GPIOB, GPIO_Pin_15)
+#define CLR_OLED_DIN()  PinClr(GPIOB, GPIO_Pin_15)  //DIN
+#define SET_OLED_DIN()  PinSet(GPIOB, GPIO_Pin_15)
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
 *********************************************************************************************************/	 
+//̨ʼ״̬OLEDInitTaskѭƽ
+typedef enum
+{
+  OLED_INIT_RESET,  //RESͣλSSD1306
+  OLED_INIT_WAIT,   //RESߣȴSSD1306
+  OLED_INIT_CLEAR,  //ҳ
+  OLED_INIT_READY   //ʼ
+}EnumOLEDInitState;
 
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
 static  u8  s_arrOLEDGRAM[128][8];    //OLEDԴ滺
+
+static  u8  s_iOLEDInitState = OLED_INIT_RESET; //̨ʼ״̬
+static  u32 s_iOLEDInitTime  = 0;               //뵱ǰ״̬1ms
+static  u8  s_iOLEDClearPage = 0;               //еҳ
  
 /*********************************************************************************************************
 *                                              ڲ
@@ -70,6 +85,7 @@ static  void  ConfigOLEDReg(void);              //
                                                 
 static  void  OLEDWriteByte(u8 dat, u8 cmd);    //SSD1306дһֽ
 static  void  OLEDDrawPoint(u8 x, u8 y, u8 t);  //OLEDָλû
+static  void  OLEDRefreshPage(u8 page);         //STM32GRAMеһҳдSSD1306
                                                 
 static  u32   CalcPow(u8 m, u8 n);              //mnη
 
@@ -285,6 +301,29 @@ static  u32 CalcPow(u8 m, u8 n)
   return result;      //mnݵֵ
 }
  
+/*********************************************************************************************************
+* ƣOLEDRefreshPage
+* ܣSTM32GRAMеһҳд뵽SSD1306GRAM
+* page-ҳַ07
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+static  void  OLEDRefreshPage(u8 page)
+{
+  u8 n;
+
+  OLEDWriteByte(0xb0 + page, OLED_CMD); //ҳַ07
+  OLEDWriteByte(0x00, OLED_CMD);        //ʾλáе͵ַ
+  OLEDWriteByte(0x10, OLED_CMD);        //ʾλáиߵַ 
+  for(n = 0; n < 128; n++)              //ÿһ
+  {
+    //ͨѭSTM32GRAMд뵽SSD1306GRAM
+    OLEDWriteByte(s_arrOLEDGRAM[n][page], OLED_DATA); 
+  }
+}
+
 /*********************************************************************************************************
 *                                              APIʵ
 *********************************************************************************************************/	
@@ -295,22 +334,75 @@ static  u32 CalcPow(u8 m, u8 n)
 * void
 *   ֵvoid 
 * ڣ20180101
-* ע    :
+* ע    ⣺ֻGPIORESλĴúOLEDInitTaskѭɣ
+*           ɼصȴOLED
 *********************************************************************************************************/   
 void  InitOLED(void)
 { 
   ConfigOLEDGPIO();     //OLEDGPIO
   
   CLR_OLED_RES();
-  DelayNms(10);  
-  SET_OLED_RES();       //RES
-  DelayNms(10);
-  
-  ConfigOLEDReg();      //OLEDļĴ
-  
-  OLEDClear();          //OLED
+  s_iOLEDInitState = OLED_INIT_RESET;
+  s_iOLEDInitTime  = GetTimeCounter();
 }  
 
+/*********************************************************************************************************
+* ƣOLEDInitTask
+* ܣƽOLEDĺ̨ʼ
+* void 
+* void
+*   ֵʼɷTRUE򷵻FALSE
+* ڣ20261017
+* ע    ⣺ѭзáSSD1306RES͵ƽֻ3usλ󼴿ɽȴ2
+*           1msԭȵ10msʱҪÿεдһҳռ2msʱ
+*********************************************************************************************************/   
+u8    OLEDInitTask(void)
+{
+  u32 now = GetTimeCounter();
+  u8  i;
+
+  switch(s_iOLEDInitState)
+  {
+    case OLED_INIT_RESET:
+      if(now - s_iOLEDInitTime >= 2)
+      {
+        SET_OLED_RES();     //RES
+        s_iOLEDInitState = OLED_INIT_WAIT;
+        s_iOLEDInitTime  = now;
+      }
+      break;
+
+    case OLED_INIT_WAIT:
+      if(now - s_iOLEDInitTime >= 2)
+      {
+        ConfigOLEDReg();    //OLEDļĴ
+
+        for(i = 0; i < 128; i++)
+        {
+          memset(s_arrOLEDGRAM[i], 0, sizeof(s_arrOLEDGRAM[i]));
+        }
+
+        s_iOLEDClearPage = 0;
+        s_iOLEDInitState = OLED_INIT_CLEAR;
+      }
+      break;
+
+    case OLED_INIT_CLEAR:
+      OLEDRefreshPage(s_iOLEDClearPage);  //OLEDݣÿһҳ
+      s_iOLEDClearPage++;
+      if(s_iOLEDClearPage >= 8)
+      {
+        s_iOLEDInitState = OLED_INIT_READY;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return (OLED_INIT_READY == s_iOLEDInitState) ? TRUE : FALSE;
+}
+
 /*********************************************************************************************************
 * ƣOLEDDisplayOn
 * ܣOLEDʾ
@@ -361,18 +453,10 @@ void  OLEDDisplayOff( void )
 void  OLEDRefreshGRAM(void)
 {
   u8 i;
-  u8 n;
                                           
   for(i = 0; i < 8; i++)                  //ÿһҳ
   {                                       
-    OLEDWriteByte(0xb0 + i, OLED_CMD);    //ҳַ07
-    OLEDWriteByte(0x00, OLED_CMD);        //ʾλáе͵ַ
-    OLEDWriteByte(0x10, OLED_CMD);        //ʾλáиߵַ 
-    for(n = 0; n < 128; n++)              //ÿһ
-    {
-      //ͨѭSTM32GRAMд뵽SSD1306GRAM
-      OLEDWriteByte(s_arrOLEDGRAM[n][i], OLED_DATA); 
-    }
+    OLEDRefreshPage(i);
   }   
 }
 
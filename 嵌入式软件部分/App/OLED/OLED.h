@@ -33,6 +33,7 @@
 *                                              API
 *********************************************************************************************************/	    
 void  InitOLED(void);        //ʼOLEDģ
+u8    OLEDInitTask(void);    //ƽOLED̨ʼɺ󷵻TRUE
 void  OLEDDisplayOn(void);   //OLEDʾ
 void  OLEDDisplayOff(void);  //رOLEDʾ
 void  OLEDRefreshGRAM(void); //STM32GRAMд뵽SSD1306GRAM
@@ -59,7 +59,7 @@ static  u8    UnpackWithCheckSum(u8* pPack);  //
 * ע    ⣺ͷBIT0ΪIDBIT7ͷBIT1Ϊ1BIT7ͷBIT2Ϊ2BIT7ͷ
 *           BIT6Ϊ6BIT7 
 *********************************************************************************************************/
-static void PackWithCheckSum(u8* pPack)
+static HOT_FUNC void PackWithCheckSum(u8* pPack)
 {
   u8  i;
   u8  dataHead;   //ͷݰĵ2λãModuleID֮
@@ -187,6 +187,35 @@ u8  PackData(StructPackType* pPT)
   return(valid);
 }
 
+/*********************************************************************************************************
+* ƣPackDataToBuf
+* ܣģIDID6ֱӴpPackָPACK_LENֽ
+* moduleId-ģIDsecondId-IDpData-6
+* pPackõݰֱָ򴮿ڷͻ
+*   ֵvalid1-ɹ0-ʧܣʱдpPack
+* ڣ20261017
+* ע    ⣺PackDataĽֽͬʡȥװStructPackTypeٿĹ
+*********************************************************************************************************/
+HOT_FUNC u8 PackDataToBuf(u8 moduleId, u8 secondId, const u8* pData, u8* pPack)
+{
+  u8 i;
+
+  if(moduleId >= 0x80)              //ID0x000x7F֮
+  {
+    return 0;
+  }
+
+  pPack[0] = moduleId;
+  pPack[2] = secondId;
+  for(i = 0; i < PACK_DATA_LEN; i++)
+  {
+    pPack[3 + i] = pData[i];
+  }
+  PackWithCheckSum(pPack);
+
+  return 1;
+}
+
 /*********************************************************************************************************
 * ƣUnPackData
 * ܣݽн1ʾһЧʱͨGetUnPackRsltݰȡߣ
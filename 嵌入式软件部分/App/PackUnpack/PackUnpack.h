@@ -25,6 +25,8 @@
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
+#define PACK_LEN        10          //ݰȣģID+ͷ+ID+6+У
+#define PACK_DATA_LEN   6           //ݰеݸ
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
@@ -46,6 +48,7 @@ typedef enum
   MODULE_WAVE     = 0x10,  //
   MODULE_PARAM    = 0x11,  //
   MODULE_STATUS    = 0x12,  //״̬
+  MODULE_TEST     = 0x13,  //Ӳڻ
 
   MAX_MODULE_ID  = 0x80
 }EnumPackID;
@@ -63,6 +66,20 @@ typedef enum
   CMD_GET_TIME_ACK    = 0x81,     //ȡϵͳʱӦ
 }EnumSysSecondID;
 
+//DAT_SYS_TIME׶αţdata[0]Ϊ׶Σdata[2]data[5]ΪSysTick΢ֽǰ
+typedef enum
+{
+  BOOT_PHASE_CLOCK      = 0x00,   //ʱ1msľ
+  BOOT_PHASE_ACQ        = 0x01,   //ADCDMASPO2 LEDʱʼɼ
+  BOOT_PHASE_LOOP       = 0x02,   //ѭ
+  BOOT_PHASE_FIRST_WAVE = 0x03,   //һΰ
+  BOOT_PHASE_OLED       = 0x04,   //OLEDں̨ɳʼ
+  BOOT_PHASE_FIRST_HR   = 0x05,   //һЧ
+  BOOT_PHASE_FIRST_RR   = 0x06,   //һЧ
+  BOOT_PHASE_FIRST_SPO2 = 0x07,   //һЧѪ
+  BOOT_PHASE_MAX
+}EnumBootPhase;
+
 //ݵĶID
 typedef enum
 {
@@ -72,7 +89,11 @@ typedef enum
 //ݵĶID
 typedef enum
 {
-  ID2_PARAM = 0x02,         //
+  ID2_PARAM        = 0x02,  //
+  ID2_EVENT_QRS    = 0x03,  //R¼data[0]data[2]嶥ŵ24λֽǰ
+                            //data[3]嶥ȷʱĲdata[4]Էȣ%data[5]Ŷ0100
+  ID2_EVENT_BREATH = 0x04,  //¼ʽͬID2_EVENT_QRS
+  ID2_EVENT_PULSE  = 0x05,  //¼ʽͬID2_EVENT_QRS
 }EnumParamSecondID;
 
 //״̬ݵĶID
@@ -80,12 +101,26 @@ typedef enum
 {
   ID2_STATUS = 0x02,         //״̬
 }EnumStatusSecondID;
+
+//ӲڻԵĶIDCMD_Ϊ͵DAT_Ϊλص
+typedef enum
+{
+  CMD_TEST_START  = 0x01,    //ģʽdata[0]Ϊ鳤1DSP_TEST_MAX_BLOCKDSPģ³ʼ
+  CMD_TEST_FRAME  = 0x02,    //һ֡ECGRESPREDIR12λνdata[0]data[5]
+  CMD_TEST_STOP   = 0x03,    //˳ģʽDSPģ³ʼָADCɼ
+
+  DAT_TEST_WAVE   = 0x10,    //һECGRESPSPO2ʽ벨ΰͬ
+  DAT_TEST_PARAM  = 0x11,    //һ鴦ʡʡѪʽͬ
+  DAT_TEST_CYCLES = 0x12,    //һĴdata[0]ģ飨0-ECG1-RESP2-SPO2data[1]鳤
+                             //data[2]data[5]ֽǰSPO2ڰһһ
+}EnumTestSecondID;
   
 /*********************************************************************************************************
 *                                              API
 *********************************************************************************************************/
 void  InitPackUnpack(void);               //ʼPackUnpackģ
 u8    PackData(StructPackType* pPT);      //ݽд1-ɹ0-ʧ
+u8    PackDataToBuf(u8 moduleId, u8 secondId, const u8* pData, u8* pPack); //ֱӴpPack1-ɹ0-ʧ
 u8    UnPackData(u8 data);                //ݽн1-ɹ0-ʧ
 
 StructPackType  GetUnPackRslt(void);      //ȡݰ
@@ -21,6 +21,7 @@
 #include "PackUnpack.h"
 #include "DAC.h"
 #include "SendDataToHost.h"
+#include "DSPTest.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -37,10 +38,48 @@
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
+static void OnTestCmd(const StructPackType* pPack);   //ӲڻӦ
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOnTestCmd
+* ܣӲڻӦ
+* pPack-
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺STARTSTOP ӦFRAME 󣬲֡Ӧ𣬿Ӧ
+*********************************************************************************************************/
+static void OnTestCmd(const StructPackType* pPack)
+{
+  switch(pPack->packSecondId)
+  {
+    case CMD_TEST_START:
+      if(pPack->arrData[0] >= 1 && pPack->arrData[0] <= DSP_TEST_MAX_BLOCK)
+      {
+        DSPTestStart(pPack->arrData[0]);
+        SendAckPack(MODULE_TEST, CMD_TEST_START, CMD_ACK_OK);
+      }
+      else
+      {
+        SendAckPack(MODULE_TEST, CMD_TEST_START, CMD_ACK_PARAM_ERR);
+      }
+      break;
+    case CMD_TEST_FRAME:
+      DSPTestPutFrame(pPack->arrData);
+      break;
+    case CMD_TEST_STOP:
+      DSPTestStop();
+      SendAckPack(MODULE_TEST, CMD_TEST_STOP, CMD_ACK_OK);
+      break;
+    default:
+      SendAckPack(MODULE_TEST, pPack->packSecondId, CMD_ACK_BAD_CMD);
+      break;
+  }
+}
+
 /*********************************************************************************************************
 * ƣOnGenWave
 * ܣɲεӦ
@@ -66,7 +105,7 @@
 *********************************************************************************************************/
 void  InitProcHostCmd(void)
 {
-  
+  InitDSPTest();
 }
 
 /*********************************************************************************************************
@@ -93,6 +132,9 @@ void ProcHostCmd(u8 recData)
 
         //SendAckPack(MODULE_WAVE, CMD_GEN_WAVE, ack);  //ӦϢ
         break;
+      case MODULE_TEST:        //Ӳڻ
+        OnTestCmd(&pack);
+        break;
       default:     
         break;
     }
@@ -16,7 +16,6 @@
 #include "math.h"
 #include "UART1.h"
 #include "OLED.h"
-#include "Timer.h"
 
 /*********************************************************************************************************
 *                                           궨
@@ -24,6 +23,8 @@
 #define N 2               // IIR ˲ף
 #define SmoothWindowsLen 200    // ƽ˲ڳ
 #define BR_WAVE_LEN 1800  // ֵ㴰ڳ
+#define RESP_SAMPLE_MS 4  // msProc2msTask ÿ 4ms һ
+#define RESP_BREATH_MAX_WAIT 250 // к 250 1sҷ嶥¼е lag Ϊһֽ
 
 /*********************************************************************************************************
 *                                           ڲ
@@ -33,6 +34,12 @@
  * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
  */
 
+// ƽ˲״̬
+static double Smooth_buf[SmoothWindowsLen] = {0};
+static int Smooth_idx = 0;
+static int Smooth_count = 0;
+static double Smooth_sum = 0;
+
 // ʼر
 static double arr_BR_Wave[BR_WAVE_LEN] = {0}; // λ
 static int BR_Wave_index = 0;                 // 
@@ -40,48 +47,23 @@ static double peakThreshold = 0;              // 
 static double lastPeak_index = 0;              // һηֵʱ
 static double currentPeak_index = 0;           // ǰֵʱ
 static int breathRate = 0;                     // ʣBPM
+static u32 BR_Sample_cnt = 0;                  // ѴĲֵʱ
 
 // ״̬жϣֵ
 static double s_peak2peak = 0;
+static double s_waveMin = 0;                   // һֵڵСֵ
+
+static StructBeatEvent s_structBreath;         // ¼
 
 /*********************************************************************************************************
 *                                           ڲ
 *********************************************************************************************************/
-static double SmoothingFilter(double NewData);              // ƽ˲
-
 static void Update_Threshold(double *data_window, int windowSize, double *threshold_output); // ֵ
 static void calRate(double ppdistance, int *rate_output);   // ʼ
 
 /*********************************************************************************************************
 *                                           ڲʵ
 *********************************************************************************************************/
-/*********************************************************************************************************
-* ƣƽƽ˲
-* ܣݽлƽƽ˲
-* void
-* void
-*   ֵvoid
-* ڣ20260416
-* ע    ⣺
-*********************************************************************************************************/
-static double SmoothingFilter(double newData)
-{
-  static double buf[SmoothWindowsLen] = {0};
-  static int idx = 0;
-  static int count = 0;
-  static double sum = 0;
-
-  sum -= buf[idx];
-  buf[idx] = newData;
-  sum += newData;
-
-  idx++;
-  if(idx >= SmoothWindowsLen) idx = 0;
-  if(count < SmoothWindowsLen) count++;
-
-  return sum / count;
-}
-
 /*********************************************************************************************************
 * ƣ·ֵֵ
 * ܣݸºźŵķֵֵ
@@ -91,7 +73,7 @@ static double SmoothingFilter(double newData)
 * ڣ20260416
 * ע    ⣺
 *********************************************************************************************************/
-static void Update_Threshold(double *data_window, int windowSize, double *threshold_output)
+static HOT_FUNC void Update_Threshold(double *data_window, int windowSize, double *threshold_output)
 {
   int i;
   double peakMax = 0.0;
@@ -104,6 +86,7 @@ static void Update_Threshold(double *data_window, int windowSize, double *thresh
   }
 
   s_peak2peak = peakMax - peakMin;  // ·ֵ
+  s_waveMin = peakMin;
   *threshold_output = peakMax - (peakMax - peakMin) / 4;
 }
 
@@ -116,7 +99,7 @@ static void Update_Threshold(double *data_window, int windowSize, double *thresh
 * ڣ20260416
 * ע    ⣺
 *********************************************************************************************************/
-static void calRate(double ppdistance, int *rate_output)
+static HOT_FUNC void calRate(double ppdistance, int *rate_output)
 {
   *rate_output = (int)(60000.0 / ppdistance); // ppdistancems
 }
@@ -136,6 +119,11 @@ static void calRate(double ppdistance, int *rate_output)
 void InitRESP(void)
 {
   memset(arr_BR_Wave, 0, sizeof(arr_BR_Wave));
+  memset(Smooth_buf, 0, sizeof(Smooth_buf));
+  Smooth_idx = 0;
+  Smooth_count = 0;
+  Smooth_sum = 0;
+  BR_Sample_cnt = 0;
   BR_Wave_index = 0;
   peakThreshold = 0;
   lastPeak_index = 0;
@@ -143,47 +131,104 @@ void InitRESP(void)
   breathRate = 0;
 
   s_peak2peak = 0;
+  s_waveMin = 0;
+  InitBeatEvent(&s_structBreath, RESP_BREATH_MAX_WAIT);
 }
 
-/*********************************************************************************************************
-* ƣRESPʵʱ
-* ܣECGźŽʵʱ˲ֵ¡ֵͺʼ
-* void
-* void
-*   ֵvoid
-* ڣ20260416
-* ע    ⣺
-*********************************************************************************************************/
-int RESPTask(u16 inp)
+/* 鴦ģRESPProcessBlock  RESPTask ã RESPProcessBlock ˵ */
+static HOT_FUNC FORCE_INLINE void RESPBlock(const u16* pIn, i16* pOut, int num)
 {
-  double output1 = 0;
+  int    idx   = Smooth_idx;
+  int    count = Smooth_count;
+  double sum   = Smooth_sum;
+  double y;
+  int i = 0;
+  int end;
 
-  // źŴݲ  ͨ  ƽ
-  output1 = SmoothingFilter(inp);
+  while(i < num)
+  {
+    // ֵʱ
+    end = i + (BR_WAVE_LEN - BR_Wave_index);
+    if(end > num) end = num;
 
-  // 沨
-  arr_BR_Wave[BR_Wave_index++] = output1;
+    for(; i < end; i++)
+    {
+      // ƽ
+      sum -= Smooth_buf[idx];
+      Smooth_buf[idx] = pIn[i];
+      sum += pIn[i];
+      idx++;
+      if(idx >= SmoothWindowsLen) idx = 0;
+      if(count < SmoothWindowsLen) count++;
+      y = sum / count;
 
-  // λֵ
-  if(BR_Wave_index >= BR_WAVE_LEN)
-  {
-    BR_Wave_index = 0;
-    Update_Threshold(arr_BR_Wave, BR_WAVE_LEN, &peakThreshold);
-  }
+      pOut[i] = (i16)(u16)y;
+      arr_BR_Wave[BR_Wave_index++] = y;
+      BR_Sample_cnt++;
 
-  // ֵ⣨عУ
-  if((BR_Wave_index > 1) && (BR_Wave_index < BR_WAVE_LEN - 1))
-  {
-    if((arr_BR_Wave[BR_Wave_index - 2] <= peakThreshold) &&
-       (arr_BR_Wave[BR_Wave_index - 1] >= peakThreshold))
+      if(s_structBreath.armed)
+      {
+        BeatEventTrack(&s_structBreath, y, BR_Sample_cnt, s_waveMin, s_peak2peak);
+      }
+
+      // ֵ⣨عУһ
+      if((BR_Wave_index > 1) && (BR_Wave_index < BR_WAVE_LEN - 1))
+      {
+        if((arr_BR_Wave[BR_Wave_index - 2] <= peakThreshold) &&
+           (arr_BR_Wave[BR_Wave_index - 1] >= peakThreshold))
+        {
+          currentPeak_index = BR_Sample_cnt * RESP_SAMPLE_MS;
+          calRate(currentPeak_index - lastPeak_index, &breathRate);
+          lastPeak_index = currentPeak_index;
+          BeatEventArm(&s_structBreath, y, BR_Sample_cnt);
+        }
+      }
+    }
+
+    // λֵ
+    if(BR_Wave_index >= BR_WAVE_LEN)
     {
-      currentPeak_index = GetTimeCounter();
-      calRate(currentPeak_index - lastPeak_index, &breathRate);
-      lastPeak_index = currentPeak_index;
+      BR_Wave_index = 0;
+      Update_Threshold(arr_BR_Wave, BR_WAVE_LEN, &peakThreshold);
     }
   }
 
-  return (u16)output1;
+  Smooth_idx   = idx;
+  Smooth_count = count;
+  Smooth_sum   = sum;
+}
+
+/*********************************************************************************************************
+* ƣRESP鴦
+* ܣ num ƽֵ¡ֵͺʼ
+* pIn-ADC num-
+* pOut-ƽĲΣ RESPTask ķֵӦ
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ƽۼӺڿڱھֲУʱдأ
+*           жÿһΣֵʱ䰴  RESP_SAMPLE_MS 
+*********************************************************************************************************/
+HOT_FUNC void RESPProcessBlock(const u16* pIn, i16* pOut, int num)
+{
+  RESPBlock(pIn, pOut, num);
+}
+
+/*********************************************************************************************************
+* ƣRESPʵʱ
+* ܣһ˲ֵ¡ֵͺʼ
+* inp-ADC 
+* void
+*   ֵƽĲֵ
+* ڣ20260416
+* ע    ⣺ãȼ num Ϊ 1  RESPProcessBlock
+*********************************************************************************************************/
+HOT_FUNC int RESPTask(u16 inp)
+{
+  i16 out;
+
+  RESPBlock(&inp, &out, 1);
+
+  return (u16)out;
 }
 
 /*********************************************************************************************************
@@ -200,6 +245,20 @@ u16   RESPGetRespRate(void)   //
 	return (u16)breathRate;
 }
 
+/*********************************************************************************************************
+* ƣȡ¼
+* ܣȡһȷϵĺ¼
+* void
+* pEvent-嶥ĲšȷʱĲšԷȺŶ
+*   ֵTRUE-¼FALSE-û
+* ڣ20261017
+* ע    ⣺к浽嶥 RESP_BREATH_MAX_WAIT ȷ
+*********************************************************************************************************/
+u8 RESPGetBreathEvent(StructBeatEvent* pEvent)
+{
+  return BeatEventGet(&s_structBreath, pEvent);
+}
+
 /*********************************************************************************************************
 * ƣȡ״̬
 * ܣݵǰֵжϵ״̬
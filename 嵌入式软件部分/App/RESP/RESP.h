@@ -21,6 +21,7 @@
 *********************************************************************************************************/
 #include "DataType.h"
 #include "Main.h"
+#include "BeatEvent.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -35,8 +36,10 @@ extern WaveMode_t g_displayMode;
 *                                              API
 *********************************************************************************************************/
 void  InitRESP(void);        //ʼRESPģ
+void RESPProcessBlock(const u16* pIn, i16* pOut, int num); //num
 int  RESPTask(u16 inp);        //RESPʵʱ
 u16   RESPGetRespRate(void);   //ȡ
+u8    RESPGetBreathEvent(StructBeatEvent* pEvent); //ȡһ¼
 u8   RESPGetLeadStatus(void); //ȡ״̬
 void  OLED_RESP(void);	//OLEDʾϢ
 
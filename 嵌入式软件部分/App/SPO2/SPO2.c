@@ -28,24 +28,37 @@
 #include "UART1.h"
 #include "OLED.h"
 #include "ADC.h"
-#include "Timer.h"
 #include "DAC.h"
 #include "SysTick.h"
+#include "FastIO.h"
 
 /*********************************************************************************************************
  *                                              궨
  *********************************************************************************************************/
 /*  / LED */
-#define RED_ON GPIO_WriteBit(GPIOA, GPIO_Pin_5, Bit_SET)		// LED
-#define RED_OFF GPIO_WriteBit(GPIOA, GPIO_Pin_5, Bit_RESET) // LEDر
-#define IR_ON GPIO_WriteBit(GPIOA, GPIO_Pin_6, Bit_SET)			// LED
-#define IR_OFF GPIO_WriteBit(GPIOA, GPIO_Pin_6, Bit_RESET)	// LEDر
+#define RED_ON PinSet(GPIOA, GPIO_Pin_5)		// LED
+#define RED_OFF PinClr(GPIOA, GPIO_Pin_5) // LEDر
+#define IR_ON PinSet(GPIOA, GPIO_Pin_6)			// LED
+#define IR_OFF PinClr(GPIOA, GPIO_Pin_6)	// LEDر
 
 /* ˲ */
 #define N 2							// IIR˲
 #define SMOOTH_LEN 10		// ֵ˲ڳ
 #define SP_WAVE_LEN 300 // SPO2ηڳȣ5s
+#define SP_WARMUP_LEN 150 // ʱһڳȣ֮μӱSP_WAVE_LEN
 #define R_BUFSIZE 5			// Rֵֵ˲峤
+#define SPO2_SAMPLE_MS 4 // msProc2msTaskÿ4msһSPO2Task
+#define SPO2_PULSE_MAX_WAIT 50 // к50200msҷ嶥
+
+/* ֱIIͶ׽ڵw1/w2Ϊ״̬w[n-1]/w[n-2]ϵa0Ϊ1 */
+#define BIQUAD_STEP(x, y, w1, w2, a1, a2, b0, b1, b2) \
+	do                                                 \
+	{                                                  \
+		double w_ = (x) - (a1) * (w1) - (a2) * (w2);     \
+		(y) = (b0) * w_ + (b1) * (w1) + (b2) * (w2);     \
+		(w2) = (w1);                                     \
+		(w1) = w_;                                       \
+	} while (0)
 
 /* Զ */
 #define RED_INTENSITY_MIN 100 // С
@@ -81,10 +94,13 @@ static double IIRHighpass_a[N + 1] = {1.0, -1.97867495733125, 0.978899949722877}
 // ʼ
 static double arr_SPO2_Wave_Rate[SP_WAVE_LEN] = {0}; // ֵ̬´
 static int SPO2_Wave_index = 0;
+static int SPO2_Wave_len = SP_WARMUP_LEN; // ǰڳ
 static double peakThreshold = 0;
+static u8 s_ThresholdReady = 0; // һǰⲨ
 static int lastPeak_index = 0;
 static int currentPeak_index = 0;
 static int pulseRate = 0;
+static u32 SPO2_Sample_cnt = 0; // ѴĲʱ
 
 // ѪͶȼ
 static double arr_SPO2_Wave_RED[SP_WAVE_LEN] = {0};
@@ -94,22 +110,39 @@ static double peak2peak_IR = 0;
 static double value_R = 0;
 static double value_SPO2 = 0;
 static int rValue_buf[R_BUFSIZE] = {0};
+static int rValue_cnt = 0; // rValue_bufеЧ
 
 // Ѫ
 static u16 s_DACdata = 0;
 static int adjust_wait_cnt = 0; // ȴ
+static u8 s_DACHold = 0;        // 1-ֵֻдDACģʽעĲܸıLED
 
 // 
 static u8 s_SPO2_Connected = 0;	//0- 1-
 
+// ˲Ѱһ/Ԥõ̬
+static u8 s_FilterPrimed = 0;
+
+// ƽ˲ֵ״̬ļԱ ResetSPO2State ȫ
+static double SmoothRED_buf[SMOOTH_LEN] = {0};
+static int SmoothRED_cnt = 0;
+static double SmoothIR_buf[SMOOTH_LEN] = {0};
+static int SmoothIR_cnt = 0;
+static int Rate_buf[5] = {0};
+static int Rate_idx = 0;
+static int Rate_count = 0;
+
+// ¼ԷȰһڵĺСֵͷֵ
+static double s_PulseMin = 0;
+static double s_PulseP2P = 0;
+static StructBeatEvent s_structPulse;
+
 /*********************************************************************************************************
  *                                              ڲ
  *********************************************************************************************************/
 static void ConfigCSGPIO(void);
 
-/*inputź	arrtemp˲*/
-static double IIRLowpass(double input, double *arrtemp);
-static double IIRHighpass(double input, double *arrtemp);
+static double IIRSteadyState(double input, double *arrtemp, double *a, double *b);
 static double SmoothingFilter_RED(double NewData);
 static double SmoothingFilter_IR(double NewData);
 
@@ -145,103 +178,76 @@ static void ConfigCSGPIO(void)
 }
 
 /*********************************************************************************************************
- * ƣ˲ʵ
- * ܣ
- * void
- * void
- *   ֵvoid
- * ڣ20180101
- * ע    ⣺
+ * ƣIIRSteadyState
+ * ܣֱIIͶ׽ڵ״̬ΪΪinputʱֵ̬
+ * input-ֱ룬arrtemp-˲飬a/b-ĸ/ϵ
+ * arrtemp
+ *   ֵ̬inputֱ棩ֱԤһ
+ * ڣ20261017
+ * ע    ⣺0.3Hzͨȫ״̬ʱPPGֱ൱һԾҪ
  *********************************************************************************************************/
-static double IIRLowpass(double input, double *arrtemp)
-{
-	double output = 0;
-	int i = 0;
-
-	arrtemp[0] = input - IIRLowpass_a[1] * arrtemp[1] - IIRLowpass_a[2] * arrtemp[2]; // 
-	output = IIRLowpass_b[0] * arrtemp[0] + IIRLowpass_b[1] * arrtemp[1] + IIRLowpass_b[2] * arrtemp[2];
-
-	// ƶ˲
-	for (i = N; i > 0; i--)
-	{
-		arrtemp[i] = arrtemp[i - 1];
-	}
-
-	return output;
-}
-
-static double IIRHighpass(double input, double *arrtemp)
+static double IIRSteadyState(double input, double *arrtemp, double *a, double *b)
 {
-	double output = 0;
-	int i = 0;
+	double w = input / (a[0] + a[1] + a[2]);
 
-	arrtemp[0] = input - IIRHighpass_a[1] * arrtemp[1] - IIRHighpass_a[2] * arrtemp[2]; // 
-	output = IIRHighpass_b[0] * arrtemp[0] + IIRHighpass_b[1] * arrtemp[1] + IIRHighpass_b[2] * arrtemp[2];
+	arrtemp[0] = w;
+	arrtemp[1] = w;
+	arrtemp[2] = w;
 
-	// ƶ˲
-	for (i = N; i > 0; i--)
-	{
-		arrtemp[i] = arrtemp[i - 1];
-	}
-
-	return output;
+	return (b[0] + b[1] + b[2]) * w;
 }
 
-static double SmoothingFilter_RED(double NewData)
+static HOT_FUNC FORCE_INLINE double SmoothingFilter_RED(double NewData)
 {
 	int n = 0;
 	int num = 0;
-	static int i = 0;
-	static double buf[SMOOTH_LEN] = {0}; // ˲
 	// ݷ뻺
-	if (i < SMOOTH_LEN)
+	if (SmoothRED_cnt < SMOOTH_LEN)
 	{
-		buf[i] = NewData;
-		i++;
+		SmoothRED_buf[SmoothRED_cnt] = NewData;
+		SmoothRED_cnt++;
 		return NewData;
 	}
 	else
 	{
 		for (n = 0; n < SMOOTH_LEN - 1; n++) // 
 		{
-			buf[n] = buf[n + 1];
+			SmoothRED_buf[n] = SmoothRED_buf[n + 1];
 		}
-		buf[SMOOTH_LEN - 1] = NewData;
+		SmoothRED_buf[SMOOTH_LEN - 1] = NewData;
 
 		// ˲
 		for (n = 0; n < SMOOTH_LEN; n++)
 		{
-			num = num + buf[n];
+			num = num + SmoothRED_buf[n];
 		}
 		return (num * 1.0 / SMOOTH_LEN);
 	}
 }
 
-static double SmoothingFilter_IR(double NewData)
+static HOT_FUNC FORCE_INLINE double SmoothingFilter_IR(double NewData)
 {
 	int n = 0;
 	int num = 0;
-	static int i = 0;
-	static double buf[SMOOTH_LEN] = {0}; // ˲
 	// ݷ뻺
-	if (i < SMOOTH_LEN)
+	if (SmoothIR_cnt < SMOOTH_LEN)
 	{
-		buf[i] = NewData;
-		i++;
+		SmoothIR_buf[SmoothIR_cnt] = NewData;
+		SmoothIR_cnt++;
 		return NewData;
 	}
 	else
 	{
 		for (n = 0; n < SMOOTH_LEN - 1; n++) // 
 		{
-			buf[n] = buf[n + 1];
+			SmoothIR_buf[n] = SmoothIR_buf[n + 1];
 		}
-		buf[SMOOTH_LEN - 1] = NewData;
+		SmoothIR_buf[SMOOTH_LEN - 1] = NewData;
 
 		// ˲
 		for (n = 0; n < SMOOTH_LEN; n++)
 		{
-			num = num + buf[n];
+			num = num + SmoothIR_buf[n];
 		}
 		return (num * 1.0 / SMOOTH_LEN);
 	}
@@ -265,7 +271,7 @@ static double SmoothingFilter_IR(double NewData)
  *   ppRed_output - ֵ
  *   ppIR_output  - ֵ
  *********************************************************************************************************/
-static void Analyze_SPO2Wave(double *wave1, double *wave2, double *wave3, int waveSize, double *ppRed_output, double *ppIR_output)
+static HOT_FUNC void Analyze_SPO2Wave(double *wave1, double *wave2, double *wave3, int waveSize, double *ppRed_output, double *ppIR_output)
 {
 	int i; // ѭ
 	double wave1_max = 0.0;
@@ -296,6 +302,8 @@ static void Analyze_SPO2Wave(double *wave1, double *wave2, double *wave3, int wa
 	*ppRed_output = wave1_max - wave1_min;
 	*ppIR_output = wave2_max - wave2_min;
 	peakThreshold = wave3_max - (wave3_max - wave3_min) / 3;
+	s_PulseMin = wave3_min;
+	s_PulseP2P = wave3_max - wave3_min;
 }
 
 /*********************************************************************************************************
@@ -307,29 +315,26 @@ static void Analyze_SPO2Wave(double *wave1, double *wave2, double *wave3, int wa
  * ڣ20180101
  * ע    ⣺
  *********************************************************************************************************/
-static void calRate(double ppdistance, int *rate_output)
+static HOT_FUNC void calRate(double ppdistance, int *rate_output)
 {
-	static int arrRates[5] = {0};
-  static int idx = 0;
-  static int count = 0;
   int temp[5];
   int i, j;
   int currentRate;
 
   currentRate = (int)(60000.0 / ppdistance);
-  arrRates[idx] = currentRate;
-  idx = (idx + 1) % 5;
+  Rate_buf[Rate_idx] = currentRate;
+  Rate_idx = (Rate_idx + 1) % 5;
   
-  if(count < 5) count++;
+  if(Rate_count < 5) Rate_count++;
 
-  for(i = 0; i < count; i++)
+  for(i = 0; i < Rate_count; i++)
   {
-    temp[i] = arrRates[i];
+    temp[i] = Rate_buf[i];
   }
 
-  for(i = 0; i < count - 1; i++)
+  for(i = 0; i < Rate_count - 1; i++)
   {
-    for(j = 0; j < count - 1 - i; j++)
+    for(j = 0; j < Rate_count - 1 - i; j++)
     {
       if(temp[j] > temp[j + 1])
       {
@@ -340,8 +345,8 @@ static void calRate(double ppdistance, int *rate_output)
     }
   }
 
-  // ȡλ
-  *rate_output = temp[2];
+  // ȡλ5ʱȡֵλ
+  *rate_output = temp[(Rate_count - 1) / 2];
 }
 
 /*********************************************************************************************************
@@ -353,7 +358,7 @@ static void calRate(double ppdistance, int *rate_output)
  * ڣ20180101
  * ע    ⣺
  *********************************************************************************************************/
-static void bubbleSort(int *arr, int size)
+static HOT_FUNC void bubbleSort(int *arr, int size)
 {
 	int i, j;
 	for (i = 0; i < size - 1; i++)
@@ -379,7 +384,7 @@ static void bubbleSort(int *arr, int size)
  * ڣ20180101
  * ע    ⣺
  *********************************************************************************************************/
-static void calSpO2(double redPeak, double irPeak, double *rValue, double *spo2)
+static HOT_FUNC void calSpO2(double redPeak, double irPeak, double *rValue, double *spo2)
 {
 	int rInt = 0;
 	int i = 0;
@@ -394,22 +399,26 @@ static void calSpO2(double redPeak, double irPeak, double *rValue, double *spo2)
 		rValue_buf[i] = rValue_buf[i + 1];
 	}
 	rValue_buf[R_BUFSIZE - 1] = *rValue;
+	if (rValue_cnt < R_BUFSIZE)
+	{
+		rValue_cnt++;
+	}
 
-	// ʱ
-	for (i = 0; i < R_BUFSIZE; i++)
+	// ʱ׶ֻȡеRֵóֵ0ֵ99%
+	for (i = 0; i < rValue_cnt; i++)
 	{
-		tempBuf[i] = rValue_buf[i];
+		tempBuf[i] = rValue_buf[R_BUFSIZE - rValue_cnt + i];
 	}
-	bubbleSort(tempBuf, R_BUFSIZE);
+	bubbleSort(tempBuf, rValue_cnt);
 
 	// ȡмƽֵ
-	if (R_BUFSIZE % 2 == 0) // żԪ
+	if (rValue_cnt % 2 == 0) // żԪ
 	{
-		rInt = (tempBuf[R_BUFSIZE / 2] + tempBuf[R_BUFSIZE / 2 + 1]) / 2;
+		rInt = (tempBuf[rValue_cnt / 2 - 1] + tempBuf[rValue_cnt / 2]) / 2;
 	}
 	else // Ԫ
 	{
-		rInt = tempBuf[R_BUFSIZE / 2];
+		rInt = tempBuf[rValue_cnt / 2];
 	}
 
 	// ʹþ鹫ʽѪͶ(Rֵ)
@@ -545,14 +554,62 @@ static void calSpO2(double redPeak, double irPeak, double *rValue, double *spo2)
  * void
  *   ֵvoid
  * ڣ20180101
- * ע    ⣺
+ * ע    ⣺LEDֻڴһ
  *********************************************************************************************************/
 void InitSPO2(void)
 {
 	ConfigCSGPIO();
+	ResetSPO2State();
+}
+
+/*********************************************************************************************************
+ * ƣResetSPO2State
+ * ܣ㷨״ָ̬ϵ״̬
+ * void
+ * void
+ *   ֵvoid
+ * ڣ20261017
+ * ע    ⣺GPIODSPTestģʽʱ
+ *********************************************************************************************************/
+void ResetSPO2State(void)
+{
 	memset(IIRLowpass_win_RED, 0, sizeof(IIRLowpass_win_RED));
 	memset(IIRLowpass_win_IR, 0, sizeof(IIRLowpass_win_IR));
+	memset(IIRHighpass_win_RED, 0, sizeof(IIRHighpass_win_RED));
+	memset(IIRHighpass_win_IR, 0, sizeof(IIRHighpass_win_IR));
+	memset(rValue_buf, 0, sizeof(rValue_buf));
+	memset(arr_SPO2_Wave_Rate, 0, sizeof(arr_SPO2_Wave_Rate));
+	memset(arr_SPO2_Wave_RED, 0, sizeof(arr_SPO2_Wave_RED));
+	memset(arr_SPO2_Wave_IR, 0, sizeof(arr_SPO2_Wave_IR));
+	memset(SmoothRED_buf, 0, sizeof(SmoothRED_buf));
+	memset(SmoothIR_buf, 0, sizeof(SmoothIR_buf));
+	memset(Rate_buf, 0, sizeof(Rate_buf));
+	SPO2_Wave_data_RED = 0;
+	SPO2_Wave_data_IR = 0;
+	SPO2_Wave_index = 0;
+	SPO2_Wave_len = SP_WARMUP_LEN;
+	peakThreshold = 0;
+	s_ThresholdReady = 0;
+	s_FilterPrimed = 0;
+	lastPeak_index = 0;
+	currentPeak_index = 0;
+	pulseRate = 0;
+	peak2peak_RED = 0;
+	peak2peak_IR = 0;
+	value_R = 0;
+	value_SPO2 = 0;
+	rValue_cnt = 0;
+	SPO2_Sample_cnt = 0;
+	SmoothRED_cnt = 0;
+	SmoothIR_cnt = 0;
+	Rate_idx = 0;
+	Rate_count = 0;
+	adjust_wait_cnt = 0;
+	s_SPO2_Connected = 0;
 	s_DACdata = 240;
+	s_PulseMin = 0;
+	s_PulseP2P = 0;
+	InitBeatEvent(&s_structPulse, SPO2_PULSE_MAX_WAIT);
 }
 
 /*********************************************************************************************************
@@ -564,7 +621,7 @@ void InitSPO2(void)
  * ڣ20180101
  * ע    ⣺
  *********************************************************************************************************/
-void SPO2_LED_Task(void) // ÿ1msִһ
+HOT_FUNC void SPO2_LED_Task(void) // ÿ1msִһ
 {
 	// °ʼѪ
 	// 1msƷ
@@ -605,95 +662,192 @@ void SPO2_LED_Task(void) // ÿ1msִ
 	}
 }
 
-/*********************************************************************************************************
- * ƣSPO2Task
- * ܣѪģ鶥
- * void
- * void
- *   ֵvoid
- * ڣ20180101
- * ע    ⣺
- *********************************************************************************************************/
-int  SPO2Task(void) // ÿ8msִһ
+/* 鴦ģSPO2ProcessBlockSPO2TaskãSPO2ProcessBlock˵ */
+static HOT_FUNC FORCE_INLINE void SPO2Block(const u16 *pRed, const u16 *pIR, i16 *pOut, int num)
 {
-	double output0[2] = {0};
-	double output1[2] = {0};
-	double output2[2] = {0};
-
-	// ڼѪͶȵĲ
-	output0[0] = IIRHighpass(SPO2_Wave_data_RED, IIRHighpass_win_RED);
-	output0[1] = IIRHighpass(SPO2_Wave_data_IR, IIRHighpass_win_IR);
-	output1[0] = IIRLowpass(output0[0], IIRLowpass_win_RED);
-	output1[1] = IIRLowpass(output0[1], IIRLowpass_win_IR);
-	output2[0] = SmoothingFilter_RED(output1[0]);
-	output2[1] = SmoothingFilter_IR(output1[1]);
-
-	// ڼѪͶȺʵĲ
-	arr_SPO2_Wave_RED[SPO2_Wave_index] = output2[0];
-	arr_SPO2_Wave_IR[SPO2_Wave_index] = output2[1];
-	arr_SPO2_Wave_Rate[SPO2_Wave_index] = output2[1];
-	SPO2_Wave_index++;
-
-	// ɼ5s
-	if (SPO2_Wave_index >= SP_WAVE_LEN)
-	{
-		SPO2_Wave_index = 0;
-
-		// ȴڼ䲻͵
-		if (adjust_wait_cnt > 0)
-		{
-			adjust_wait_cnt--;
-		}
-		else
+	const double ha1 = IIRHighpass_a[1], ha2 = IIRHighpass_a[2];
+	const double hb0 = IIRHighpass_b[0], hb1 = IIRHighpass_b[1], hb2 = IIRHighpass_b[2];
+	const double la1 = IIRLowpass_a[1], la2 = IIRLowpass_a[2];
+	const double lb0 = IIRLowpass_b[0], lb1 = IIRLowpass_b[1], lb2 = IIRLowpass_b[2];
+	double hr1 = IIRHighpass_win_RED[1], hr2 = IIRHighpass_win_RED[2]; // ͨ״̬
+	double hi1 = IIRHighpass_win_IR[1], hi2 = IIRHighpass_win_IR[2];	 // ͨ״̬
+	double lr1 = IIRLowpass_win_RED[1], lr2 = IIRLowpass_win_RED[2];	 // ͨ״̬
+	double li1 = IIRLowpass_win_IR[1], li2 = IIRLowpass_win_IR[2];		 // ͨ״̬
+	double red;
+	double ir;
+	int i = 0;
+	int end;
+
+	while (i < num)
+	{
+		// ڷʱ
+		end = i + (SPO2_Wave_len - SPO2_Wave_index);
+		if (end > num)
+			end = num;
+
+		for (; i < end; i++)
 		{
-			// 
-			Analyze_SPO2Wave(arr_SPO2_Wave_RED, arr_SPO2_Wave_IR, arr_SPO2_Wave_Rate, SP_WAVE_LEN, &peak2peak_RED, &peak2peak_IR);
-			calSpO2(peak2peak_RED, peak2peak_IR, &value_R, &value_SPO2);
-			// 
-			if (peak2peak_RED > 20 && peak2peak_IR > 20)
+			if (!s_FilterPrimed && pRed[i] != 0 && pIR[i] != 0)
 			{
-				s_SPO2_Connected = 1;
+				IIRSteadyState(IIRSteadyState(pRed[i], IIRHighpass_win_RED, IIRHighpass_a, IIRHighpass_b),
+											 IIRLowpass_win_RED, IIRLowpass_a, IIRLowpass_b);
+				IIRSteadyState(IIRSteadyState(pIR[i], IIRHighpass_win_IR, IIRHighpass_a, IIRHighpass_b),
+											 IIRLowpass_win_IR, IIRLowpass_a, IIRLowpass_b);
+				hr1 = IIRHighpass_win_RED[1];
+				hr2 = IIRHighpass_win_RED[2];
+				hi1 = IIRHighpass_win_IR[1];
+				hi2 = IIRHighpass_win_IR[2];
+				lr1 = IIRLowpass_win_RED[1];
+				lr2 = IIRLowpass_win_RED[2];
+				li1 = IIRLowpass_win_IR[1];
+				li2 = IIRLowpass_win_IR[2];
+				s_FilterPrimed = 1;
 			}
-			else
+
+			// 0.3Hzͨ -> 3Hzͨ -> ֵ
+			BIQUAD_STEP(pRed[i], red, hr1, hr2, ha1, ha2, hb0, hb1, hb2);
+			BIQUAD_STEP(pIR[i], ir, hi1, hi2, ha1, ha2, hb0, hb1, hb2);
+			BIQUAD_STEP(red, red, lr1, lr2, la1, la2, lb0, lb1, lb2);
+			BIQUAD_STEP(ir, ir, li1, li2, la1, la2, lb0, lb1, lb2);
+			red = SmoothingFilter_RED(red);
+			ir = SmoothingFilter_IR(ir);
+			pOut[i] = (i16)ir;
+
+			// ڼѪͶȺʵĲ
+			arr_SPO2_Wave_RED[SPO2_Wave_index] = red;
+			arr_SPO2_Wave_IR[SPO2_Wave_index] = ir;
+			arr_SPO2_Wave_Rate[SPO2_Wave_index] = ir;
+			SPO2_Wave_index++;
+			SPO2_Sample_cnt++;
+
+			if (s_structPulse.armed)
 			{
-				s_SPO2_Connected = 0;
+				BeatEventTrack(&s_structPulse, ir, SPO2_Sample_cnt, s_PulseMin, s_PulseP2P);
 			}
-			// Զ
-			if (peak2peak_RED < 20 && s_DACdata < RED_INTENSITY_MAX)
+
+			// ʵʱⲨ壬һڷ㣬
+			if (s_ThresholdReady && (SPO2_Wave_index > 1) && (SPO2_Wave_index < SPO2_Wave_len - 1))
 			{
-				s_DACdata += RED_INTENSITY_STEP;
-				if (s_DACdata > RED_INTENSITY_MAX)
+				if ((arr_SPO2_Wave_Rate[SPO2_Wave_index - 2] - peakThreshold <= 0) && ((arr_SPO2_Wave_Rate[SPO2_Wave_index - 1] - peakThreshold) >= 0))
 				{
-					s_DACdata = RED_INTENSITY_MAX;
+					currentPeak_index = SPO2_Sample_cnt * SPO2_SAMPLE_MS;
+					if (lastPeak_index != 0) // һֻ¼ʱ
+					{
+						calRate(currentPeak_index - lastPeak_index, &pulseRate);
+					}
+					lastPeak_index = currentPeak_index;
+					BeatEventArm(&s_structPulse, ir, SPO2_Sample_cnt);
 				}
-				AdjustDAC(s_DACdata);
-				adjust_wait_cnt = ADJUST_STABLE_DELAY; // ȴ
 			}
-			else if (peak2peak_RED > 80 && s_DACdata > RED_INTENSITY_MIN)
+		}
+
+		// ɼһ
+		if (SPO2_Wave_index >= SPO2_Wave_len)
+		{
+			SPO2_Wave_index = 0;
+			// ȴڼ䲻͵
+			if (adjust_wait_cnt > 0)
 			{
-				s_DACdata -= RED_INTENSITY_STEP;
-				if (s_DACdata < RED_INTENSITY_MIN)
+				adjust_wait_cnt--;
+			}
+			else
+			{
+				// 
+				Analyze_SPO2Wave(arr_SPO2_Wave_RED, arr_SPO2_Wave_IR, arr_SPO2_Wave_Rate, SPO2_Wave_len, &peak2peak_RED, &peak2peak_IR);
+				s_ThresholdReady = 1;
+				calSpO2(peak2peak_RED, peak2peak_IR, &value_R, &value_SPO2);
+				// 
+				if (peak2peak_RED > 20 && peak2peak_IR > 20)
 				{
-					s_DACdata = RED_INTENSITY_MIN;
+					s_SPO2_Connected = 1;
+				}
+				else
+				{
+					s_SPO2_Connected = 0;
+				}
+				// Զ⣨ԤȴڿܲһڣֵƫСݴ˵⣩
+				if (SPO2_Wave_len < SP_WAVE_LEN)
+				{
+					SPO2_Wave_len = (SPO2_Wave_len * 2 < SP_WAVE_LEN) ? SPO2_Wave_len * 2 : SP_WAVE_LEN;
+				}
+				else if (peak2peak_RED < 20 && s_DACdata < RED_INTENSITY_MAX)
+				{
+					s_DACdata += RED_INTENSITY_STEP;
+					if (s_DACdata > RED_INTENSITY_MAX)
+					{
+						s_DACdata = RED_INTENSITY_MAX;
+					}
+					if (!s_DACHold)
+					{
+						AdjustDAC(s_DACdata);
+					}
+					adjust_wait_cnt = ADJUST_STABLE_DELAY; // ȴ
+				}
+				else if (peak2peak_RED > 80 && s_DACdata > RED_INTENSITY_MIN)
+				{
+					s_DACdata -= RED_INTENSITY_STEP;
+					if (s_DACdata < RED_INTENSITY_MIN)
+					{
+						s_DACdata = RED_INTENSITY_MIN;
+					}
+					if (!s_DACHold)
+					{
+						AdjustDAC(s_DACdata);
+					}
+					adjust_wait_cnt = ADJUST_STABLE_DELAY; // ȴ
 				}
-				AdjustDAC(s_DACdata);
-				adjust_wait_cnt = ADJUST_STABLE_DELAY; // ȴ
 			}
 		}
 	}
 
-	// ʵʱⲨ
-	if ((SPO2_Wave_index > 1) && (SPO2_Wave_index < SP_WAVE_LEN - 1))
-	{
-		if ((arr_SPO2_Wave_Rate[SPO2_Wave_index - 2] - peakThreshold <= 0) && ((arr_SPO2_Wave_Rate[SPO2_Wave_index - 1] - peakThreshold) >= 0))
-		{
-			currentPeak_index = GetTimeCounter();
-			calRate(currentPeak_index - lastPeak_index, &pulseRate);
-			lastPeak_index = currentPeak_index;
-		}
-	}
+	IIRHighpass_win_RED[0] = hr1;
+	IIRHighpass_win_RED[1] = hr1;
+	IIRHighpass_win_RED[2] = hr2;
+	IIRHighpass_win_IR[0] = hi1;
+	IIRHighpass_win_IR[1] = hi1;
+	IIRHighpass_win_IR[2] = hi2;
+	IIRLowpass_win_RED[0] = lr1;
+	IIRLowpass_win_RED[1] = lr1;
+	IIRLowpass_win_RED[2] = lr2;
+	IIRLowpass_win_IR[0] = li1;
+	IIRLowpass_win_IR[1] = li1;
+	IIRLowpass_win_IR[2] = li2;
+}
+
+/*********************************************************************************************************
+ * ƣSPO2ProcessBlock
+ * ܣnum/˲ڷѪ㡢Զʼ
+ * pRed/pIR-/ADCnum-
+ * pOut-˲ĺⲨΣSPO2TaskķֵӦ
+ *   ֵvoid
+ * ڣ20261017
+ * ע    ⣺ĸ׽ڵ״̬ϵڿڱھֲУʱдأжÿһΣ
+ *           ͺⶼɵֵԤ˲̬ڴSP_WARMUP_LENʼμӱ
+ *           δȫʱֻѪ͵״̬Զ⣻ʱ䰴šSPO2_SAMPLE_MS
+ *********************************************************************************************************/
+HOT_FUNC void SPO2ProcessBlock(const u16 *pRed, const u16 *pIR, i16 *pOut, int num)
+{
+	SPO2Block(pRed, pIR, pOut, num);
+}
 
-	return (int)output2[1];
+/*********************************************************************************************************
+ * ƣSPO2Task
+ * ܣѪģ鶥
+ * void
+ * void
+ *   ֵ˲ĺⲨֵ
+ * ڣ20180101
+ * ע    ⣺SPO2_LED_Taskɵһ/ȼnumΪ1SPO2ProcessBlock
+ *********************************************************************************************************/
+HOT_FUNC int  SPO2Task(void) // ÿ8msִһ
+{
+	u16 red = (u16)SPO2_Wave_data_RED;
+	u16 ir = (u16)SPO2_Wave_data_IR;
+	i16 out;
+
+	SPO2Block(&red, &ir, &out, 1);
+
+	return out;
 }
 
 /*********************************************************************************************************
@@ -710,6 +864,20 @@ u16   SPO2GetSPO2Value(void)
 	return (u16)value_SPO2;
 }
 
+/*********************************************************************************************************
+ * ƣSPO2GetPulseEvent
+ * ܣȡһȷϵ¼
+ * void
+ * pEvent-嶥ĲšȷʱĲšԷȺŶ
+ *   ֵTRUE-¼FALSE-û
+ * ڣ20261017
+ * ע    ⣺к浽嶥SPO2_PULSE_MAX_WAITȷ
+ *********************************************************************************************************/
+u8 SPO2GetPulseEvent(StructBeatEvent *pEvent)
+{
+	return BeatEventGet(&s_structPulse, pEvent);
+}
+
 
 /*********************************************************************************************************
  * ƣSPO2GetLeadStatus
@@ -725,6 +893,25 @@ u8   SPO2GetLeadStatus(void)
 	return (u8)s_SPO2_Connected;
 }
 
+/*********************************************************************************************************
+ * ƣSPO2HoldDAC
+ * ܣָͣԶDACд
+ * hold-TRUEͣFALSEָ
+ * void
+ *   ֵvoid
+ * ڣ20261017
+ * ע    ⣺ͣڼֵճ㣬㷨Ӱ죻ָʱDACдΪǰֵ
+ *           ʹӲs_DACdataһ£֮ĵ𼶵
+ *********************************************************************************************************/
+void SPO2HoldDAC(u8 hold)
+{
+	s_DACHold = hold;
+	if (!hold)
+	{
+		AdjustDAC(s_DACdata);
+	}
+}
+
 /*********************************************************************************************************
  * ƣOLED_SPO2
  * ܣOLEDʾѪϢ
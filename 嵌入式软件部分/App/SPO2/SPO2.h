@@ -21,6 +21,7 @@
 *********************************************************************************************************/
 #include "DataType.h"
 #include "Main.h"
+#include "BeatEvent.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -35,10 +36,14 @@ extern WaveMode_t g_displayMode;
 *                                              API
 *********************************************************************************************************/
 void  InitSPO2(void);        //ʼSPO2ģ
+void  ResetSPO2State(void);  //㷨״ָ̬ϵ״̬Ӳ
 void	SPO2_LED_Task(void);	 //SPO2Ѫ
+void SPO2ProcessBlock(const u16 *pRed, const u16 *pIR, i16 *pOut, int num); //num/
 int  SPO2Task(void);        //SPO2ʵʱ
 u16   SPO2GetSPO2Value(void);   //ȡѪͶ
+u8    SPO2GetPulseEvent(StructBeatEvent *pEvent); //ȡһ¼
 u8   SPO2GetLeadStatus(void);  //ȡ״̬
+void  SPO2HoldDAC(u8 hold);   //ͣ/ָԶдDACָʱDACͬΪǰֵ
 void  OLED_SPO2(void);	//OLEDʾѪϢ
 
 #endif
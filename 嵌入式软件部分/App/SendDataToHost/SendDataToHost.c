@@ -32,34 +32,84 @@
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
- 
+static  u32 s_iDropPackNum = 0;   //ͻռ䲻ʧܶݰ
+
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
-static  void  SendPackToHost(StructPackType* pPackSent);  //ݣݷ͵
+static  u8    PackToSendBuf(u8 moduleId, u8 secondId, const u8* pData);   //ͻδύ0
+static  u8    SendPackToHost(u8 moduleId, u8 secondId, const u8* pData);  //ݣݷ͵
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
+/*********************************************************************************************************
+* ƣPackToSendBuf
+* ܣݲύڷͻ
+* moduleId-ģIDsecondId-IDpData-6
+* void
+*   ֵ0-ͻʣռ䲻һʧܣδύκݣ1-ύͻ
+* ڣ20180101
+* ע    ⣺ݰֱӴڷͻԤУԤԽĩβʱջϴٷο
+*********************************************************************************************************/
+static HOT_FUNC u8 PackToSendBuf(u8 moduleId, u8 secondId, const u8* pData)
+{
+  StructQueSpan span;           //ͻеԤ
+  u8  arrPack[PACK_LEN];        //Ԥʱʱ
+  u8  packValid = 0;            //ȷ־λĬֵΪ0
+  u8  i;
+
+  if(0 == ReserveUART1(&span, PACK_LEN))
+  {
+    return 0;
+  }
+
+  if(span.spanLen[0] == PACK_LEN)
+  {
+    packValid = PackDataToBuf(moduleId, secondId, pData, span.pSpan[0]);
+  }
+  else
+  {
+    packValid = PackDataToBuf(moduleId, secondId, pData, arrPack);
+    for(i = 0; i < PACK_LEN; i++)
+    {
+      if(i < span.spanLen[0])
+      {
+        span.pSpan[0][i] = arrPack[i];
+      }
+      else
+      {
+        span.pSpan[1][i - span.spanLen[0]] = arrPack[i];
+      }
+    }
+  }
+
+  if(0 < packValid)             //ȷ
+  {
+    CommitUART1(PACK_LEN);      //ύͻ
+  }
+
+  return packValid;
+}
+
 /*********************************************************************************************************
 * ƣSendPackToHost
 * ܣݣݷ͵
-* pPackSentָṹĵַ
+* moduleId-ģIDsecondId-IDpData-6
 * void
-*   ֵvoid
+*   ֵ1-ύͻ0-Ѷ
 * ڣ20180101
-* ע    ⣺
+* ע    ⣺ͻʣռ䲻һʧʱضϵİ
 *********************************************************************************************************/
-static  void  SendPackToHost(StructPackType* pPackSent)
+static HOT_FUNC u8 SendPackToHost(u8 moduleId, u8 secondId, const u8* pData)
 {
-  u8  packValid = 0;  //ȷ־λĬֵΪ0
-
-  packValid = PackData(pPackSent);  //
-  
-  if(0 < packValid)                 //ȷ
+  if(0 == PackToSendBuf(moduleId, secondId, pData))
   {
-    WriteUART1((u8*)pPackSent, 10); //дݵ
+    s_iDropPackNum++;
+    return 0;
   }
+
+  return 1;
 }
 
 /*********************************************************************************************************
@@ -90,18 +140,16 @@ void  InitSendDataToHost(void)
 *********************************************************************************************************/
 void SendAckPack(u8 moduleId, u8 secondId, u8 ackMsg)
 {
-  StructPackType pt;  //ṹ
-
-  pt.packModuleId = MODULE_SYS;   //ϵͳϢģģID
-  pt.packSecondId = DAT_CMD_ACK;  //ϵͳϢģĶID
-  pt.arrData[0] = moduleId; //ģID       
-  pt.arrData[1] = secondId; //ID
-  pt.arrData[2] = ackMsg;   //ӦϢ
-  pt.arrData[3] = 0;  //
-  pt.arrData[4] = 0;  //
-  pt.arrData[5] = 0;  //
-
-  SendPackToHost(&pt);//ݣݷ͵
+  u8 arrData[PACK_DATA_LEN];  //
+
+  arrData[0] = moduleId; //ģID
+  arrData[1] = secondId; //ID
+  arrData[2] = ackMsg;   //ӦϢ
+  arrData[3] = 0;  //
+  arrData[4] = 0;  //
+  arrData[5] = 0;  //
+
+  SendPackToHost(MODULE_SYS, DAT_CMD_ACK, arrData);//ݣݷ͵
 }
 
 /*********************************************************************************************************
@@ -115,18 +163,8 @@ void SendAckPack(u8 moduleId, u8 secondId, u8 ackMsg)
 *********************************************************************************************************/
 void  SendWavePackHost(u8* pWaveData)
 {
-  StructPackType  pt; //ṹ
-  
-  pt.packModuleId = MODULE_WAVE;    //ģģID
-  pt.packSecondId = ID2_WAVE; //ģĶID
-  pt.arrData[0] = pWaveData[0]; //ĵݸλ
-  pt.arrData[1] = pWaveData[1]; //ĵݵλ
-  pt.arrData[2] = pWaveData[2]; //ݸλ
-  pt.arrData[3] = pWaveData[3]; //ݵλ
-  pt.arrData[4] = pWaveData[4]; //SPO2ݸλ
-  pt.arrData[5] = pWaveData[5]; //SPO2ݵλ
-
-  SendPackToHost(&pt);  //ݣݷ͵
+  //ĵ硢SPO2ݣΪλǰ2ֽ
+  SendPackToHost(MODULE_WAVE, ID2_WAVE, pWaveData);  //ݣݷ͵
 }
 
 /*********************************************************************************************************
@@ -140,18 +178,8 @@ void  SendWavePackHost(u8* pWaveData)
 *********************************************************************************************************/
 void  SendParamPackHost(u8* pParamData)
 {
-  StructPackType  pt; //ṹ
-  
-  pt.packModuleId = MODULE_PARAM;    //ģģID
-  pt.packSecondId = ID2_PARAM;  //ģĶID
-  pt.arrData[0] = pParamData[0]; //ʸλ
-  pt.arrData[1] = pParamData[1]; //ʵλ
-  pt.arrData[2] = pParamData[2]; //ʸλ
-  pt.arrData[3] = pParamData[3]; //ʵλ
-  pt.arrData[4] = pParamData[4]; //SPO2λ
-  pt.arrData[5] = pParamData[5]; //SPO2λ
-
-  SendPackToHost(&pt);  //ݣݷ͵
+  //ʡʡSPO2Ϊλǰ2ֽ
+  SendPackToHost(MODULE_PARAM, ID2_PARAM, pParamData);  //ݣݷ͵
 }
 
 
@@ -160,22 +188,99 @@ void  SendParamPackHost(u8* pParamData)
 * ܣʹõ״̬ݰ
 * pStatusData-״̬ݴŵĵַ
 * void
-*   ֵvoid
+*   ֵ1-ύͻ0-ͻ
 * ڣ20180101
 * ע    ⣺
 *********************************************************************************************************/
-void  SendStatusPackHost(u8* pStatusData)
+u8    SendStatusPackHost(u8* pStatusData)
 {
-  StructPackType  pt; //ṹ
-  
-  pt.packModuleId = MODULE_STATUS;    //״̬ģģID
-  pt.packSecondId = ID2_STATUS;  //״̬ģĶID
-  pt.arrData[0] = pStatusData[0]; //ECG״̬      0-䣬1-
-  pt.arrData[1] = pStatusData[1]; //ECG쳣״̬   0-ޱ1-ʹ߱2-ʹͱ
-  pt.arrData[2] = pStatusData[2]; //RESP״̬     0-䣬1-
-  pt.arrData[3] = pStatusData[3]; //RESP쳣״̬  0-ޱ1-ʹ߱2-ʹͱ
-  pt.arrData[4] = pStatusData[4]; //SPO2״̬     0-1-쳣
-  pt.arrData[5] = pStatusData[5]; //SPO2쳣״̬  0-ޱ1-SPO2߱2-SPO2ͱ
-
-  SendPackToHost(&pt);  //ݣݷ͵
+  //[0]ECG״̬     0-䣬1-
+  //[1]ECG쳣״̬  0-ޱ1-ʹ߱2-ʹͱ
+  //[2]RESP״̬    0-䣬1-
+  //[3]RESP쳣״̬ 0-ޱ1-ʹ߱2-ʹͱ
+  //[4]SPO2״̬    0-1-쳣
+  //[5]SPO2쳣״̬ 0-ޱ1-SPO2߱2-SPO2ͱ
+  return SendPackToHost(MODULE_STATUS, ID2_STATUS, pStatusData);  //ݣݷ͵
+}
+
+/*********************************************************************************************************
+* ƣSendBootTimePackHost
+* ܣ׶ʱ
+* phase-׶ΣEnumBootPhasetimeUs-SysTick΢
+* void
+*   ֵ1-ύͻ0-ͻԺط
+* ڣ20261017
+* ע    ⣺ϵȷMODULE_SYSݴͳƿ׸׸Чʱ
+*********************************************************************************************************/
+u8    SendBootTimePackHost(u8 phase, u32 timeUs)
+{
+  u8 arrData[PACK_DATA_LEN];  //
+
+  arrData[0] = phase;                 //׶
+  arrData[1] = 0;                     //
+  arrData[2] = (u8)(timeUs >> 24);    //ʱֽǰ
+  arrData[3] = (u8)(timeUs >> 16);
+  arrData[4] = (u8)(timeUs >> 8);
+  arrData[5] = (u8)(timeUs);
+
+  return SendPackToHost(MODULE_SYS, DAT_SYS_TIME, arrData);  //ݣݷ͵
+}
+
+/*********************************************************************************************************
+* ƣSendEventPackHost
+* ܣĲ//¼
+* secondId-ID2_EVENT_QRSID2_EVENT_BREATHID2_EVENT_PULSEsampleIdx-嶥Ĳţ
+*           lag-嶥ȷʱĲamplitude-Էȣ%confidence-Ŷ0100
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ֻ24λ¼ȷϲĲΰ֮ѱǻ²֮ǰlag
+*********************************************************************************************************/
+void  SendEventPackHost(u8 secondId, u32 sampleIdx, u8 lag, u8 amplitude, u8 confidence)
+{
+  u8 arrData[PACK_DATA_LEN];  //
+
+  arrData[0] = (u8)(sampleIdx >> 16); //ţֽǰ
+  arrData[1] = (u8)(sampleIdx >> 8);
+  arrData[2] = (u8)(sampleIdx);
+  arrData[3] = lag;                   //嶥ȷʱĲ
+  arrData[4] = amplitude;             //Է
+  arrData[5] = confidence;            //Ŷ
+
+  SendPackToHost(MODULE_PARAM, secondId, arrData);  //ݣݷ͵
+}
+
+/*********************************************************************************************************
+* ƣSendTestPackHost
+* ܣӲڻݰ
+* secondId-IDEnumTestSecondIDpData-6
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺Ҫλȶԣܶͻʱȴжȡݺд롣
+*           ֻȴռ䣬Ԥı״̬ʧ뻺״̬޹أԣ
+*********************************************************************************************************/
+void  SendTestPackHost(u8 secondId, const u8* pData)
+{
+  StructQueSpan span;           //ֻڵȴͻճһ
+
+  while(0 == ReserveUART1(&span, PACK_LEN))
+  {
+  }
+
+  SendPackToHost(MODULE_TEST, secondId, pData);
+}
+
+/*********************************************************************************************************
+* ƣGetSendDropPackNum
+* ܣȡͻռ䲻ʧܶݰ
+* void
+* void
+*   ֵݰ
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+u32 GetSendDropPackNum(void)
+{
+  return s_iDropPackNum;
 }
@@ -37,7 +37,11 @@ void  SendAckPack(u8 moduleId, u8 secondId, u8 ackMsg); //
 
 void  SendWavePackHost(u8* pWaveData);    //Ͳݰ
 void  SendParamPackHost(u8* pParamData);    //Ͳݰ
-void  SendStatusPackHost(u8* pStatusData);    //״̬ݰ
+u8    SendStatusPackHost(u8* pStatusData);    //״̬ݰʱ0
+u8    SendBootTimePackHost(u8 phase, u32 timeUs);  //׶ʱʱ0
+void  SendEventPackHost(u8 secondId, u32 sampleIdx, u8 lag, u8 amplitude, u8 confidence); //Ĳ//¼
+void  SendTestPackHost(u8 secondId, const u8* pData); //Ӳڻݰʱȴ
+u32   GetSendDropPackNum(void);    //ȡͻʧܶݰ
 
 #endif
 
@@ -0,0 +1,295 @@
+/*********************************************************************************************************
+* 模块名称：BenchHAL.c
+* 文件说明：基准测试用硬件抽象桩
+*           以虚拟 1ms 时钟和内存中的 ADC 帧替代真实外设，GPIO 只记录输出电平
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "stm32f10x_conf.h"
+#include "math.h"
+#include "BenchHAL.h"
+#include "ADC.h"
+#include "DAC.h"
+#include "OLED.h"
+#include "Timer.h"
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#define BENCH_PI        3.14159265358979
+#define BENCH_FS        250.0   // 帧采样率（Hz）
+#define BENCH_HR_BPM    75.0    // 合成心率
+#define BENCH_RR_BPM    15.0    // 合成呼吸率
+#define BENCH_DARK_CODE 120     // 两灯均熄灭时的光电暗电流码值
+
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+static u32 s_iBenchMs = 0;                          // 虚拟 1ms 时钟
+static u16 s_arrFrame[BENCH_FRAME_CHANNELS] = {0};  // 当前帧输入
+static u16 s_iGPIOAOut = 0;                         // GPIOA 输出电平
+static u16 s_iGPIOBOut = 0;                         // GPIOB 输出电平
+static u8  s_iLeadOff = 0;                          // PB0 输入电平（1-导联脱落）
+static u16 s_iDACValue = 0;                         // 最近一次调光值
+
+/*********************************************************************************************************
+*                                           内部函数声明
+*********************************************************************************************************/
+static u16  *GetOutputReg(GPIO_TypeDef* GPIOx);     // 获取端口对应的输出电平记录
+static double GaussPulse(double t, double mu, double sigma);
+
+/*********************************************************************************************************
+*                                           内部函数实现
+*********************************************************************************************************/
+static u16 *GetOutputReg(GPIO_TypeDef* GPIOx)
+{
+  if(GPIOx == GPIOA)
+  {
+    return &s_iGPIOAOut;
+  }
+  if(GPIOx == GPIOB)
+  {
+    return &s_iGPIOBOut;
+  }
+  return NULL;
+}
+
+static double GaussPulse(double t, double mu, double sigma)
+{
+  double d = (t - mu) / sigma;
+  return exp(-0.5 * d * d);
+}
+
+/*********************************************************************************************************
+*                                           外设接口桩
+*********************************************************************************************************/
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState)
+{
+  (void)RCC_APB2Periph;
+  (void)NewState;
+}
+
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct)
+{
+  (void)GPIOx;
+  (void)GPIO_InitStruct;
+}
+
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  u16 *pReg = GetOutputReg(GPIOx);
+  if(pReg != NULL)
+  {
+    *pReg |= GPIO_Pin;
+  }
+}
+
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  u16 *pReg = GetOutputReg(GPIOx);
+  if(pReg != NULL)
+  {
+    *pReg &= (u16)~GPIO_Pin;
+  }
+}
+
+void GPIO_WriteBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, BitAction BitVal)
+{
+  if(BitVal != Bit_RESET)
+  {
+    GPIO_SetBits(GPIOx, GPIO_Pin);
+  }
+  else
+  {
+    GPIO_ResetBits(GPIOx, GPIO_Pin);
+  }
+}
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  if(GPIOx == GPIOB && GPIO_Pin == GPIO_Pin_0)
+  {
+    return s_iLeadOff;
+  }
+  return 0;
+}
+
+u32 GetTimeCounter(void)
+{
+  return s_iBenchMs;
+}
+
+u16 ReadECGADC(void)
+{
+  return s_arrFrame[BENCH_CH_ECG];
+}
+
+u16 ReadRESPADC(void)
+{
+  return s_arrFrame[BENCH_CH_RESP];
+}
+
+/* 光电通道只有一路，按当前点亮的 LED 返回对应帧数据 */
+u16 ReadSPO2ADC(void)
+{
+  if(s_iGPIOAOut & GPIO_Pin_5)
+  {
+    return s_arrFrame[BENCH_CH_RED];
+  }
+  if(s_iGPIOAOut & GPIO_Pin_6)
+  {
+    return s_arrFrame[BENCH_CH_IR];
+  }
+  return BENCH_DARK_CODE;
+}
+
+void AdjustDAC(u16 dacData)
+{
+  s_iDACValue = dacData;
+}
+
+void OLEDShowString(u8 x, u8 y, const u8* p)
+{
+  (void)x;
+  (void)y;
+  (void)p;
+}
+
+void OLEDShowNum(u8 x, u8 y, u32 num, u8 len, u8 size)
+{
+  (void)x;
+  (void)y;
+  (void)num;
+  (void)len;
+  (void)size;
+}
+
+/*********************************************************************************************************
+*                                           API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：BenchHALReset
+* 函数功能：复位虚拟时钟、GPIO 输出记录与 ADC 输入
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void BenchHALReset(void)
+{
+  u32 i;
+
+  s_iBenchMs  = 0;
+  s_iGPIOAOut = 0;
+  s_iGPIOBOut = 0;
+  s_iLeadOff  = 0;
+  s_iDACValue = 0;
+
+  for(i = 0; i < BENCH_FRAME_CHANNELS; i++)
+  {
+    s_arrFrame[i] = 0;
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchHALSetFrame
+* 函数功能：设置当前帧的 4 路 ADC 输入
+* 输入参数：pFrame-ECG、RESP、RED、IR 四路码值
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void BenchHALSetFrame(const u16* pFrame)
+{
+  u32 i;
+
+  for(i = 0; i < BENCH_FRAME_CHANNELS; i++)
+  {
+    s_arrFrame[i] = pFrame[i];
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchHALAdvanceMs
+* 函数功能：推进虚拟 1ms 时钟
+* 输入参数：ms-推进的毫秒数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void BenchHALAdvanceMs(u32 ms)
+{
+  s_iBenchMs += ms;
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchHALSetLeadOff
+* 函数功能：设置 ECG 导联脱落引脚（PB0）电平
+* 输入参数：off-1 表示导联脱落
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void BenchHALSetLeadOff(u8 off)
+{
+  s_iLeadOff = (u8)(off ? 1 : 0);
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchHALGetDACValue
+* 函数功能：获取最近一次 AdjustDAC 写入值
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：调光 DAC 值
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+u16 BenchHALGetDACValue(void)
+{
+  return s_iDACValue;
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchSynthFrame
+* 函数功能：生成第 index 帧合成数据
+* 输入参数：index-帧序号（250Hz）
+* 输出参数：pFrame-ECG、RESP、RED、IR 四路码值
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：ECG 为 75bpm 的 QRS/T 波叠加 50Hz 工频干扰，RESP 为 15bpm 正弦，RED/IR 为同步脉搏波
+*********************************************************************************************************/
+void BenchSynthFrame(u32 index, u16* pFrame)
+{
+  double t     = index / BENCH_FS;
+  double beat  = 60.0 / BENCH_HR_BPM;
+  double phase = fmod(t, beat);
+  double ecg;
+  double resp;
+  double pulse;
+
+  ecg  = 2048.0;
+  ecg += 700.0 * GaussPulse(phase, 0.20, 0.012);    // R 波
+  ecg -= 90.0  * GaussPulse(phase, 0.17, 0.010);    // Q 波
+  ecg -= 120.0 * GaussPulse(phase, 0.23, 0.010);    // S 波
+  ecg += 160.0 * GaussPulse(phase, 0.45, 0.040);    // T 波
+  ecg += 30.0  * sin(2.0 * BENCH_PI * 50.0 * t);    // 工频干扰
+  ecg += 80.0  * sin(2.0 * BENCH_PI * 0.2 * t);     // 基线漂移
+
+  resp = 2048.0 + 900.0 * sin(2.0 * BENCH_PI * (BENCH_RR_BPM / 60.0) * t);
+
+  pulse = GaussPulse(phase, 0.30, 0.08) + 0.35 * GaussPulse(phase, 0.55, 0.06);
+
+  pFrame[BENCH_CH_ECG]  = (u16)ecg;
+  pFrame[BENCH_CH_RESP] = (u16)resp;
+  pFrame[BENCH_CH_RED]  = (u16)(1800.0 - 60.0 * pulse);
+  pFrame[BENCH_CH_IR]   = (u16)(2100.0 - 100.0 * pulse);
+}
@@ -0,0 +1,53 @@
+/*********************************************************************************************************
+* 模块名称：BenchHAL.h
+* 文件说明：基准测试用硬件抽象桩
+*           替代 StdPeriph/ADC/DAC/OLED/Timer 的外设接口，使 App 下的 DSP 模块可脱离目标板运行
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：仅参与 Bench 构建，Keil 工程不包含本目录
+*********************************************************************************************************/
+#ifndef _BENCH_HAL_H_
+#define _BENCH_HAL_H_
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#define BENCH_SAMPLE_PERIOD_MS  4   // 主循环处理周期（Proc2msTask 每 4ms 调用一次 DSP）
+#define BENCH_FRAME_CHANNELS    4   // 每帧通道数：ECG、RESP、RED、IR
+
+/*
+ * 录制数据文件格式（*.raw）：
+ * 无文件头，按 250Hz 连续存放帧，每帧 4 个小端 u16（ECG、RESP、RED、IR），取值为 12 位 ADC 码值
+ */
+
+/*********************************************************************************************************
+*                                           枚举结构体定义
+*********************************************************************************************************/
+typedef enum
+{
+  BENCH_CH_ECG = 0,
+  BENCH_CH_RESP,
+  BENCH_CH_RED,
+  BENCH_CH_IR
+}EnumBenchChannel;
+
+/*********************************************************************************************************
+*                                           API函数声明
+*********************************************************************************************************/
+void  BenchHALReset(void);                     //复位虚拟时钟、GPIO 与 ADC 输入
+void  BenchHALSetFrame(const u16* pFrame);     //设置当前帧的 4 路 ADC 输入
+void  BenchHALAdvanceMs(u32 ms);               //推进虚拟 1ms 时钟
+void  BenchHALSetLeadOff(u8 off);              //设置 ECG 导联脱落引脚（PB0）电平
+u16   BenchHALGetDACValue(void);               //获取最近一次 AdjustDAC 写入值
+
+void  BenchSynthFrame(u32 index, u16* pFrame); //生成第 index 帧合成数据
+
+u32   BenchUARTDrain(void);                    //模拟发送中断取空 UART1 发送队列（BenchUART.c）
+
+#endif
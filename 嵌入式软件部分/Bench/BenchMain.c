@@ -0,0 +1,409 @@
+/*********************************************************************************************************
+* 模块名称：BenchMain.c
+* 文件说明：DSP 实时代价基准测试入口
+*           按主循环的调用顺序将录制或合成数据逐帧送入 SPO2_LED_Task/ECGTask/RESPTask/SPO2Task，
+*           并把三路输出经 SendWavePackHost 打包写入 UART1 发送队列，
+*           统计每帧每个任务的耗时分布，并以 JSON 行输出，供 run_qemu_bench.py 判定回归
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：用法 TriVitalBench [-n 帧数] [录制文件.raw]，不给文件时使用合成数据；
+*           TriVitalBench -b 对合成数据比较块处理接口在块长 1/4/16/64 下每个采样的耗时
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DataType.h"
+#include "BenchHAL.h"
+#include "BenchPort.h"
+#include "ECG.h"
+#include "RESP.h"
+#include "SPO2.h"
+#include "ADC.h"
+#include "UART1.h"
+#include "PackUnpack.h"
+#include "SendDataToHost.h"
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#define BENCH_MAX_SAMPLES     15000   // 最大帧数（60s）
+#define BENCH_DEFAULT_SAMPLES 7500    // 默认帧数（30s）
+#define BENCH_CALIB_ROUNDS    64      // 计时开销标定次数
+#define BENCH_BLOCK_FRAMES    7680    // 块处理基准的帧数（约 30s，64 的整数倍）
+#define BENCH_BLOCK_SIZES     4       // 块长个数，见 s_arrBlockSize
+
+/*********************************************************************************************************
+*                                           枚举结构体定义
+*********************************************************************************************************/
+typedef enum
+{
+  BENCH_TASK_SPO2_LED = 0,  // 4 次 1ms 中断调用之和
+  BENCH_TASK_ECG,
+  BENCH_TASK_RESP,
+  BENCH_TASK_SPO2,
+  BENCH_TASK_SEND,          // SendWavePackHost：打包并写入发送队列
+  BENCH_TASK_NUM
+}EnumBenchTask;
+
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+static const char* s_arrTaskName[BENCH_TASK_NUM] = {"SPO2_LED_Task", "ECGTask", "RESPTask", "SPO2Task", "SendWavePackHost"};
+
+static u32 s_arrTicks[BENCH_TASK_NUM][BENCH_MAX_SAMPLES];
+static u32 s_arrCycles[BENCH_TASK_NUM][BENCH_MAX_SAMPLES];
+
+static const int s_arrBlockSize[BENCH_BLOCK_SIZES] = {1, 4, 16, 64};
+static u16 s_arrBlockIn[BENCH_FRAME_CHANNELS][BENCH_BLOCK_FRAMES];   // 合成输入，按通道连续存放
+static i16 s_arrBlockOut[BENCH_BLOCK_FRAMES];
+
+static u32 s_iTickOverhead  = 0;
+static u32 s_iCycleOverhead = 0;
+
+/* 基准测试不链接 Main.c，这里提供 DSP 模块引用的全局显示模式 */
+WaveMode_t g_displayMode = WAVE_ECG;
+
+/*********************************************************************************************************
+*                                           内部函数声明
+*********************************************************************************************************/
+static void  Calibrate(void);
+static u32   ReadFrame(FILE* fp, u16* pFrame);
+static u32   ReadFrames(FILE* fp, u32 maxNum);
+static void  RunFrame(u32 index, const u16* pFrame);
+static int   CompareU32(const void* a, const void* b);
+static char* FormatU64(unsigned long long v, char* pBuf);
+static void  ReportTask(u32 task, u32 num);
+static void  RunBlockBench(void);
+
+/*********************************************************************************************************
+*                                           内部函数实现
+*********************************************************************************************************/
+/* 取空测量的最小值作为计时自身开销 */
+static void Calibrate(void)
+{
+  u32 i;
+  u32 t0, t1, c0, c1;
+  u32 minTick  = BENCH_TICK_MASK;
+  u32 minCycle = 0xFFFFFFFFu;
+
+  for(i = 0; i < BENCH_CALIB_ROUNDS; i++)
+  {
+    c0 = BenchPortCycles();
+    t0 = BenchPortTicks();
+    t1 = BenchPortTicks();
+    c1 = BenchPortCycles();
+
+    if(BENCH_TICK_DIFF(t0, t1) < minTick)
+    {
+      minTick = BENCH_TICK_DIFF(t0, t1);
+    }
+    if(c1 - c0 < minCycle)
+    {
+      minCycle = c1 - c0;
+    }
+  }
+
+  s_iTickOverhead  = minTick;
+  s_iCycleOverhead = BenchPortHasCycles() ? minCycle : 0;
+}
+
+/* 录制文件只在计时窗口之外读取，半主机文件读写不计入结果 */
+static u32 ReadFrame(FILE* fp, u16* pFrame)
+{
+  u8  raw[BENCH_FRAME_CHANNELS * 2];
+  u32 i;
+
+  if(fread(raw, 1, sizeof(raw), fp) != sizeof(raw))
+  {
+    return 0;
+  }
+  for(i = 0; i < BENCH_FRAME_CHANNELS; i++)
+  {
+    pFrame[i] = (u16)(raw[2 * i] | (raw[2 * i + 1] << 8));
+  }
+  return 1;
+}
+
+static u32 ReadFrames(FILE* fp, u32 maxNum)
+{
+  u16 frame[BENCH_FRAME_CHANNELS];
+  u32 num = 0;
+
+  while(num < maxNum)
+  {
+    if(fp != NULL)
+    {
+      if(!ReadFrame(fp, frame))
+      {
+        break;
+      }
+    }
+    else
+    {
+      BenchSynthFrame(num, frame);
+    }
+
+    RunFrame(num, frame);
+    num++;
+  }
+  return num;
+}
+
+#define BENCH_MEASURE(task, index, call)                                       \
+  do                                                                           \
+  {                                                                            \
+    u32 c0_, c1_, t0_, t1_;                                                    \
+    c0_ = BenchPortCycles();                                                   \
+    t0_ = BenchPortTicks();                                                    \
+    call;                                                                      \
+    t1_ = BenchPortTicks();                                                    \
+    c1_ = BenchPortCycles();                                                   \
+    t1_ = BENCH_TICK_DIFF(t0_, t1_);                                           \
+    c1_ = c1_ - c0_;                                                           \
+    s_arrTicks[task][index]  += (t1_ > s_iTickOverhead) ? (t1_ - s_iTickOverhead) : 0;   \
+    s_arrCycles[task][index] += (c1_ > s_iCycleOverhead) ? (c1_ - s_iCycleOverhead) : 0; \
+  }while(0)
+
+/* 与 Main.c 一致：1ms 节拍调用 SPO2_LED_Task，Proc2msTask 每 4ms 依次调用三个 DSP 任务并发送波形包 */
+static void RunFrame(u32 index, const u16* pFrame)
+{
+  u32 ms;
+  int ecg  = 0;
+  int resp = 0;
+  int spo2 = 0;
+  u8  wave[6];
+
+  BenchHALSetFrame(pFrame);
+
+  for(ms = 0; ms < BENCH_SAMPLE_PERIOD_MS; ms++)
+  {
+    BenchHALAdvanceMs(1);
+    BENCH_MEASURE(BENCH_TASK_SPO2_LED, index, SPO2_LED_Task());
+  }
+
+  BENCH_MEASURE(BENCH_TASK_ECG,  index, ecg = ECGTask(ReadECGADC()));
+  BENCH_MEASURE(BENCH_TASK_RESP, index, resp = RESPTask(ReadRESPADC()));
+  BENCH_MEASURE(BENCH_TASK_SPO2, index, spo2 = SPO2Task());
+
+  wave[0] = (u8)(ecg >> 8);
+  wave[1] = (u8)(ecg & 0xFF);
+  wave[2] = (u8)(resp >> 8);
+  wave[3] = (u8)(resp & 0xFF);
+  wave[4] = (u8)(spo2 >> 8);
+  wave[5] = (u8)(spo2 & 0xFF);
+  BENCH_MEASURE(BENCH_TASK_SEND, index, SendWavePackHost(wave));
+
+  /* 4ms 内 115200bps 可发出约 46 字节，足以送完一包，这里直接取空队列 */
+  BenchUARTDrain();
+}
+
+static int CompareU32(const void* a, const void* b)
+{
+  u32 x = *(const u32*)a;
+  u32 y = *(const u32*)b;
+  return (x > y) - (x < y);
+}
+
+/* 半主机环境下 printf 对 64 位整数支持不一，统一自行格式化 */
+static char* FormatU64(unsigned long long v, char* pBuf)
+{
+  char tmp[24];
+  int  n = 0;
+  int  i = 0;
+
+  do
+  {
+    tmp[n++] = (char)('0' + (int)(v % 10));
+    v /= 10;
+  }while(v != 0);
+
+  while(n > 0)
+  {
+    pBuf[i++] = tmp[--n];
+  }
+  pBuf[i] = '\0';
+  return pBuf;
+}
+
+static void ReportTask(u32 task, u32 num)
+{
+  unsigned long long tickSum  = 0;
+  unsigned long long cycleSum = 0;
+  char bufTick[24];
+  char bufCycle[24];
+  u32  i;
+  u32 *pTicks  = s_arrTicks[task];
+  u32 *pCycles = s_arrCycles[task];
+
+  for(i = 0; i < num; i++)
+  {
+    tickSum  += pTicks[i];
+    cycleSum += pCycles[i];
+  }
+
+  qsort(pTicks, num, sizeof(u32), CompareU32);
+  qsort(pCycles, num, sizeof(u32), CompareU32);
+
+  printf("{\"bench\":\"dsp\",\"task\":\"%s\",\"timebase\":\"%s\",\"samples\":%u,"
+         "\"overhead\":%u,\"sum\":%s,\"min\":%u,\"p50\":%u,\"p99\":%u,\"max\":%u",
+         s_arrTaskName[task], BenchPortTimebase(), (unsigned)num, (unsigned)s_iTickOverhead,
+         FormatU64(tickSum, bufTick), (unsigned)pTicks[0], (unsigned)pTicks[num / 2],
+         (unsigned)pTicks[(num * 99) / 100], (unsigned)pTicks[num - 1]);
+
+  if(BenchPortHasCycles())
+  {
+    printf(",\"cyc_sum\":%s,\"cyc_p50\":%u,\"cyc_p99\":%u,\"cyc_max\":%u",
+           FormatU64(cycleSum, bufCycle), (unsigned)pCycles[num / 2],
+           (unsigned)pCycles[(num * 99) / 100], (unsigned)pCycles[num - 1]);
+  }
+  printf("}\n");
+}
+
+/* 每次块调用单独计时后累加，避免 Cortex-M3 上 24 位 SysTick 回绕；输出每个采样的平均计时值 ×10 */
+static void RunBlockBench(void)
+{
+  unsigned long long arrSum[3];
+  char buf[3][24];
+  u16  frame[BENCH_FRAME_CHANNELS];
+  u32  t0, t1;
+  u32  task;
+  int  size;
+  int  i;
+  int  j;
+
+  for(i = 0; i < BENCH_BLOCK_FRAMES; i++)
+  {
+    BenchSynthFrame((u32)i, frame);
+    for(j = 0; j < BENCH_FRAME_CHANNELS; j++)
+    {
+      s_arrBlockIn[j][i] = frame[j];
+    }
+  }
+
+  for(j = 0; j < BENCH_BLOCK_SIZES; j++)
+  {
+    size = s_arrBlockSize[j];
+    BenchHALReset();
+    InitECG();
+    InitRESP();
+    InitSPO2();
+
+    for(task = 0; task < 3; task++)
+    {
+      arrSum[task] = 0;
+      for(i = 0; i < BENCH_BLOCK_FRAMES; i += size)
+      {
+        t0 = BenchPortTicks();
+        if(task == 0)
+        {
+          ECGProcessBlock(&s_arrBlockIn[0][i], &s_arrBlockOut[i], size);
+        }
+        else if(task == 1)
+        {
+          RESPProcessBlock(&s_arrBlockIn[1][i], &s_arrBlockOut[i], size);
+        }
+        else
+        {
+          SPO2ProcessBlock(&s_arrBlockIn[2][i], &s_arrBlockIn[3][i], &s_arrBlockOut[i], size);
+        }
+        t1 = BENCH_TICK_DIFF(t0, BenchPortTicks());
+        arrSum[task] += (t1 > s_iTickOverhead) ? (t1 - s_iTickOverhead) : 0;
+      }
+      arrSum[task] = arrSum[task] * 10 / BENCH_BLOCK_FRAMES;
+    }
+
+    printf("{\"bench\":\"block\",\"block\":%d,\"timebase\":\"%s\",\"samples\":%d,"
+           "\"ecg_x10\":%s,\"resp_x10\":%s,\"spo2_x10\":%s}\n",
+           size, BenchPortTimebase(), BENCH_BLOCK_FRAMES,
+           FormatU64(arrSum[0], buf[0]), FormatU64(arrSum[1], buf[1]), FormatU64(arrSum[2], buf[2]));
+  }
+}
+
+/*********************************************************************************************************
+* 函数名称：main
+* 函数功能：基准测试入口
+* 输入参数：argc/argv-可选 "-n 帧数" 与录制文件路径，或 "-b" 运行块处理基准
+* 输出参数：void
+* 返 回 值：0-成功，1-参数或文件错误
+* 创建日期：2026年10月17日
+* 注    意：QEMU 下参数经半主机 SYS_GET_CMDLINE 传入
+*********************************************************************************************************/
+int main(int argc, char* argv[])
+{
+  FILE* fp     = NULL;
+  u32   maxNum = BENCH_DEFAULT_SAMPLES;
+  u32   num;
+  u32   task;
+  int   i;
+
+  for(i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "-b") == 0)
+    {
+      BenchPortInit();
+      Calibrate();
+      RunBlockBench();
+      return 0;
+    }
+    else if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+    {
+      maxNum = (u32)strtoul(argv[++i], NULL, 10);
+      if(maxNum == 0 || maxNum > BENCH_MAX_SAMPLES)
+      {
+        maxNum = BENCH_MAX_SAMPLES;
+      }
+    }
+    else
+    {
+      fp = fopen(argv[i], "rb");
+      if(fp == NULL)
+      {
+        printf("{\"bench\":\"error\",\"msg\":\"cannot open %s\"}\n", argv[i]);
+        return 1;
+      }
+    }
+  }
+
+  BenchPortInit();
+  BenchHALReset();
+  InitECG();
+  InitRESP();
+  InitSPO2();
+  InitUART1(115200);
+  InitPackUnpack();
+  InitSendDataToHost();
+
+  memset(s_arrTicks, 0, sizeof(s_arrTicks));
+  memset(s_arrCycles, 0, sizeof(s_arrCycles));
+  Calibrate();
+
+  num = ReadFrames(fp, maxNum);
+  if(fp != NULL)
+  {
+    fclose(fp);
+  }
+  if(num == 0)
+  {
+    printf("{\"bench\":\"error\",\"msg\":\"no frames\"}\n");
+    return 1;
+  }
+
+  printf("{\"bench\":\"result\",\"source\":\"%s\",\"samples\":%u,\"hr\":%u,\"rr\":%u,\"spo2\":%u,"
+         "\"ecg_lead\":%u,\"resp_lead\":%u,\"spo2_lead\":%u,\"dac\":%u}\n",
+         fp != NULL ? "file" : "synthetic", (unsigned)num,
+         (unsigned)ECGGetHeartRate(), (unsigned)RESPGetRespRate(), (unsigned)SPO2GetSPO2Value(),
+         (unsigned)ECGGetLeadStatus(), (unsigned)RESPGetLeadStatus(), (unsigned)SPO2GetLeadStatus(),
+         (unsigned)BenchHALGetDACValue());
+
+  for(task = 0; task < BENCH_TASK_NUM; task++)
+  {
+    ReportTask(task, num);
+  }
+
+  return 0;
+}
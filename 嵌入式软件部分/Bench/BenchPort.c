@@ -0,0 +1,141 @@
+/*********************************************************************************************************
+* 模块名称：BenchPort.c
+* 文件说明：基准测试计时端口
+*           Cortex-M3 上 SysTick 以处理器时钟自由运行，QEMU 的 -icount 模式下可换算为指令数；
+*           DWT_CYCCNT 在真实芯片上给出精确周期数，QEMU 未实现时读数恒为 0，由 BenchPortHasCycles 判断
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "BenchPort.h"
+
+#if !defined(__arm__)
+#include <time.h>
+#endif
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#if defined(__arm__)
+#define SYST_CSR      (*(volatile u32*)0xE000E010)  // SysTick 控制与状态
+#define SYST_RVR      (*(volatile u32*)0xE000E014)  // SysTick 重装载值
+#define SYST_CVR      (*(volatile u32*)0xE000E018)  // SysTick 当前值
+#define DEMCR         (*(volatile u32*)0xE000EDFC)  // 调试异常与监控控制
+#define DWT_CTRL      (*(volatile u32*)0xE0001000)  // DWT 控制
+#define DWT_CYCCNT    (*(volatile u32*)0xE0001004)  // DWT 周期计数
+
+#define DEMCR_TRCENA  (1u << 24)
+#define DWT_CYCCNTENA (1u << 0)
+#endif
+
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+static u8 s_iHasCycles = 0;
+
+/*********************************************************************************************************
+*                                           API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：BenchPortInit
+* 函数功能：初始化计时源
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：SysTick 不开中断，仅作自由运行计数
+*********************************************************************************************************/
+void BenchPortInit(void)
+{
+#if defined(__arm__)
+  u32 probe;
+
+  SYST_CSR = 0;
+  SYST_RVR = BENCH_TICK_MASK;
+  SYST_CVR = 0;
+  SYST_CSR = (1u << 2) | (1u << 0);  // 处理器时钟，使能计数
+
+  DEMCR     |= DEMCR_TRCENA;
+  DWT_CYCCNT = 0;
+  DWT_CTRL  |= DWT_CYCCNTENA;
+
+  probe = DWT_CYCCNT;
+  s_iHasCycles = (u8)(DWT_CYCCNT != probe);
+#else
+  s_iHasCycles = 0;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchPortTicks
+* 函数功能：读取递增的计时值
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：Cortex-M3 为 SysTick 计数（向上换算），主机为纳秒
+* 创建日期：2026年10月17日
+* 注    意：差值须使用 BENCH_TICK_DIFF 计算
+*********************************************************************************************************/
+u32 BenchPortTicks(void)
+{
+#if defined(__arm__)
+  return (~SYST_CVR) & BENCH_TICK_MASK;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u32)((u32)ts.tv_sec * 1000000000u + (u32)ts.tv_nsec);
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchPortCycles
+* 函数功能：读取 DWT 周期计数
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：周期计数，不支持时返回 0
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+u32 BenchPortCycles(void)
+{
+#if defined(__arm__)
+  return DWT_CYCCNT;
+#else
+  return 0;
+#endif
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchPortHasCycles
+* 函数功能：DWT 周期计数是否可用
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：1-可用，0-不可用
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+u8 BenchPortHasCycles(void)
+{
+  return s_iHasCycles;
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchPortTimebase
+* 函数功能：计时单位名称
+* 输入参数：void
+* 输出参数：void
+* 返 回 值："systick" 或 "ns"
+* 创建日期：2026年10月17日
+* 注    意：run_qemu_bench.py 依据该字段换算指令数
+*********************************************************************************************************/
+const char* BenchPortTimebase(void)
+{
+#if defined(__arm__)
+  return "systick";
+#else
+  return "ns";
+#endif
+}
@@ -0,0 +1,38 @@
+/*********************************************************************************************************
+* 模块名称：BenchPort.h
+* 文件说明：基准测试计时端口
+*           Cortex-M3 上使用 SysTick（24 位）与 DWT 周期计数器，主机上使用单调时钟（ns）
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+*********************************************************************************************************/
+#ifndef _BENCH_PORT_H_
+#define _BENCH_PORT_H_
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#if defined(__arm__)
+  #define BENCH_TICK_MASK   0x00FFFFFFu   // SysTick 为 24 位计数器
+#else
+  #define BENCH_TICK_MASK   0xFFFFFFFFu
+#endif
+
+/* 计算两次采样间的增量，自动处理回绕 */
+#define BENCH_TICK_DIFF(start, end)  (((end) - (start)) & BENCH_TICK_MASK)
+
+/*********************************************************************************************************
+*                                           API函数声明
+*********************************************************************************************************/
+void        BenchPortInit(void);       //初始化计时源
+u32         BenchPortTicks(void);      //读取递增的计时值
+u32         BenchPortCycles(void);     //读取 DWT 周期计数，不支持时返回 0
+u8          BenchPortHasCycles(void);  //DWT 周期计数是否可用
+const char* BenchPortTimebase(void);   //计时单位名称，写入结果 JSON
+
+#endif
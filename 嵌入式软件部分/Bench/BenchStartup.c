@@ -0,0 +1,68 @@
+/*********************************************************************************************************
+* 模块名称：BenchStartup.c
+* 文件说明：QEMU mps2-an385（Cortex-M3）基准测试启动文件
+*           向量表只保留内核异常，复位后进入 newlib（rdimon）的 _start 完成 .data/.bss 初始化与半主机参数获取
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：仅用于 arm-none-eabi-gcc 交叉构建的 Bench 目标
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#define SEMIHOST_SYS_EXIT          0x18
+#define SEMIHOST_RUNTIME_ERROR     0x20023   // ADP_Stopped_RunTimeErrorUnknown
+
+/*********************************************************************************************************
+*                                           内部函数声明
+*********************************************************************************************************/
+extern void _start(void);           // newlib crt0
+extern u32  __StackTop;             // 链接脚本提供
+
+static void BenchFaultHandler(void);
+
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+__attribute__((section(".isr_vector"), used))
+static void (* const s_arrVectors[16])(void) =
+{
+  (void (*)(void))&__StackTop,      // 初始栈顶
+  _start,                           // Reset
+  BenchFaultHandler,                // NMI
+  BenchFaultHandler,                // HardFault
+  BenchFaultHandler,                // MemManage
+  BenchFaultHandler,                // BusFault
+  BenchFaultHandler,                // UsageFault
+  0, 0, 0, 0,                       // 保留
+  BenchFaultHandler,                // SVCall
+  BenchFaultHandler,                // DebugMon
+  0,                                // 保留
+  BenchFaultHandler,                // PendSV
+  BenchFaultHandler                 // SysTick（基准测试不开中断，进入即异常）
+};
+
+/*********************************************************************************************************
+*                                           内部函数实现
+*********************************************************************************************************/
+/* 任何异常都以失败码退出 QEMU，避免 runner 等待超时 */
+static void BenchFaultHandler(void)
+{
+  __asm volatile(
+    "mov r0, %0 \n"
+    "ldr r1, =%1 \n"
+    "bkpt 0xab  \n"
+    :
+    : "i"(SEMIHOST_SYS_EXIT), "i"(SEMIHOST_RUNTIME_ERROR)
+    : "r0", "r1");
+
+  while(1)
+  {
+  }
+}
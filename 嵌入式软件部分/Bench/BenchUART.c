@@ -0,0 +1,122 @@
+/*********************************************************************************************************
+* 模块名称：BenchUART.c
+* 文件说明：基准测试用 UART1 桩
+*           以 HW/UART1/Queue.c 的发送/接收循环队列实现 UART1.h 的接口，发送中断由 BenchUARTDrain 模拟，
+*           使 SendDataToHost/PackUnpack 的打包与入队路径可以在基准测试中计时
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：UART1.c 中的中断服务函数直接访问 NVIC 寄存器，无法在主机或 QEMU 上运行，故以本文件替代；
+*           队列操作与 UART1.c 保持一致
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "UART1.h"
+#include "Queue.h"
+#include "BenchHAL.h"
+
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+static StructCirQue s_structUARTSendCirQue;   // 发送循环队列
+static StructCirQue s_structUARTRecCirQue;    // 接收循环队列
+static u8  s_arrSendBuf[UART1_BUF_SIZE];      // 发送循环队列的缓冲区
+static u8  s_arrRecBuf[UART1_BUF_SIZE];       // 接收循环队列的缓冲区
+
+/*********************************************************************************************************
+*                                           API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：InitUART1
+* 函数功能：初始化发送与接收队列
+* 输入参数：bound-波特率，桩中不使用
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void InitUART1(u32 bound)
+{
+  (void)bound;
+  InitQueue(&s_structUARTSendCirQue, s_arrSendBuf, UART1_BUF_SIZE);
+  InitQueue(&s_structUARTRecCirQue,  s_arrRecBuf,  UART1_BUF_SIZE);
+}
+
+/*********************************************************************************************************
+* 函数名称：WriteUART1
+* 函数功能：写数据到发送队列
+* 输入参数：pBuf-数据首地址，len-期望写入的个数
+* 输出参数：void
+* 返 回 值：成功写入的个数
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+u8 WriteUART1(u8 *pBuf, u8 len)
+{
+  return (u8)EnQueue(&s_structUARTSendCirQue, pBuf, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：ReadUART1
+* 函数功能：从接收队列读取数据
+* 输入参数：pBuf-存放地址，len-期望读取的个数
+* 输出参数：pBuf-读取的数据
+* 返 回 值：成功读取的个数
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+u8 ReadUART1(u8 *pBuf, u8 len)
+{
+  return (u8)DeQueue(&s_structUARTRecCirQue, pBuf, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：ReserveUART1
+* 函数功能：在发送队列中预留len个字节的写入区
+* 输入参数：len-需要预留的字节数
+* 输出参数：pSpan-预留的写入区
+* 返 回 值：预留成功返回len，空间不足返回0
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+u8 ReserveUART1(StructQueSpan* pSpan, u8 len)
+{
+  return (u8)ReserveQueue(&s_structUARTSendCirQue, pSpan, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：CommitUART1
+* 函数功能：提交预留区中已写入的len个字节
+* 输入参数：len-已写入的字节数
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void CommitUART1(u8 len)
+{
+  CommitQueue(&s_structUARTSendCirQue, len);
+}
+
+/*********************************************************************************************************
+* 函数名称：BenchUARTDrain
+* 函数功能：模拟发送中断，逐字节取空发送队列
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：取出的字节数
+* 创建日期：2026年10月17日
+* 注    意：在计时窗口之外调用
+*********************************************************************************************************/
+u32 BenchUARTDrain(void)
+{
+  u8  uData;
+  u32 num = 0;
+
+  while(DeQueue(&s_structUARTSendCirQue, &uData, 1))
+  {
+    num++;
+  }
+  return num;
+}
@@ -0,0 +1,115 @@
+/*********************************************************************************************************
+* 模块名称：DSPReplay.c
+* 文件说明：离线回放实现
+*           帧时序与 BenchMain.c 的 RunFrame 相同，只是不计时，直接读取各模块的参数输出
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "DataType.h"
+#include "BenchHAL.h"
+#include "DSPReplay.h"
+#include "ECG.h"
+#include "RESP.h"
+#include "SPO2.h"
+#include "ADC.h"
+
+/*********************************************************************************************************
+*                                           内部变量
+*********************************************************************************************************/
+static u32 s_iFrameCount = 0;   // 自复位以来回放的帧数，跨多次 DSPReplayRun 调用保持输出间隔
+
+/* 回放库不链接 Main.c，这里提供 DSP 模块引用的全局显示模式 */
+WaveMode_t g_displayMode = WAVE_ECG;
+
+/*********************************************************************************************************
+*                                           内部函数声明
+*********************************************************************************************************/
+static void ReplayFrame(const u16* pFrame);
+
+/*********************************************************************************************************
+*                                           内部函数实现
+*********************************************************************************************************/
+/* 与 Main.c 一致：1ms 节拍调用 SPO2_LED_Task，Proc2msTask 每 4ms 依次调用三个 DSP 任务 */
+static void ReplayFrame(const u16* pFrame)
+{
+  u32 ms;
+
+  BenchHALSetFrame(pFrame);
+
+  for(ms = 0; ms < BENCH_SAMPLE_PERIOD_MS; ms++)
+  {
+    BenchHALAdvanceMs(1);
+    SPO2_LED_Task();
+  }
+
+  ECGTask(ReadECGADC());
+  RESPTask(ReadRESPADC());
+  SPO2Task();
+}
+
+/*********************************************************************************************************
+*                                           API函数实现
+*********************************************************************************************************/
+/*********************************************************************************************************
+* 函数名称：DSPReplayReset
+* 函数功能：复位虚拟外设并初始化 DSP 模块
+* 输入参数：void
+* 输出参数：void
+* 返 回 值：void
+* 创建日期：2026年10月17日
+* 注    意：
+*********************************************************************************************************/
+void DSPReplayReset(void)
+{
+  BenchHALReset();
+  InitECG();
+  InitRESP();
+  InitSPO2();
+  s_iFrameCount = 0;
+}
+
+/*********************************************************************************************************
+* 函数名称：DSPReplayRun
+* 函数功能：回放 num 帧录制数据，每 stride 帧记录一次参数输出
+* 输入参数：pFrames-num 帧 ADC 码值，每帧 BENCH_FRAME_CHANNELS 个 u16
+*           num-帧数
+*           stride-输出间隔（帧），250 即每秒一点
+* 输出参数：pOut-输出点，每点 DSP_REPLAY_FIELDS 个 u16，调用方至少预留 num / stride + 1 点
+* 返 回 值：本次写入的点数
+* 创建日期：2026年10月17日
+* 注    意：输出点取在第 stride、2*stride... 帧处理完之后，可分块多次调用
+*********************************************************************************************************/
+u32 DSPReplayRun(const u16* pFrames, u32 num, u32 stride, u16* pOut)
+{
+  u32 i;
+  u32 points = 0;
+
+  if(stride == 0)
+  {
+    return 0;
+  }
+
+  for(i = 0; i < num; i++)
+  {
+    ReplayFrame(&pFrames[i * BENCH_FRAME_CHANNELS]);
+    s_iFrameCount++;
+
+    if(s_iFrameCount % stride == 0)
+    {
+      pOut[DSP_REPLAY_HR]   = ECGGetHeartRate();
+      pOut[DSP_REPLAY_RR]   = RESPGetRespRate();
+      pOut[DSP_REPLAY_SPO2] = SPO2GetSPO2Value();
+      pOut[DSP_REPLAY_LEAD] = (u16)((ECGGetLeadStatus() ? 1 : 0) | (RESPGetLeadStatus() ? 2 : 0) |
+                                    (SPO2GetLeadStatus() ? 4 : 0));
+      pOut += DSP_REPLAY_FIELDS;
+      points++;
+    }
+  }
+  return points;
+}
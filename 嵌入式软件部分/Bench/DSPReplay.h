@@ -0,0 +1,42 @@
+/*********************************************************************************************************
+* 模块名称：DSPReplay.h
+* 文件说明：离线回放接口
+*           将录制的 ADC 帧按主循环时序送入 App 下的 DSP 模块，按固定帧间隔输出心率/呼吸率/血氧，
+*           编译为主机共享库供 Bench/reprocess.py 通过 ctypes 调用
+* 当前版本：1.0.0
+* 作    者：Chill
+* 完成日期：2026-10-17
+* 注意事项：DSP 模块的滤波器状态都是文件作用域的静态变量，由 Init 全部清零，
+*           每条录制回放前调用 DSPReplayReset 即可，同一进程可依次回放多条录制
+*********************************************************************************************************/
+#ifndef _DSP_REPLAY_H_
+#define _DSP_REPLAY_H_
+
+/*********************************************************************************************************
+*                                           头文件包含
+*********************************************************************************************************/
+#include "DataType.h"
+
+/*********************************************************************************************************
+*                                           宏定义
+*********************************************************************************************************/
+#define DSP_REPLAY_FIELDS   4   // 每个输出点的字段数，见 EnumDSPReplayField
+
+/*********************************************************************************************************
+*                                           枚举结构体定义
+*********************************************************************************************************/
+typedef enum
+{
+  DSP_REPLAY_HR = 0,    // ECGGetHeartRate
+  DSP_REPLAY_RR,        // RESPGetRespRate
+  DSP_REPLAY_SPO2,      // SPO2GetSPO2Value
+  DSP_REPLAY_LEAD       // 导联状态位：ECG | RESP<<1 | SPO2<<2，置位表示导联正常
+}EnumDSPReplayField;
+
+/*********************************************************************************************************
+*                                           API函数声明
+*********************************************************************************************************/
+void  DSPReplayReset(void);                                             //复位虚拟外设并初始化 DSP 模块
+u32   DSPReplayRun(const u16* pFrames, u32 num, u32 stride, u16* pOut); //回放 num 帧，每 stride 帧输出一点
+
+#endif
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Compare firmware builds by size and DSP cost and recommend one for production.
+
+Sizes come from the Keil linker map ("Total ROM/RW Size" lines) and from
+arm-none-eabi-size for GCC ELFs. DSP cost comes from run_qemu_bench.py reports
+attached with --bench NAME=report.json (the cost of one 4 ms frame, summed over
+all tasks, in instructions or DWT cycles).
+
+    python Bench/compare_builds.py \
+        --keil-map Project/Listings/STM32KeilPrj.map \
+        --gcc Os=build-os/TriVitalMonitor.elf --gcc O2=build-o2/TriVitalMonitor.elf \
+        --bench Os=bench-os.json --bench O2=bench-o2.json
+"""
+import argparse
+import json
+import re
+import subprocess
+import sys
+
+FLASH_LIMIT = 256 * 1024
+RAM_LIMIT = 48 * 1024
+COST_TIE = 0.02   # within 2% the smaller image wins
+
+
+def keil_sizes(path):
+    with open(path, encoding="latin-1") as f:
+        text = f.read()
+    rom = re.search(r"Total ROM Size \(Code \+ RO Data \+ RW Data\)\s+(\d+)", text)
+    rw = re.search(r"Total RW\s+Size \(RW Data \+ ZI Data\)\s+(\d+)", text)
+    if not rom or not rw:
+        raise ValueError("%s: no 'Total ROM/RW Size' lines, is this a Keil .map?" % path)
+    return {"flash": int(rom.group(1)), "ram": int(rw.group(1))}
+
+
+def gcc_sizes(path, size_tool):
+    out = subprocess.run([size_tool, "-B", path], stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    text, data, bss = (int(v) for v in out.splitlines()[1].split()[:3])
+    return {"flash": text + data, "ram": data + bss}
+
+
+def frame_cost(report):
+    tasks = report.get("tasks", {})
+    for key, unit in (("cyc_mean", "cycles"), ("insn_mean", "insn"), ("ns_mean", "ns")):
+        if tasks and all(key in t for t in tasks.values()):
+            return sum(t[key] for t in tasks.values()), unit
+    return None, None
+
+
+def split_pair(text):
+    if "=" not in text:
+        raise argparse.ArgumentTypeError("expected NAME=PATH, got %r" % text)
+    return tuple(text.split("=", 1))
+
+
+def recommend(builds):
+    fitting = [b for b in builds if b["flash"] <= FLASH_LIMIT and b["ram"] <= RAM_LIMIT]
+    if not fitting:
+        return None, "no build fits 256KB flash / 48KB RAM"
+
+    costed = [b for b in fitting if b.get("cost") is not None]
+    units = {b["cost_unit"] for b in costed}
+    if len(costed) >= 2 and len(units) == 1:
+        best = min(b["cost"] for b in costed)
+        close = [b for b in costed if b["cost"] <= best * (1 + COST_TIE)]
+        pick = min(close, key=lambda b: b["flash"])
+        return pick, "lowest DSP cost per frame (ties within %d%% go to the smaller image)" % (COST_TIE * 100)
+
+    pick = min(fitting, key=lambda b: b["flash"])
+    return pick, "smallest image (DSP cost not comparable across builds)"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--keil-map", help="Keil linker map of the reference build")
+    parser.add_argument("--gcc", action="append", type=split_pair, default=[], metavar="NAME=ELF")
+    parser.add_argument("--bench", action="append", type=split_pair, default=[], metavar="NAME=JSON",
+                        help="benchmark report for a build (use NAME=keil for the Keil build)")
+    parser.add_argument("--size-tool", default="arm-none-eabi-size")
+    parser.add_argument("--out", help="write the comparison as JSON")
+    args = parser.parse_args()
+
+    builds = []
+    if args.keil_map:
+        builds.append(dict(name="keil", **keil_sizes(args.keil_map)))
+    for name, elf in args.gcc:
+        builds.append(dict(name=name, **gcc_sizes(elf, args.size_tool)))
+    if not builds:
+        parser.error("nothing to compare")
+
+    reports = dict(args.bench)
+    for b in builds:
+        if b["name"] in reports:
+            with open(reports[b["name"]], encoding="utf-8") as f:
+                b["cost"], b["cost_unit"] = frame_cost(json.load(f))
+
+    ref = builds[0]
+    print("%-8s %10s %8s %8s %14s %8s" % ("build", "flash", "d_flash", "ram", "cost/frame", "d_cost"))
+    for b in builds:
+        d_flash = (b["flash"] - ref["flash"]) / ref["flash"] * 100
+        cost = "-" if b.get("cost") is None else "%.0f %s" % (b["cost"], b["cost_unit"])
+        d_cost = "-"
+        if b.get("cost") is not None and ref.get("cost") and b["cost_unit"] == ref["cost_unit"]:
+            d_cost = "%+.1f%%" % ((b["cost"] - ref["cost"]) / ref["cost"] * 100)
+        print("%-8s %10d %+7.1f%% %8d %14s %8s" % (b["name"], b["flash"], d_flash, b["ram"], cost, d_cost))
+
+    pick, reason = recommend(builds)
+    print()
+    print("production: %s (%s)" % (pick["name"] if pick else "none", reason))
+
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as f:
+            json.dump({"builds": builds, "production": pick["name"] if pick else None, "reason": reason}, f, indent=2)
+    return 0 if pick else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+"""Hardware-in-the-loop DSP benchmark over UART1.
+
+The firmware's test mode (App/DSPTest, MODULE_TEST 0x13 in PackUnpack.h) takes
+ECG/RESP/RED/IR samples from the host instead of the ADC. Once a block of
+samples has arrived it runs ECGProcessBlock, RESPProcessBlock and
+SPO2ProcessBlock back to back, timing each with the DWT cycle counter, and
+sends back the output of every sample, the HR/RR/SpO2 after the block and the
+three cycle counts.
+
+The same blocks are fed through libTriVitalDSP (the host build of the same
+App/ sources) and the outputs are compared sample by sample, so the run checks
+that the target build is bit-exact with the host reference as well as
+measuring the real cost on the chip.
+
+The host sends one block and waits for its last cycle packet before sending
+the next: the UART1 receive queue holds only 128 bytes (12 frames), and no
+frame arrives while the block is being processed. The wall-clock rate is
+therefore bound by 115200 baud (about 20 bytes per sample round trip); the
+on-chip cost is what the cycle counts measure.
+
+Exit status: 0 ok, 1 run failure, 2 output mismatch against the reference.
+"""
+import argparse
+import ctypes
+import json
+import sys
+import time
+
+import numpy as np
+
+from reprocess import default_lib
+
+MODULE_SYS = 0x01
+DAT_CMD_ACK = 0x04
+MODULE_TEST = 0x13
+CMD_TEST_START = 0x01
+CMD_TEST_FRAME = 0x02
+CMD_TEST_STOP = 0x03
+DAT_TEST_WAVE = 0x10
+DAT_TEST_PARAM = 0x11
+DAT_TEST_CYCLES = 0x12
+CMD_ACK_OK = 0
+
+PACK_LEN = 10
+FRAME_CHANNELS = 4                # ECG, RESP, RED, IR
+SAMPLE_MAX = 0x0FFF               # 12-bit ADC
+MAX_BLOCK = 64                    # DSP_TEST_MAX_BLOCK
+MODULES = ("ecg", "resp", "spo2")
+TARGET_CLOCK_HZ = 72_000_000
+SAMPLE_PERIOD_S = 0.004           # one frame every 4 ms in normal operation
+
+
+def pack(module_id, second_id, data):
+    """Same packing as PackDataToBuf: the high bit of bytes 2..8 moves into the head byte."""
+    raw = [second_id] + list(data)
+    head = 0
+    body = []
+    for i, value in enumerate(raw):
+        head |= ((value >> 7) & 1) << i
+        body.append(value | 0x80)
+    head |= 0x80
+    check = (module_id + head + sum(body)) & 0xFF
+    return bytes([module_id, head] + body + [check | 0x80])
+
+
+class Unpacker:
+    """Byte-wise resync on the module ID (< 0x80), like UnPackData."""
+
+    def __init__(self):
+        self.buf = []
+
+    def feed(self, chunk):
+        packs = []
+        for byte in chunk:
+            if byte < 0x80:
+                self.buf = [byte]
+            elif self.buf:
+                self.buf.append(byte)
+                if len(self.buf) == PACK_LEN:
+                    packs.extend(self._unpack(self.buf))
+                    self.buf = []
+        return packs
+
+    @staticmethod
+    def _unpack(buf):
+        if (sum(buf[:9]) & 0x7F) != (buf[9] & 0x7F):
+            return []
+        head = buf[1]
+        raw = [(buf[i + 2] & 0x7F) | (((head >> i) & 1) << 7) for i in range(7)]
+        return [(buf[0], raw[0], bytes(raw[1:]))]
+
+
+def frame_data(ecg, resp, red, ir):
+    """Four 12-bit samples packed high-order first into the 6 data bytes of CMD_TEST_FRAME."""
+    return [ecg >> 4, ((ecg & 0xF) << 4) | (resp >> 8), resp & 0xFF,
+            red >> 4, ((red & 0xF) << 4) | (ir >> 8), ir & 0xFF]
+
+
+def s16(hi, lo):
+    value = (hi << 8) | lo
+    return value - 0x10000 if value & 0x8000 else value
+
+
+class Device:
+    def __init__(self, port, baud, timeout):
+        try:
+            import serial
+        except ImportError:
+            sys.exit("hil_bench.py needs pyserial (pip install pyserial)")
+        self.port = serial.Serial(port, baud, timeout=0.05)
+        self.timeout = timeout
+        self.unpacker = Unpacker()
+        self.pending = []
+        self.port.reset_input_buffer()
+
+    def send(self, second_id, data):
+        self.port.write(pack(MODULE_TEST, second_id, data))
+
+    def next_pack(self):
+        deadline = time.monotonic() + self.timeout
+        while not self.pending:
+            if time.monotonic() > deadline:
+                raise TimeoutError("no reply from the device")
+            self.pending.extend(self.unpacker.feed(self.port.read(self.port.in_waiting or 1)))
+        return self.pending.pop(0)
+
+    def command(self, second_id, data):
+        """Send START/STOP and wait for its DAT_CMD_ACK, skipping normal wave/param traffic."""
+        self.send(second_id, data)
+        while True:
+            module, sid, payload = self.next_pack()
+            if module == MODULE_SYS and sid == DAT_CMD_ACK and payload[0] == MODULE_TEST and payload[1] == second_id:
+                return payload[2]
+
+    def run_block(self, frames):
+        self.port.write(b"".join(pack(MODULE_TEST, CMD_TEST_FRAME, frame_data(*map(int, f))) for f in frames))
+        outputs, params, cycles = [], None, {}
+        while "spo2" not in cycles:
+            module, sid, payload = self.next_pack()
+            if module != MODULE_TEST:
+                continue
+            if sid == DAT_TEST_WAVE:
+                outputs.append((s16(payload[0], payload[1]), s16(payload[2], payload[3]), s16(payload[4], payload[5])))
+            elif sid == DAT_TEST_PARAM:
+                params = ((payload[0] << 8) | payload[1], (payload[2] << 8) | payload[3], (payload[4] << 8) | payload[5])
+            elif sid == DAT_TEST_CYCLES and payload[0] < len(MODULES):
+                cycles[MODULES[payload[0]]] = int.from_bytes(payload[2:6], "big")
+        return outputs, params, cycles
+
+    def close(self):
+        self.port.close()
+
+
+class Reference:
+    """libTriVitalDSP driven through the same block entry points as the firmware."""
+
+    def __init__(self, path):
+        self.lib = ctypes.CDLL(path)
+        for name in ("ECGGetHeartRate", "RESPGetRespRate", "SPO2GetSPO2Value"):
+            getattr(self.lib, name).restype = ctypes.c_uint16
+        self.lib.DSPReplayReset()
+
+    def run_block(self, frames):
+        num = len(frames)
+        cols = [np.ascontiguousarray(frames[:, i], dtype=np.uint16) for i in range(FRAME_CHANNELS)]
+        out = [np.zeros(num, dtype=np.int16) for _ in MODULES]
+        ptr = lambda a: a.ctypes.data_as(ctypes.c_void_p)
+        self.lib.ECGProcessBlock(ptr(cols[0]), ptr(out[0]), num)
+        self.lib.RESPProcessBlock(ptr(cols[1]), ptr(out[1]), num)
+        self.lib.SPO2ProcessBlock(ptr(cols[2]), ptr(cols[3]), ptr(out[2]), num)
+        params = (self.lib.ECGGetHeartRate(), self.lib.RESPGetRespRate(), self.lib.SPO2GetSPO2Value())
+        return list(zip(*(o.tolist() for o in out))), params
+
+
+def load_frames(args, lib_path):
+    if args.input:
+        frames = np.fromfile(args.input, dtype="<u2")
+        frames = frames[:len(frames) // FRAME_CHANNELS * FRAME_CHANNELS].reshape(-1, FRAME_CHANNELS)[:args.samples]
+    else:
+        lib = ctypes.CDLL(lib_path)
+        frames = np.zeros((args.samples, FRAME_CHANNELS), dtype=np.uint16)
+        frame = (ctypes.c_uint16 * FRAME_CHANNELS)()
+        for i in range(args.samples):
+            lib.BenchSynthFrame(i, frame)
+            frames[i] = list(frame)
+    clipped = int((frames > SAMPLE_MAX).sum())
+    if clipped:
+        print(f"warning: {clipped} samples above 12 bits clipped", file=sys.stderr)
+    return np.minimum(frames, SAMPLE_MAX).astype(np.uint16)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", required=True, help="serial port of the board (UART1)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--block", type=int, default=16, help="samples per block, 1..%d" % MAX_BLOCK)
+    parser.add_argument("--input", help="recorded .raw file (4 x u16 LE per frame), synthetic data if omitted")
+    parser.add_argument("-n", "--samples", type=int, default=7500)
+    parser.add_argument("--lib", default=default_lib(), help="libTriVitalDSP.so for the bit-exact reference")
+    parser.add_argument("--timeout", type=float, default=2.0, help="seconds to wait for a reply")
+    parser.add_argument("--out", help="write the JSON report here")
+    args = parser.parse_args()
+
+    if not 1 <= args.block <= MAX_BLOCK:
+        parser.error("--block must be 1..%d" % MAX_BLOCK)
+    if args.samples < args.block:
+        parser.error("--samples must be at least --block")
+    if not args.lib:
+        parser.error("libTriVitalDSP.so not found, build the host tree or pass --lib")
+
+    frames = load_frames(args, args.lib)
+    if len(frames) < args.block:
+        parser.error(f"{args.input} holds {len(frames)} frames, fewer than one block")
+    reference = Reference(args.lib)
+    device = Device(args.port, args.baud, args.timeout)
+    per_sample = {m: [] for m in MODULES}
+    mismatch = {"samples": 0, "params": 0, "first": None}
+    done = 0
+    try:
+        if device.command(CMD_TEST_START, [args.block, 0, 0, 0, 0, 0]) != CMD_ACK_OK:
+            print("device rejected CMD_TEST_START", file=sys.stderr)
+            return 1
+        started = time.perf_counter()
+        for offset in range(0, len(frames) - args.block + 1, args.block):
+            block = frames[offset:offset + args.block]
+            outputs, params, cycles = device.run_block(block)
+            ref_outputs, ref_params = reference.run_block(block)
+            for m in MODULES:
+                per_sample[m].append(cycles[m] / args.block)
+            bad = [i for i, (a, b) in enumerate(zip(outputs, ref_outputs)) if a != b]
+            bad += range(len(outputs), args.block)
+            mismatch["samples"] += len(bad)
+            mismatch["params"] += params != ref_params
+            if (bad or params != ref_params) and mismatch["first"] is None:
+                mismatch["first"] = offset + (bad[0] if bad else args.block - 1)
+            done += args.block
+        wall = time.perf_counter() - started
+        device.command(CMD_TEST_STOP, [0] * 6)
+    except TimeoutError as exc:
+        print(f"{exc} after {done} samples", file=sys.stderr)
+        return 1
+    finally:
+        device.close()
+
+    report = {"block": args.block, "samples": done, "wall_samples_per_s": done / wall if wall else 0,
+              "mismatch": mismatch, "modules": {}}
+    total = 0.0
+    for m in MODULES:
+        mean = sum(per_sample[m]) / len(per_sample[m])
+        total += mean
+        report["modules"][m] = {"cycles_per_sample_mean": mean, "cycles_per_sample_p99": float(np.percentile(per_sample[m], 99)),
+                                "us_per_sample": mean / TARGET_CLOCK_HZ * 1e6}
+    report["realtime_factor"] = SAMPLE_PERIOD_S * TARGET_CLOCK_HZ / total if total else 0
+
+    print(f"block {args.block}, {done} samples, {report['wall_samples_per_s']:.0f} samples/s over the link")
+    for m, stats in report["modules"].items():
+        print(f"  {m:<5} cycles/sample mean {stats['cycles_per_sample_mean']:8.0f} p99 {stats['cycles_per_sample_p99']:8.0f}"
+              f"  ({stats['us_per_sample']:.2f} us)")
+    if total:
+        print(f"  DSP runs {report['realtime_factor']:.0f}x faster than the 4 ms sample period")
+    else:
+        print("  no cycle counts: the device was built with BENCH_HAL (no DWT)")
+    print(f"  mismatches vs reference: {mismatch['samples']} samples, {mismatch['params']} param packets"
+          + (f", first at sample {mismatch['first']}" if mismatch["first"] is not None else ""))
+    if args.out:
+        with open(args.out, "w") as f:
+            json.dump(report, f, indent=2)
+    return 2 if mismatch["samples"] or mismatch["params"] else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
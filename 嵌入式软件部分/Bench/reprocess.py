@@ -0,0 +1,315 @@
+#!/usr/bin/env python3
+"""Replay recorded ADC frames through the firmware DSP code, many files in parallel.
+
+Each *.raw recording (see BenchHAL.h: 250 Hz frames of ECG, RESP, RED, IR as
+little-endian u16) is fed frame by frame through ECGTask/RESPTask/SPO2Task
+compiled for the host (libTriVitalDSP, built by CMakeLists.txt from the same
+App/ sources as the firmware). The HR/RR/SpO2 the firmware would have shown
+is sampled once per second and written to <name>.vitals.csv.
+
+Annotations are read from a sidecar <name>.ref.csv with a header row
+``t,hr,rr,spo2`` (t in seconds from the start of the recording, empty cells
+for values that were not annotated). For every file and for the whole batch
+the tool reports bias, MAE, RMSE and the share of points within tolerance,
+skipping the warm-up period, lead-off points and points where the firmware
+had no value yet (0); the latter are reported as lost coverage. Start-up is
+reported separately over the whole recording: the first second with any value
+(first) and the first second within tolerance of the annotation (valid).
+
+The DSP modules keep their filter state in file-scope static variables that
+InitECG/InitRESP/InitSPO2 clear, so a worker process calls DSPReplayReset
+before each file and replays any number of files in turn. A recording is never
+split across workers: the filters have to see it from the start.
+"""
+import argparse
+import csv
+import ctypes
+import json
+import multiprocessing
+import os
+import sys
+import time
+
+import numpy as np
+
+FRAME_RATE_HZ = 250
+FRAME_CHANNELS = 4                 # BENCH_FRAME_CHANNELS
+REPLAY_FIELDS = 4                  # DSP_REPLAY_FIELDS: HR, RR, SpO2, lead bits
+LEAD_BITS = {"hr": 1, "rr": 2, "spo2": 4}
+METRICS = ("hr", "rr", "spo2")
+DEFAULT_TOLERANCE = {"hr": 5.0, "rr": 3.0, "spo2": 2.0}
+CHUNK_FRAMES = FRAME_RATE_HZ * 600  # replay ten minutes per ctypes call
+
+_lib = None
+
+
+def default_lib():
+    """libTriVitalDSP.so in the documented host build directory (build-host, or build), if present."""
+    here = os.path.dirname(os.path.abspath(__file__))
+    for build in ("build-host", "build"):
+        path = os.path.join(here, os.pardir, build, "libTriVitalDSP.so")
+        if os.path.exists(path):
+            return os.path.normpath(path)
+    return None
+
+
+def load_lib(path):
+    lib = ctypes.CDLL(path)
+    lib.DSPReplayReset.restype = None
+    lib.DSPReplayReset.argtypes = []
+    lib.DSPReplayRun.restype = ctypes.c_uint32
+    lib.DSPReplayRun.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint32, ctypes.c_void_p]
+    return lib
+
+
+def init_worker(lib_path):
+    global _lib
+    _lib = load_lib(lib_path)
+
+
+def replay(path, stride):
+    """Frames of one recording -> (points, REPLAY_FIELDS) u16 array, one point per `stride` frames."""
+    frames = np.memmap(path, dtype="<u2", mode="r")
+    frames = frames[:len(frames) // FRAME_CHANNELS * FRAME_CHANNELS].reshape(-1, FRAME_CHANNELS)
+    out = np.zeros((len(frames) // stride + 1, REPLAY_FIELDS), dtype=np.uint16)
+    _lib.DSPReplayReset()
+    points = 0
+    for offset in range(0, len(frames), CHUNK_FRAMES):
+        chunk = np.ascontiguousarray(frames[offset:offset + CHUNK_FRAMES], dtype=np.uint16)
+        points += _lib.DSPReplayRun(chunk.ctypes.data, len(chunk), stride, out[points:].ctypes.data)
+    return len(frames), out[:points]
+
+
+def read_reference(path):
+    """t, hr, rr, spo2 columns -> dict of metric -> (times, values); missing cells are skipped."""
+    ref = {metric: ([], []) for metric in METRICS}
+    with open(path, newline="", encoding="utf-8") as f:
+        for row in csv.DictReader(f):
+            t = float(row["t"])
+            for metric in METRICS:
+                value = (row.get(metric) or "").strip()
+                if value:
+                    ref[metric][0].append(t)
+                    ref[metric][1].append(float(value))
+    return {metric: (np.array(times), np.array(values)) for metric, (times, values) in ref.items()}
+
+
+def first_reading(series, ref, period, column, metric, tolerance):
+    """Seconds until the first non-zero value and until the first one within tolerance of the annotation."""
+    lead_ok = (series[:, 3] & LEAD_BITS[metric]) != 0
+    got = series[:, column].astype(float)
+    shown = np.flatnonzero(lead_ok & (got > 0))
+    first = (shown[0] + 1) * period if len(shown) else None
+    times, expected = ref[metric]
+    index = np.floor(times / period).astype(int) - 1
+    inside = (index >= 0) & (index < len(series))
+    index, expected = index[inside], expected[inside]
+    ok = lead_ok[index] & (got[index] > 0) & (np.abs(got[index] - expected) <= tolerance[metric])
+    valid = (index[np.argmax(ok)] + 1) * period if ok.any() else None
+    return first, valid
+
+
+def compare(series, ref, period, skip_seconds, tolerance):
+    """Per-metric raw error sums, so files can be pooled exactly."""
+    stats = {}
+    for column, metric in enumerate(METRICS):
+        first_s, valid_s = first_reading(series, ref, period, column, metric, tolerance)
+        times, expected = ref[metric]
+        keep = times >= skip_seconds
+        times, expected = times[keep], expected[keep]
+        # output point i is taken after (i + 1) * period seconds of data
+        index = np.floor(times / period).astype(int) - 1
+        inside = (index >= 0) & (index < len(series))
+        index, expected = index[inside], expected[inside]
+        got = series[index, column].astype(float)
+        lead_ok = (series[index, 3] & LEAD_BITS[metric]) != 0
+        valid = lead_ok & (got > 0)
+        error = got[valid] - expected[valid]
+        stats[metric] = {
+            "annotated": int(len(index)),
+            "lead_off": int(np.count_nonzero(~lead_ok)),
+            "no_value": int(np.count_nonzero(lead_ok & (got <= 0))),
+            "n": int(len(error)),
+            "sum": float(error.sum()),
+            "sum_abs": float(np.abs(error).sum()),
+            "sum_sq": float((error ** 2).sum()),
+            "abs_errors": np.abs(error),
+            "first_s": first_s,
+            "valid_s": valid_s,
+        }
+    return stats
+
+
+def summarise(stats, tolerance):
+    summary = {}
+    for metric in METRICS:
+        parts = [s[metric] for s in stats]
+        n = sum(p["n"] for p in parts)
+        annotated = sum(p["annotated"] - p["lead_off"] for p in parts)
+        abs_errors = np.concatenate([p["abs_errors"] for p in parts]) if parts else np.zeros(0)
+        first = [p["first_s"] for p in parts if p["first_s"] is not None]
+        valid = [p["valid_s"] for p in parts if p["valid_s"] is not None]
+        summary[metric] = {
+            "n": n,
+            "coverage": n / annotated if annotated else None,
+            "bias": sum(p["sum"] for p in parts) / n if n else None,
+            "mae": sum(p["sum_abs"] for p in parts) / n if n else None,
+            "rmse": (sum(p["sum_sq"] for p in parts) / n) ** 0.5 if n else None,
+            "p95_abs": float(np.percentile(abs_errors, 95)) if n else None,
+            "within_tol": float(np.count_nonzero(abs_errors <= tolerance[metric])) / n if n else None,
+            "lead_off": sum(p["lead_off"] for p in parts),
+            "first_s": float(np.median(first)) if first else None,
+            "valid_s": float(np.median(valid)) if valid else None,
+            "valid_max_s": max(valid) if valid else None,
+        }
+    return summary
+
+
+def process(task):
+    path, out_dir, stride, skip_seconds, tolerance = task
+    started = time.perf_counter()
+    frames, series = replay(path, stride)
+    cpu = time.perf_counter() - started
+    period = stride / FRAME_RATE_HZ
+    stem = os.path.splitext(os.path.basename(path))[0]
+    with open(os.path.join(out_dir, stem + ".vitals.csv"), "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(("t", "hr", "rr", "spo2", "lead"))
+        for i, row in enumerate(series.tolist()):
+            writer.writerow(["%g" % ((i + 1) * period)] + row)
+    ref_path = os.path.splitext(path)[0] + ".ref.csv"
+    stats = (compare(series, read_reference(ref_path), period, skip_seconds, tolerance)
+             if os.path.exists(ref_path) else None)
+    return path, frames, cpu, stats
+
+
+def collect(inputs):
+    paths = []
+    for item in inputs:
+        if os.path.isdir(item):
+            for root, _, names in os.walk(item):
+                paths.extend(os.path.join(root, name) for name in names if name.endswith(".raw"))
+        else:
+            paths.append(item)
+    # longest first, so the last worker to finish is not stuck with a big file
+    return sorted(paths, key=os.path.getsize, reverse=True)
+
+
+def make_synthetic(out_dir, files, seconds, seed=0):
+    """Recordings shaped like BenchSynthFrame, with HR/RR stepping every minute, plus .ref.csv."""
+    os.makedirs(out_dir, exist_ok=True)
+    rng = np.random.default_rng(seed)
+    gauss = lambda x, mu, sigma: np.exp(-0.5 * ((x - mu) / sigma) ** 2)
+    for k in range(files):
+        minutes = -(-seconds // 60)
+        hr = rng.uniform(50, 130, minutes)
+        rr = rng.uniform(10, 30, minutes)
+        t = np.arange(seconds * FRAME_RATE_HZ) / FRAME_RATE_HZ
+        minute = (t // 60).astype(int)
+        beat_phase = np.cumsum(hr[minute] / 60 / FRAME_RATE_HZ) % 1.0
+        breath_phase = np.cumsum(rr[minute] / 60 / FRAME_RATE_HZ)
+        beat = 60.0 / hr[minute]
+        phase = beat_phase * beat
+        ecg = (2048 + 700 * gauss(phase, 0.20, 0.012) - 90 * gauss(phase, 0.17, 0.010)
+               - 120 * gauss(phase, 0.23, 0.010) + 160 * gauss(phase, 0.45, 0.040)
+               + 30 * np.sin(2 * np.pi * 50 * t) + 80 * np.sin(2 * np.pi * 0.2 * t))
+        resp = 2048 + 900 * np.sin(2 * np.pi * breath_phase)
+        pulse = gauss(phase, 0.30, 0.08) + 0.35 * gauss(phase, 0.55, 0.06)
+        frames = np.stack([ecg, resp, 1800 - 60 * pulse, 2100 - 100 * pulse], axis=1)
+        name = os.path.join(out_dir, "synthetic_%03d" % k)
+        frames.astype("<u2").tofile(name + ".raw")
+        with open(name + ".ref.csv", "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(("t", "hr", "rr", "spo2"))
+            for second in range(1, seconds + 1):
+                m = (second - 1) // 60
+                writer.writerow((second, "%.1f" % hr[m], "%.1f" % rr[m], ""))
+    return out_dir
+
+
+def fmt(value, spec=".2f"):
+    return "-" if value is None else format(value, spec)
+
+
+def print_summary(title, summary):
+    print(title)
+    for metric in METRICS:
+        s = summary[metric]
+        if not s["n"] and not s["lead_off"] and s["first_s"] is None:
+            continue
+        print("  %-4s n %7d  coverage %s  bias %s  MAE %s  RMSE %s  p95|e| %s  within tol %s  "
+              "first %s s  valid %s s (max %s)" % (
+                  metric.upper(), s["n"], fmt(s["coverage"], ".1%"), fmt(s["bias"]), fmt(s["mae"]), fmt(s["rmse"]),
+                  fmt(s["p95_abs"]), fmt(s["within_tol"], ".1%"), fmt(s["first_s"], ".0f"), fmt(s["valid_s"], ".0f"),
+                  fmt(s["valid_max_s"], ".0f")))
+
+
+def parse_tolerance(items):
+    tolerance = dict(DEFAULT_TOLERANCE)
+    for item in items:
+        name, _, value = item.partition("=")
+        if name not in tolerance or not value:
+            raise argparse.ArgumentTypeError("expected hr=N, rr=N or spo2=N, got %r" % item)
+        tolerance[name] = float(value)
+    return tolerance
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="*", help=".raw files or directories searched recursively")
+    parser.add_argument("--lib", default=default_lib(), help="libTriVitalDSP.so built from CMakeLists.txt")
+    parser.add_argument("-o", "--out-dir", default="reprocess_out")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count())
+    parser.add_argument("--stride", type=int, default=FRAME_RATE_HZ, help="frames per output point (250 = 1 s)")
+    parser.add_argument("--skip", type=float, default=10.0, help="warm-up seconds excluded from the statistics")
+    parser.add_argument("--tolerance", nargs="*", default=[], metavar="METRIC=N",
+                        help="within-tolerance limits, default hr=5 rr=3 spo2=2")
+    parser.add_argument("--make-synthetic", nargs=3, metavar=("DIR", "FILES", "SECONDS"),
+                        help="write synthetic recordings with annotations to DIR and process them")
+    args = parser.parse_args()
+
+    tolerance = parse_tolerance(args.tolerance)
+    if args.make_synthetic:
+        directory, files, seconds = args.make_synthetic
+        args.inputs.append(make_synthetic(directory, int(files), int(seconds)))
+    if not args.lib or not os.path.exists(args.lib):
+        parser.error("libTriVitalDSP.so not found, build it with CMake or pass --lib")
+    paths = collect(args.inputs)
+    if not paths:
+        parser.error("no .raw recordings given")
+    os.makedirs(args.out_dir, exist_ok=True)
+
+    tasks = [(path, args.out_dir, args.stride, args.skip, tolerance) for path in paths]
+    started = time.perf_counter()
+    results = []
+    with multiprocessing.Pool(args.jobs, initializer=init_worker, initargs=(os.path.abspath(args.lib),)) as pool:
+        for path, frames, cpu, stats in pool.imap_unordered(process, tasks):
+            seconds = frames / FRAME_RATE_HZ
+            print("%s: %.0f s recorded, %.2f s, %.0fx real time" % (path, seconds, cpu, seconds / cpu if cpu else 0))
+            results.append((path, seconds, cpu, stats))
+    wall = time.perf_counter() - started
+
+    recorded = sum(r[1] for r in results)
+    report = {"files": {}, "recorded_s": recorded, "wall_s": wall, "jobs": args.jobs, "tolerance": tolerance}
+    annotated = []
+    for path, seconds, cpu, stats in sorted(results):
+        entry = {"recorded_s": seconds, "cpu_s": cpu}
+        if stats is not None:
+            entry["stats"] = summarise([stats], tolerance)
+            annotated.append(stats)
+        report["files"][path] = entry
+    if annotated:
+        report["total"] = summarise(annotated, tolerance)
+        for path, entry in report["files"].items():
+            if "stats" in entry:
+                print_summary(path, entry["stats"])
+        print_summary("all %d annotated files" % len(annotated), report["total"])
+    print("%d files, %.1f h recorded in %.1f s on %d workers: %.0fx real time" % (
+        len(results), recorded / 3600, wall, args.jobs, recorded / wall if wall else 0))
+    with open(os.path.join(args.out_dir, "summary.json"), "w") as f:
+        json.dump(report, f, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
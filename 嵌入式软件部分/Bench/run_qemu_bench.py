@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Run the DSP benchmark under QEMU (Cortex-M3) and check it against a baseline.
+
+The benchmark ELF prints one JSON line per task with SysTick tick statistics.
+With ``-icount shift=N`` QEMU retires one instruction every 2**N ns of virtual
+time, so SysTick ticks (clocked at the machine's sysclk) convert exactly into
+instruction counts. DWT cycle counts are reported as well when the core model
+implements them (real silicon does, QEMU does not).
+
+With ``--block`` the benchmark instead times the block DSP entry points
+(ECGProcessBlock/RESPProcessBlock/SPO2ProcessBlock) at block sizes 1, 4, 16
+and 64 and reports the cost per sample.
+
+Exit status: 0 ok, 1 run failure, 2 regression against the baseline.
+"""
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+FRAME_PERIOD_S = 0.004          # DSP tasks run once per 4 ms frame
+TARGET_CLOCK_HZ = 72_000_000    # STM32F103RC core clock
+METRICS = ("mean", "p50", "p99", "max")
+
+
+def build_command(args):
+    bench_args = ["-b"] if args.block else ["-n", str(args.samples)] + ([args.input] if args.input else [])
+    if args.host_exe:
+        return [args.host_exe] + bench_args
+
+    semi = ["enable=on", "target=native", "arg=" + os.path.basename(args.elf)] + ["arg=" + a for a in bench_args]
+    return [
+        args.qemu,
+        "-M", args.machine,
+        "-cpu", "cortex-m3",
+        "-nographic",
+        "-monitor", "none",
+        "-serial", "none",
+        "-semihosting-config", ",".join(semi),
+        "-icount", "shift=%d,align=off,sleep=off" % args.icount_shift,
+        "-kernel", args.elf,
+    ]
+
+
+def parse_lines(text):
+    records = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line.startswith("{"):
+            continue
+        try:
+            records.append(json.loads(line))
+        except ValueError:
+            continue
+    return records
+
+
+def to_report(records, args):
+    report = {"machine": "host" if args.host_exe else args.machine, "tasks": {}, "result": None}
+    if not args.host_exe:
+        report["icount_shift"] = args.icount_shift
+        report["sysclk_hz"] = args.sysclk_hz
+    insn_per_tick = (1e9 / args.sysclk_hz) / (1 << args.icount_shift)
+
+    for rec in records:
+        kind = rec.get("bench")
+        if kind == "error":
+            raise RuntimeError(rec.get("msg", "benchmark error"))
+        if kind == "result":
+            report["result"] = rec
+            continue
+        if kind == "block":
+            # per-sample averages arrive multiplied by 10
+            unit, scale = ("insn", insn_per_tick) if rec["timebase"] == "systick" else ("ns", 1.0)
+            report.setdefault("block", {})[str(rec["block"])] = {
+                "%s_%s_per_sample" % (name, unit): round(rec[name + "_x10"] / 10 * scale, 1)
+                for name in ("ecg", "resp", "spo2")}
+            continue
+        if kind != "dsp":
+            continue
+
+        n = rec["samples"]
+        values = {"mean": rec["sum"] / n, "p50": rec["p50"], "p99": rec["p99"], "max": rec["max"]}
+        task = {"samples": n}
+        if rec["timebase"] == "systick":
+            # ticks -> ns -> instructions
+            for key in METRICS:
+                task["insn_" + key] = round(values[key] * insn_per_tick, 1)
+            task["frame_pct_72mhz"] = round(task["insn_mean"] / (TARGET_CLOCK_HZ * FRAME_PERIOD_S) * 100, 3)
+        else:
+            for key in METRICS:
+                task["ns_" + key] = round(values[key], 1)
+        if "cyc_sum" in rec:
+            task["cyc_mean"] = round(rec["cyc_sum"] / n, 1)
+            task["cyc_p50"] = rec["cyc_p50"]
+            task["cyc_p99"] = rec["cyc_p99"]
+            task["cyc_max"] = rec["cyc_max"]
+        report["tasks"][rec["task"]] = task
+
+    if args.block:
+        if "block" not in report:
+            raise RuntimeError("benchmark produced no block results")
+    elif not report["tasks"] or report["result"] is None:
+        raise RuntimeError("benchmark produced no results")
+    return report
+
+
+def compare(report, baseline, tolerance):
+    regressions = []
+    for name, task in report["tasks"].items():
+        base = baseline.get("tasks", {}).get(name)
+        if base is None:
+            continue
+        for key in ("insn_mean", "insn_p99", "cyc_mean", "cyc_p99", "ns_mean"):
+            if key in task and key in base and base[key] > 0:
+                ratio = task[key] / base[key]
+                if ratio > 1.0 + tolerance:
+                    regressions.append("%s.%s %.1f -> %.1f (+%.1f%%)" % (name, key, base[key], task[key], (ratio - 1) * 100))
+
+    for size, block in report.get("block", {}).items():
+        for key, value in block.items():
+            base = baseline.get("block", {}).get(size, {}).get(key)
+            if base and value / base > 1.0 + tolerance:
+                regressions.append("block%s.%s %.1f -> %.1f (+%.1f%%)" % (size, key, base, value, (value / base - 1) * 100))
+
+    base_result = baseline.get("result") or {}
+    result = report["result"] or {}
+    for key in ("hr", "rr", "spo2"):
+        if key in base_result and base_result[key] != result.get(key):
+            print("warning: %s changed %s -> %s" % (key, base_result[key], result.get(key)), file=sys.stderr)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    target = parser.add_mutually_exclusive_group(required=True)
+    target.add_argument("--elf", help="cross-built TriVitalBench.elf")
+    target.add_argument("--host-exe", help="natively built TriVitalBench (ns timing, no instruction counts)")
+    parser.add_argument("--qemu", default="qemu-system-arm")
+    parser.add_argument("--machine", default="mps2-an385")
+    parser.add_argument("--sysclk-hz", type=float, default=25e6, help="SysTick clock of the machine model")
+    parser.add_argument("--icount-shift", type=int, default=6)
+    parser.add_argument("--input", help="recorded .raw file (4 x u16 LE per frame), synthetic data if omitted")
+    parser.add_argument("-n", "--samples", type=int, default=7500)
+    parser.add_argument("--block", action="store_true", help="time the block DSP API at block sizes 1/4/16/64")
+    parser.add_argument("--timeout", type=float, default=600)
+    parser.add_argument("--out", help="write the JSON report here")
+    parser.add_argument("--baseline", help="baseline JSON report to compare against")
+    parser.add_argument("--tolerance", type=float, default=0.05, help="allowed relative increase (default 5%%)")
+    parser.add_argument("--update-baseline", action="store_true", help="overwrite --baseline with this run")
+    args = parser.parse_args()
+
+    cmd = build_command(args)
+    try:
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                              universal_newlines=True, timeout=args.timeout)
+    except (OSError, subprocess.TimeoutExpired) as exc:
+        print("run failed: %s" % exc, file=sys.stderr)
+        return 1
+
+    # QEMU may route the semihosting console to either stream
+    try:
+        report = to_report(parse_lines(proc.stdout + "\n" + proc.stderr), args)
+    except RuntimeError as exc:
+        print("run failed (exit %d): %s" % (proc.returncode, exc), file=sys.stderr)
+        sys.stderr.write(proc.stderr)
+        return 1
+
+    text = json.dumps(report, indent=2, ensure_ascii=False)
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as f:
+            f.write(text + "\n")
+    print(text)
+
+    if args.baseline:
+        if args.update_baseline or not os.path.exists(args.baseline):
+            with open(args.baseline, "w", encoding="utf-8") as f:
+                f.write(text + "\n")
+            return 0
+        with open(args.baseline, encoding="utf-8") as f:
+            baseline = json.load(f)
+        regressions = compare(report, baseline, args.tolerance)
+        if regressions:
+            print("regression:\n  " + "\n  ".join(regressions), file=sys.stderr)
+            return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -24,7 +24,11 @@
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
-#define ADC1_BUF_SIZE 100           //ûĴС
+#define ADC1_BUF_SIZE 128           //ûĴСΪ2
+
+#if (ADC1_BUF_SIZE & (ADC1_BUF_SIZE - 1)) != 0
+  #error "ADC1_BUF_SIZE must be a power of two"
+#endif
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
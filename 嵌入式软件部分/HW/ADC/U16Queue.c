@@ -50,22 +50,11 @@
 * pQue-ṹָ룬ָṹĵַ
 *   ֵvoid
 * ڣ20180101
-* ע    ⣺
+* ע    ⣺ȡlen2
 *********************************************************************************************************/
 void  InitU16Queue(StructU16CirQue* pQue, u16* pBuf, i16 len)
 {
-  i16 i;
-
-  pQue->front   = 0;    //ͷ
-  pQue->rear    = 0;    //β
-  pQue->bufLen  = len;  //ȣ
-  pQue->elemNum = 0;    //ǰԪصĸ
-  pQue->pBuffer = pBuf; //ָpBufָpQue->pBuffer
-  
-  for(i = 0; i < len; i++)
-  {
-    pQue->pBuffer[i]  = 0;  //ָpQue->pBufferָԪؾֵ0
-  }
+  InitQueueElem(pQue, pBuf, len, sizeof(u16));
 }
 
 /*********************************************************************************************************
@@ -79,13 +68,11 @@ void  InitU16Queue(StructU16CirQue* pQue, u16* pBuf, i16 len)
 *********************************************************************************************************/
 void  ClearU16Queue(StructU16CirQue* pQue)
 {
-  pQue->front   = 0; //ͷ
-  pQue->rear    = 0; //β
-  pQue->elemNum = 0; //ǰԪصĸ
+  ClearQueue(pQue);
 }
 
 /*********************************************************************************************************
-* ƣQueueEmpty
+* ƣU16QueueEmpty
 * ܣж϶ǷΪգ1Ϊգ0Ϊǿ 
 * pQue-ṹָ룬ָṹĵַ
 * pQue-ṹָ룬ָṹĵַ
@@ -95,12 +82,12 @@ void  ClearU16Queue(StructU16CirQue* pQue)
 *********************************************************************************************************/
 u8    U16QueueEmpty(StructU16CirQue* pQue)
 {
-  return(0 == pQue->elemNum);
+  return QueueEmpty(pQue);
 }
 
 /*********************************************************************************************************
 * ƣU16QueueLength
-* ܣضԪظ
+* ܣضԪظ 
 * pQue-ṹָ룬ָṹĵַ
 * pQue-ṹָ룬ָṹĵַ
 *   ֵԪصĸ
@@ -109,7 +96,7 @@ u8    U16QueueEmpty(StructU16CirQue* pQue)
 *********************************************************************************************************/
 i16   U16QueueLength(StructU16CirQue* pQue)
 {
-  return(pQue->elemNum);
+  return QueueLength(pQue);
 }
 
 /*********************************************************************************************************
@@ -119,29 +106,11 @@ i16   U16QueueLength(StructU16CirQue* pQue)
 * pQue-ṹָ룬ָṹĵַ
 *   ֵɹӵԪص
 * ڣ20180101
-* ע    ⣺ÿβһԪأrearrearֵڵڶbufLenʱrearֵΪ0Ҫעǣ
-*           еԪϴдԪʱдԪڶеԪ+д
-*           Ԫ-еEnQueueڳԪزȡǵ̬ȡ
+* ע    ⣺ʣռԪزӣEnQueue
 *********************************************************************************************************/
-i16 EnU16Queue(StructU16CirQue* pQue, u16* pInput, i16 len)
+i16 EnU16Queue(StructU16CirQue* pQue, const u16* pInput, i16 len)
 {
-  i16 wLen = 0; //ӵԪlenwLen0ӵlen-1
-  
-  while((pQue->elemNum < pQue->bufLen) && (wLen < len))
-  {
-    pQue->pBuffer[pQue->rear] = pInput[wLen]; //ӵĵwLenԪpInput[wLen]
-    pQue->rear++;     //βrearָβԪصһλ
-    
-    if(pQue->rear >= pQue->bufLen)
-    {
-      pQue->rear = 0; //βԪصһλΪpQue->bufLenrearָͷѭڴ˴
-    }
-
-    wLen++;
-    pQue->elemNum++;  //ǰеԪ
-  }
-
-  return wLen;  //ֵwLenΪ0ʾûԪ
+  return EnQueue(pQue, pInput, len);
 }
 
 /*********************************************************************************************************
@@ -151,27 +120,9 @@ i16 EnU16Queue(StructU16CirQue* pQue, u16* pInput, i16 len)
 * pQue-ṹָ룬ָṹĵַpOutput-Ԫشŵĵַ
 *   ֵɹӵԪص
 * ڣ20180101
-* ע    ⣺ÿȡһԪأfrontfrontֵڵڶbufLenʱfrontֵΪ0Ҫرע⣬
-*           жȡԪصǰǶҪһԪأȡԪlenСڻڶԪص
-*           ʱ԰ȡlenԪأֻȡеԪء 
+* ע    ⣺ԪزlenʱȡеȫԪأDeQueue
 *********************************************************************************************************/
 i16 DeU16Queue(StructU16CirQue* pQue, u16* pOutput, i16 len)
 {
-  i16 rLen = 0; //ȡlenԪأȡrLenԪ
-  
-  while((pQue->elemNum > 0) && (rLen < len))
-  {
-    pOutput[rLen] = pQue->pBuffer[pQue->front];
-    pQue->front++;
-    
-    if( pQue->front >= pQue->bufLen )
-    {
-      pQue->front = 0;//ͷԪصһλΪpQue->bufLenfrontָͷѭڴ˴
-    }
-
-    rLen++;
-    pQue->elemNum--;  //ǰеԪ
-  }
-
-  return rLen;  //ֵrLenΪ0ʾûԪ
+  return DeQueue(pQue, pOutput, len);
 }
@@ -20,6 +20,7 @@
 *                                              ͷļ
 *********************************************************************************************************/
 #include "DataType.h"
+#include "Queue.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -28,15 +29,8 @@
 /*********************************************************************************************************
 *                                              öٽṹ嶨
 *********************************************************************************************************/
-//ѭнṹ
-typedef struct
-{
-  i16 front;     //ͷָ룬ӷǿʱָͷԪ
-  i16 rear;      //βָ룬ӷǿʱָβԪصһλ
-  i16 bufLen;    //е
-  i16 elemNum;   //ǰеԪص
-  u16 *pBuffer;  //ѭеĻ
-}StructU16CirQue;
+//Queueͬһ/ʵ֣ԪشСΪ2ֽ
+typedef StructCirQue StructU16CirQue;
 
 /*********************************************************************************************************
 *                                              API
@@ -45,7 +39,7 @@ void  InitU16Queue(StructU16CirQue* pQue, u16* pBuf, i16 len);  //
 void  ClearU16Queue(StructU16CirQue* pQue);                     //
 u8    U16QueueEmpty(StructU16CirQue* pQue);                     //ж϶ǷΪգ1Ϊգ0Ϊǿ
 i16   U16QueueLength(StructU16CirQue* pQue);                    //ضԪظΪеĳ
-i16   EnU16Queue(StructU16CirQue* pQue, u16* pInput, i16 len);  //lenԪ
+i16   EnU16Queue(StructU16CirQue* pQue, const u16* pInput, i16 len);  //lenԪ
 i16   DeU16Queue(StructU16CirQue* pQue, u16* pOutput, i16 len); //lenԪ
 
 #endif
@@ -19,6 +19,7 @@
 *********************************************************************************************************/
 #include "DAC.h"
 #include "stm32f10x_conf.h"
+#include "FastIO.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -166,10 +167,10 @@ static  void ConfigDMA2Ch3ForDAC1(StructDACWave wave)
 *********************************************************************************************************/
 void DMA2_Channel3_IRQHandler(void)
 {
-  if(DMA_GetITStatus(DMA2_IT_TC3))  //жDMA2_Channel3жǷ
+  if(DMAFlagPending(DMA2, DMA_ISR_TCIF3))    //жDMA2_Channel3жǷ
   {
     NVIC_ClearPendingIRQ(DMA2_Channel3_IRQn);  //DMA2_Channel3жϹ
-    DMA_ClearITPendingBit(DMA2_IT_GL3);        //DMA2_Channel3жϱ־
+    DMAFlagClr(DMA2, DMA_IFCR_CGIF3);          //DMA2_Channel3ȫжϱ־
 
     ConfigDMA2Ch3ForDAC1(s_strDAC1WaveBuf);    //DMA2ͨ3
   }
@@ -0,0 +1,86 @@
+/*********************************************************************************************************
+* ģƣFastIO.h
+* ļ˵ж·ʹõļĴ GPIO/
+*           GPIO λ/λֱд BSRR/BRRдΪԭӲҪ--д
+*           жϱ־ֱӶд SR/ISR/IFCRΪ static inline StdPeriph Ĳ뺯á
+*           ʼȷ·ʹ StdPeriph
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ2026-10-17
+*********************************************************************************************************/
+#ifndef _FAST_IO_H_
+#define _FAST_IO_H_
+
+/*********************************************************************************************************
+*                                           ͷļ
+*********************************************************************************************************/
+#include "DataType.h"
+#include "stm32f10x.h"
+
+#if defined(BENCH_HAL)
+#include "stm32f10x_gpio.h"
+#endif
+
+/*********************************************************************************************************
+*                                           APIʵ
+*********************************************************************************************************/
+#if defined(BENCH_HAL)
+/* ׼شû STM32 裬Ų BenchHAL ¼ƽ */
+static __INLINE void PinSet(GPIO_TypeDef* port, u16 pin)
+{
+  GPIO_SetBits(port, pin);
+}
+
+static __INLINE void PinClr(GPIO_TypeDef* port, u16 pin)
+{
+  GPIO_ResetBits(port, pin);
+}
+
+#else
+/* øߣpin Ϊ GPIO_Pin_xɰλͬʱ */
+static __INLINE void PinSet(GPIO_TypeDef* port, u16 pin)
+{
+  port->BSRR = pin;
+}
+
+/* õ */
+static __INLINE void PinClr(GPIO_TypeDef* port, u16 pin)
+{
+  port->BRR = pin;
+}
+
+/* תɵǰ ODR  BSRR λ/λλ ODR --д */
+static __INLINE void PinToggle(GPIO_TypeDef* port, u16 pin)
+{
+  u32 odr = port->ODR;
+
+  port->BSRR = ((odr & pin) << 16) | (~odr & pin);
+}
+
+#endif
+
+/* USART ͻжǷTXEIE ʹ TXE λ */
+static __INLINE u8 UARTTxEmptyPending(USART_TypeDef* uart)
+{
+  return ((uart->CR1 & USART_CR1_TXEIE) && (uart->SR & USART_SR_TXE)) ? 1 : 0;
+}
+
+/* ر USART ͻж */
+static __INLINE void UARTTxEmptyITOff(USART_TypeDef* uart)
+{
+  uart->CR1 &= (u16)~USART_CR1_TXEIE;
+}
+
+/* DMA ͨжϱ־flag Ϊ DMA_ISR_xxx */
+static __INLINE u8 DMAFlagPending(DMA_TypeDef* dma, u32 flag)
+{
+  return (dma->ISR & flag) ? 1 : 0;
+}
+
+/*  DMA ͨжϱ־flag Ϊ DMA_IFCR_xxxд 1  */
+static __INLINE void DMAFlagClr(DMA_TypeDef* dma, u32 flag)
+{
+  dma->IFCR = flag;
+}
+
+#endif
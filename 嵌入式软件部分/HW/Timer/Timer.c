@@ -18,196 +18,345 @@
 *                                              ͷļ
 *********************************************************************************************************/
 #include "Timer.h"
-#include "stm32f10x_tim.h"
-#include "SPO2.h"
-#include <stdio.h>
+#include "stm32f10x.h"
 
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
+#define TIMER_WHEEL_MASK  (TIMER_WHEEL_SIZE - 1)
+#define TIMER_NONE        (-1)        ///жʱ
+
+//޸ʱֻ¼λʱжϣٽֻмָ˳ʱָǰPRIMASKֱӿжϣ
+//жϷжϵٽеҲǰж
+#define TIMER_LOCK(primask)   do{(primask) = __get_PRIMASK(); __disable_irq();}while(0)
+#define TIMER_UNLOCK(primask) __set_PRIMASK(primask)
+
+#ifdef TIMER_ISR_PROFILE
+#define DWT_CTRL          (*(volatile u32*)0xE0001000)  //DWT
+#define DWT_CYCCNT        (*(volatile u32*)0xE0001004)  //DWTڼ
+#endif
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
 *********************************************************************************************************/
+//ʱڵʱ̶Ӧʱֲ
+typedef struct
+{
+  TimerCallback pCallback;  //ʱãΪNULL
+  u32           eventBits;  //ʱλ¼λΪ0
+  u32           period;     //ڣms0Ϊζʱ
+  u32           rounds;     //ǰʱֻתȦ
+  i8            next;       //ͬһеһʱ
+  i8            slot;       //ڵĲۣʱΪTIMER_NONE
+}StructTimer;
 
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
-static  u8  s_i2msFlag  = FALSE;    //2ms־λֵΪFALSE
-static  u8  s_i1secFlag = FALSE;    //1s־λֵΪFALSE
-static	u32 s_1msCounter = 0;
+static  StructTimer   s_arrTimer[TIMER_MAX_NUM];      //ʱ
+static  i8            s_arrWheel[TIMER_WHEEL_SIZE];   //ÿ۵Ķʱͷ
+static  volatile u32  s_iTickCnt   = 0;               //1msļ
+static  volatile u32  s_iEventBits = 0;               //λ¼λ
+
+#ifdef TIMER_ISR_PROFILE
+static  u32 s_iISRCycleSum  = 0;  //ۼƵĽж
+static  u32 s_iISRCycleLast = 0;  //һĽж
+#endif
 
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
-static  void  ConfigTimer2(u16 arr, u16 psc);  //TIM2
-static  void  ConfigTimer5(u16 arr, u16 psc);  //TIM5
+static  void  InsertTimer(i8 id, u32 delay);  //ʱҵdelayĺĲ
+static  void  UnlinkTimer(i8 id);             //ʱڲժ
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
 /*********************************************************************************************************
-* ƣConfigTimer2
-* ܣTIM2 
-* arr-Զװֵpsc-ԤƵֵ
+* ƣInsertTimer
+* ܣʱҵdelayĺڵĲ
+* id-ʱţdelay-ǰĽС1
 * void
 *   ֵvoid
-* ڣ20180101
-* ע    ⣺APB1ʱΪ36MHzTIM2-TIM5ʱѡΪAPB12ˣTIM2-TIM5ʱΪ72MHz
+* ڣ20261017
+* ע    ⣺ÿֻһΣdelayʱrounds¼ҪתȦ
 *********************************************************************************************************/
-static  void ConfigTimer2(u16 arr, u16 psc)
+static  void  InsertTimer(i8 id, u32 delay)
 {
-  TIM_TimeBaseInitTypeDef  TIM_TimeBaseStructure;//TIM_TimeBaseStructureڴŶʱĲ
-  NVIC_InitTypeDef NVIC_InitStructure;           //NVIC_InitStructureڴNVICĲ
-
-  //ʹRCCʱ
-  RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);  //ʹTIM2ʱ
-  
-  //TIM2
-  TIM_TimeBaseStructure.TIM_Period        = arr;  //Զװֵ
-  TIM_TimeBaseStructure.TIM_Prescaler     = psc;  //ԤƵֵ
-  TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;       //ʱӷָtDTS = tCK_INT
-  TIM_TimeBaseStructure.TIM_CounterMode   = TIM_CounterMode_Up; //ϼģʽ
-  TIM_TimeBaseInit(TIM2, &TIM_TimeBaseStructure);               //ݲʼʱ
- 
-  TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);                    //ʹܶʱĸж
-
-  //NVIC
-  NVIC_InitStructure.NVIC_IRQChannel = TIM2_IRQn;               //жͨ
-  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;     //ռȼ
-  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;            //ȼ
-  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;               //ʹж
-  NVIC_Init(&NVIC_InitStructure);                               //ݲʼNVIC
-                                                                
-  TIM_Cmd(TIM2, ENABLE);                                        //ʹܶʱ  
+  u8 slot = (u8)((s_iTickCnt + delay) & TIMER_WHEEL_MASK);
+
+  s_arrTimer[id].rounds = (delay - 1) / TIMER_WHEEL_SIZE;
+  s_arrTimer[id].slot   = slot;
+  s_arrTimer[id].next   = s_arrWheel[slot];
+  s_arrWheel[slot]      = id;
 }
 
 /*********************************************************************************************************
-* ƣConfigTimer5
-* ܣTIM5 
-* arr-Զװֵpsc-ԤƵֵ
+* ƣUnlinkTimer
+* ܣʱڲ۵ժ
+* id-ʱ
 * void
 *   ֵvoid
-* ڣ20180101
-* ע    ⣺APB1ʱΪ36MHzTIM2-TIM5ʱѡΪAPB12ˣTIM2-TIM5ʱΪ72MHz
+* ڣ20261017
+* ע    ⣺
 *********************************************************************************************************/
-static  void ConfigTimer5(u16 arr,u16 psc)
+static  void  UnlinkTimer(i8 id)
 {
-  TIM_TimeBaseInitTypeDef  TIM_TimeBaseStructure;//TIM_TimeBaseStructureڴŶʱĲ
-  NVIC_InitTypeDef NVIC_InitStructure;           //NVIC_InitStructureڴNVICĲ
-
-  //ʹRCCʱ
-  RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM5, ENABLE);          //ʹTIM5ʱ
-  
-  //TIM5
-  TIM_TimeBaseStructure.TIM_Period        = arr;  //Զװֵ
-  TIM_TimeBaseStructure.TIM_Prescaler     = psc;  //ԤƵֵ 
-  TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;       //ʱӷָtDTS = tCK_INT
-  TIM_TimeBaseStructure.TIM_CounterMode   = TIM_CounterMode_Up; //ϼģʽ
-  TIM_TimeBaseInit(TIM5, &TIM_TimeBaseStructure);               //ݲʼʱ
- 
-  TIM_ITConfig(TIM5,TIM_IT_Update,ENABLE);                      //ʹܶʱĸж
-
-  //NVIC
-  NVIC_InitStructure.NVIC_IRQChannel = TIM5_IRQn;               //жͨ
-  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;     //ռȼ
-  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;            //ȼ
-  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;               //ʹж
-  NVIC_Init(&NVIC_InitStructure);                               //ݲʼNVIC 
-
-  TIM_Cmd(TIM5, ENABLE);                                        //ʹܶʱ
+  i8* pLink = &s_arrWheel[(u8)s_arrTimer[id].slot];
+
+  while(*pLink != TIMER_NONE)
+  {
+    if(*pLink == id)
+    {
+      *pLink = s_arrTimer[id].next;
+      break;
+    }
+    pLink = &s_arrTimer[(u8)*pLink].next;
+  }
+
+  s_arrTimer[id].slot = TIMER_NONE;
 }
 
 /*********************************************************************************************************
-* ƣTIM2_IRQHandler
-* ܣTIM2жϷ 
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣInitTimer
+* ܣʼTimerģ飬ע2ms1s¼
 * void
 * void
 *   ֵvoid
 * ڣ20180101
-* ע    ⣺ÿһжϷ
+* ע    ⣺SysTickṩInitSysTickԭȵTIM2TIM5ʹ
 *********************************************************************************************************/
-void TIM2_IRQHandler(void)  
-{  
-  static  u16 s_iCnt2 = 0;                            //һ̬s_iCnt2Ϊ2ms
+void InitTimer(void)
+{
+  i8 i;
 
-  if(TIM_GetITStatus(TIM2, TIM_IT_Update) == SET)     //ж϶ʱжǷ
+  for(i = 0; i < TIMER_WHEEL_SIZE; i++)
   {
-    TIM_ClearITPendingBit(TIM2, TIM_FLAG_Update);     //ʱжϱ־
+    s_arrWheel[i] = TIMER_NONE;
   }
-	s_1msCounter++;
-	SPO2_LED_Task();
-	
-  s_iCnt2++;            //2msļֵ1
-  if(s_iCnt2 >= 2)      //2msļֵڻ2
-  {                                                   
-    s_iCnt2 = 0;        //2msļֵΪ0
-    s_i2msFlag = TRUE;  //2ms־λֵΪTRUE 
+
+  for(i = 0; i < TIMER_MAX_NUM; i++)
+  {
+    s_arrTimer[i].slot = TIMER_NONE;
   }
+
+  s_iTickCnt   = 0;
+  s_iEventBits = 0;
+
+#ifdef TIMER_ISR_PROFILE
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; //DWTڼ
+  DWT_CTRL         |= 1;
+#endif
+
+  AddTimer(2,    2,    NULL, TIMER_EVENT_2MS);
+  AddTimer(1000, 1000, NULL, TIMER_EVENT_1SEC);
 }
 
 /*********************************************************************************************************
-* ƣTIM5_IRQHandler
-* ܣTIM5жϷ 
+* ƣTimerTick
+* ܣ1msģǰеڵĶʱ
 * void
 * void
 *   ֵvoid
+* ڣ20261017
+* ע    ⣺SysTick_Handlerеáժ±ȫڵĶʱ¹벢ִлص
+*           ǡΪĶʱ˲ͬһڱظ
+*********************************************************************************************************/
+void  TimerTick(void)
+{
+  i8  expired = TIMER_NONE; //ĵڵĶʱ
+  i8* pLink;
+  i8  id;
+
+#ifdef TIMER_ISR_PROFILE
+  u32 start = DWT_CYCCNT;
+#endif
+
+  s_iTickCnt++;
+  pLink = &s_arrWheel[s_iTickCnt & TIMER_WHEEL_MASK];
+
+  while(*pLink != TIMER_NONE)
+  {
+    id = *pLink;
+
+    if(s_arrTimer[id].rounds > 0)
+    {
+      s_arrTimer[id].rounds--;
+      pLink = &s_arrTimer[id].next;
+    }
+    else
+    {
+      *pLink = s_arrTimer[id].next;
+      s_arrTimer[id].next = expired;
+      expired = id;
+    }
+  }
+
+  while(expired != TIMER_NONE)
+  {
+    id = expired;
+    expired = s_arrTimer[id].next;
+
+    if(s_arrTimer[id].period > 0)
+    {
+      InsertTimer(id, s_arrTimer[id].period);
+    }
+    else
+    {
+      s_arrTimer[id].slot = TIMER_NONE;
+    }
+
+    s_iEventBits |= s_arrTimer[id].eventBits;
+
+    if(s_arrTimer[id].pCallback != NULL)
+    {
+      s_arrTimer[id].pCallback();
+    }
+  }
+
+#ifdef TIMER_ISR_PROFILE
+  s_iISRCycleSum += DWT_CYCCNT - start;
+  if((s_iTickCnt % 1000) == 0)
+  {
+    s_iISRCycleLast = s_iISRCycleSum;
+    s_iISRCycleSum  = 0;
+  }
+#endif
+}
+
+/*********************************************************************************************************
+* ƣGetTimeCounter
+* ܣȡǰ1msʱ
+* void
+* void
+*   ֵInitTimerĽ
 * ڣ20180101
-* ע    ⣺ÿһжϷ
+* ע    ⣺
+*********************************************************************************************************/
+u32		GetTimeCounter(void)
+{
+	return s_iTickCnt;
+}
+
+/*********************************************************************************************************
+* ƣAddTimer
+* ܣעһʱ
+* delay-״εǰĺperiod-֮ڣms0ΪΣpCallback-ڻص
+*           eventBits-ʱλ¼λ
+* void
+*   ֵʱţʱʱ-1
+* ڣ20261017
+* ע    ⣺صڽжִУζʱںԶͷ
 *********************************************************************************************************/
-void TIM5_IRQHandler(void)  
+i8    AddTimer(u32 delay, u32 period, TimerCallback pCallback, u32 eventBits)
 {
-  static  i16 s_iCnt1000  = 0;                        //һ̬s_iCnt1000Ϊ1s
+  i8  id;
+  u32 primask;  //ٽǰPRIMASK
+
+  if(delay == 0)
+  {
+    delay = 1;
+  }
+
+  TIMER_LOCK(primask);
 
-  if (TIM_GetITStatus(TIM5, TIM_IT_Update) == SET)    //ж϶ʱжǷ
+  for(id = 0; id < TIMER_MAX_NUM; id++)
   {
-    TIM_ClearITPendingBit(TIM5, TIM_FLAG_Update);     //ʱжϱ־ 
-  }                                                   
-                                                      
-  s_iCnt1000++;           //1000msļֵ1
-                                                      
-  if(s_iCnt1000 >= 1000)  //1000msļֵڻ1000
-  {                                                   
-    s_iCnt1000 = 0;       //1000msļֵΪ0
-    s_i1secFlag = TRUE;   //1s־λֵΪTRUE
-  } 
+    if(s_arrTimer[id].slot == TIMER_NONE)
+    {
+      s_arrTimer[id].pCallback = pCallback;
+      s_arrTimer[id].eventBits = eventBits;
+      s_arrTimer[id].period    = period;
+      InsertTimer(id, delay);
+      break;
+    }
+  }
+
+  TIMER_UNLOCK(primask);
+
+  return (id < TIMER_MAX_NUM) ? id : TIMER_NONE;
 }
 
 /*********************************************************************************************************
-*                                              APIʵ
+* ƣDelTimer
+* ܣעʱ
+* id-AddTimerصı
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ѵڵĵζʱԶͷţٴעӰ
 *********************************************************************************************************/
+void  DelTimer(i8 id)
+{
+  u32 primask;  //ٽǰPRIMASK
+
+  if((id < 0) || (id >= TIMER_MAX_NUM))
+  {
+    return;
+  }
+
+  TIMER_LOCK(primask);
+
+  if(s_arrTimer[id].slot != TIMER_NONE)
+  {
+    UnlinkTimer(id);
+  }
+
+  TIMER_UNLOCK(primask);
+}
+
 /*********************************************************************************************************
-* ƣInitTimer
-* ܣʼTimerģ 
+* ƣGetTimerEvent
+* ܣȡλĶʱ¼λ
 * void
 * void
+*   ֵ¼λ
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+u32   GetTimerEvent(void)
+{
+  return s_iEventBits;
+}
+
+/*********************************************************************************************************
+* ƣClrTimerEvent
+* ܣʱ¼λ
+* eventBits-¼λ
+* void
 *   ֵvoid
-* ڣ20180101
-* ע    ⣺ʹõTIM2-7APB1(36MHz)ԤƵԤƵΪ1APB1*1APB1*2(72MHz)
+* ڣ20261017
+* ע    ⣺--дڼжϣⶪʧжͬʱλ¼
 *********************************************************************************************************/
-void InitTimer(void)
+void  ClrTimerEvent(u32 eventBits)
 {
-  ConfigTimer2(999, 71);  //72MHz/(71+1)=1MHz0999Ϊ1ms
-  ConfigTimer5(999, 71);  //72MHz/(71+1)=1MHz0999Ϊ1ms
+  u32 primask;  //ٽǰPRIMASK
+
+  TIMER_LOCK(primask);
+  s_iEventBits &= ~eventBits;
+  TIMER_UNLOCK(primask);
 }
 
 /*********************************************************************************************************
 * ƣGet2msFlag
-* ܣȡ2ms־λֵ  
+* ܣȡ2ms־λֵ
 * void
 * void
-*   ֵs_i2msFlag-2ms־λֵ
+*   ֵ2ms־λֵ
 * ڣ20180101
 * ע    ⣺
 *********************************************************************************************************/
 u8  Get2msFlag(void)
 {
-  return(s_i2msFlag);     //2ms־λֵ
+  return((s_iEventBits & TIMER_EVENT_2MS) ? TRUE : FALSE);  //2ms־λֵ
 }
 
 /*********************************************************************************************************
 * ƣClr2msFlag
-* ܣ2ms־λ  
+* ܣ2ms־λ
 * void
 * void
 *   ֵvoid
@@ -216,26 +365,26 @@ u8  Get2msFlag(void)
 *********************************************************************************************************/
 void  Clr2msFlag(void)
 {
-  s_i2msFlag = FALSE;     //2ms־λֵΪFALSE 
+  ClrTimerEvent(TIMER_EVENT_2MS);
 }
 
 /*********************************************************************************************************
 * ƣGet1SecFlag
-* ܣȡ1s־λֵ  
+* ܣȡ1s־λֵ
 * void
 * void
-*   ֵs_i1secFlag-1s־λֵ
+*   ֵ1s־λֵ
 * ڣ20180101
 * ע    ⣺
 *********************************************************************************************************/
 u8  Get1SecFlag(void)
 {
-  return(s_i1secFlag);    //1s־λֵ
+  return((s_iEventBits & TIMER_EVENT_1SEC) ? TRUE : FALSE); //1s־λֵ
 }
 
 /*********************************************************************************************************
 * ƣClr1SecFlag
-* ܣ1s־λ  
+* ܣ1s־λ
 * void
 * void
 *   ֵvoid
@@ -244,19 +393,24 @@ u8  Get1SecFlag(void)
 *********************************************************************************************************/
 void  Clr1SecFlag(void)
 {
-  s_i1secFlag = FALSE;    //1s־λֵΪFALSE
+  ClrTimerEvent(TIMER_EVENT_1SEC);
 }
 
 /*********************************************************************************************************
-* ƣGetTimeCounter
-* ܣȡǰ1msʱ 
+* ƣGetTickISRCycles
+* ܣȡһжĵĴ
 * void
 * void
-*   ֵvoid
-* ڣ20180101
-* ע    ⣺
+*   ֵδTIMER_ISR_PROFILEʱ0
+* ڣ20261017
+* ע    ⣺ֻͳTimerTickصжϽ˳ĸ12ڣ
+*           TIMER_ISR_PROFILEʱInitTimerDWTڼ
 *********************************************************************************************************/
-u32		GetTimeCounter(void)
+u32   GetTickISRCycles(void)
 {
-	return s_1msCounter;
+#ifdef TIMER_ISR_PROFILE
+  return s_iISRCycleLast;
+#else
+  return 0;
+#endif
 }
@@ -24,22 +24,38 @@
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
+#define TIMER_MAX_NUM     8           //ͬʱעʱ
+#define TIMER_WHEEL_SIZE  16          //ʱֲΪ2
+
+//ʱ¼λɵڵĶʱλѭѯ
+#define TIMER_EVENT_2MS   (1u << 0)   //2ms
+#define TIMER_EVENT_1SEC  (1u << 1)   //1s
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
 *********************************************************************************************************/
+typedef void (*TimerCallback)(void);  //ʱص1msжִУС
 
 /*********************************************************************************************************
 *                                              API
 *********************************************************************************************************/
 void  InitTimer(void);      //ʼTimerģ
+void  TimerTick(void);      //1msģSysTick_Handler
 
 u32		GetTimeCounter(void);	//ȡǰ1msʱ
 
+i8    AddTimer(u32 delay, u32 period, TimerCallback pCallback, u32 eventBits); //עᶨʱرţʧܷ-1
+void  DelTimer(i8 id);                //עʱ
+
+u32   GetTimerEvent(void);            //ȡλĶʱ¼λ
+void  ClrTimerEvent(u32 eventBits);   //ʱ¼λ
+
 u8    Get2msFlag(void);     //ȡ2ms־λֵ
 void  Clr2msFlag(void);     //2ms־λ
 
 u8    Get1SecFlag(void);    //ȡ1s־λֵ
 void  Clr1SecFlag(void);    //1s־λ
+
+u32   GetTickISRCycles(void);   //һжĵ趨TIMER_ISR_PROFILE
  
 #endif
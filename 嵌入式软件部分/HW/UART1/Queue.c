@@ -18,10 +18,20 @@
 *                                              ͷļ
 *********************************************************************************************************/
 #include "Queue.h"
+#include <string.h>
 
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
+//ڴϣRELEASE֤дrear/frontĸ±һ˿ACQUIRE֤Զ˵ļŷʻ
+//Cortex-M3жѭ֮DMB׼ԹGCCĵϣx86ֻԼ
+#if defined(__CC_ARM)
+  #define QUEUE_ACQUIRE()   __dmb(0xF)
+  #define QUEUE_RELEASE()   __dmb(0xF)
+#else
+  #define QUEUE_ACQUIRE()   __atomic_thread_fence(__ATOMIC_ACQUIRE)
+  #define QUEUE_RELEASE()   __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
@@ -34,10 +44,57 @@
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
+static  void  CopyIn(StructCirQue* pQue, u16 pos, const u8* pSrc, i16 len);  //posдlenԪأ
+static  void  CopyOut(StructCirQue* pQue, u16 pos, u8* pDst, i16 len);       //poslenԪأ
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
+/*********************************************************************************************************
+* ƣCopyIn
+* ܣӼposӦλдlenԪأʱο
+* pQue-ṹָ룬pos-ʼpSrc-дݵĵַlen-Ԫ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺֤߱lenʣռ
+*********************************************************************************************************/
+static  void  CopyIn(StructCirQue* pQue, u16 pos, const u8* pSrc, i16 len)
+{
+  u16 index = pos & pQue->mask;       //ʼ±
+  u16 first = pQue->mask + 1 - index; //ʼ±굽ĩβԪظ
+
+  if(first > len)
+  {
+    first = len;
+  }
+
+  memcpy(&pQue->pBuffer[index * pQue->elemSize], pSrc, first * pQue->elemSize);
+  memcpy(pQue->pBuffer, pSrc + first * pQue->elemSize, (len - first) * pQue->elemSize);
+}
+
+/*********************************************************************************************************
+* ƣCopyOut
+* ܣӼposӦλlenԪأʱο
+* pQue-ṹָ룬pos-ʼlen-Ԫ
+* pDst-ݴŵĵַ
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺֤߱lenеԪ
+*********************************************************************************************************/
+static  void  CopyOut(StructCirQue* pQue, u16 pos, u8* pDst, i16 len)
+{
+  u16 index = pos & pQue->mask;       //ʼ±
+  u16 first = pQue->mask + 1 - index; //ʼ±굽ĩβԪظ
+
+  if(first > len)
+  {
+    first = len;
+  }
+
+  memcpy(pDst, &pQue->pBuffer[index * pQue->elemSize], first * pQue->elemSize);
+  memcpy(pDst + first * pQue->elemSize, pQue->pBuffer, (len - first) * pQue->elemSize);
+}
 
 /*********************************************************************************************************
 *                                              APIʵ
@@ -50,22 +107,38 @@
 * pQue-ṹָ룬ָṹĵַ
 *   ֵvoid
 * ڣ20180101
-* ע    ⣺
+* ע    ⣺ԪΪDATA_TYPEĶУInitQueueElem
 *********************************************************************************************************/
 void  InitQueue(StructCirQue* pQue, DATA_TYPE* pBuf, i16 len)
 {
-  i16 i;
-
-  pQue->front   = 0;    //ͷ
-  pQue->rear    = 0;    //β
-  pQue->bufLen  = len;  //ȣ
-  pQue->elemNum = 0;    //ǰԪصĸ
-  pQue->pBuffer = pBuf; //ָpBufָpQue->pBuffer
-  
-  for(i = 0; i < len; i++)
+  InitQueueElem(pQue, pBuf, len, sizeof(DATA_TYPE));
+}
+
+/*********************************************************************************************************
+* ƣInitQueueElem
+* ܣʼԪشСΪelemSizeֽڵĶ
+* pQue-ṹָ룬pBuf-еԪش洢ַlen-洢ɵԪظelemSize-Ԫصֽ
+* pQue-ṹָ룬ָṹĵַ
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ȡlen2ݣ洢ĲֲʹãlenӦֱȡ2
+*********************************************************************************************************/
+void  InitQueueElem(StructCirQue* pQue, void* pBuf, i16 len, u16 elemSize)
+{
+  u16 cap = 1;  //
+
+  while(cap * 2 <= len)
   {
-    pQue->pBuffer[i] = 0; //ָpQue->pBufferָԪؾֵ0
+    cap *= 2;
   }
+
+  pQue->front    = 0;
+  pQue->rear     = 0;
+  pQue->mask     = cap - 1;
+  pQue->elemSize = elemSize;
+  pQue->pBuffer  = (u8*)pBuf;
+
+  memset(pBuf, 0, len * elemSize);  //Դ洢Ԫؾֵ0
 }
 
 /*********************************************************************************************************
@@ -75,13 +148,11 @@ void  InitQueue(StructCirQue* pQue, DATA_TYPE* pBuf, i16 len)
 * pQue-ṹָ룬ָṹĵַ
 *   ֵvoid
 * ڣ20180101
-* ע    ⣺
+* ע    ⣺ɳӷãеԪأ޸ӷrear
 *********************************************************************************************************/
 void  ClearQueue(StructCirQue* pQue)
 {
-  pQue->front   = 0; //ͷ
-  pQue->rear    = 0; //β
-  pQue->elemNum = 0; //ǰԪصĸ
+  pQue->front = pQue->rear;
 }
 
 /*********************************************************************************************************
@@ -95,7 +166,7 @@ void  ClearQueue(StructCirQue* pQue)
 *********************************************************************************************************/
 u8    QueueEmpty(StructCirQue* pQue)
 {
-  return(0 == pQue->elemNum);
+  return(pQue->front == pQue->rear);
 }
 
 /*********************************************************************************************************
@@ -109,7 +180,7 @@ u8    QueueEmpty(StructCirQue* pQue)
 *********************************************************************************************************/
 i16   QueueLength(StructCirQue* pQue)
 {
-  return(pQue->elemNum);
+  return((u16)(pQue->rear - pQue->front));
 }
 
 /*********************************************************************************************************
@@ -119,26 +190,30 @@ i16   QueueLength(StructCirQue* pQue)
 * pQue-ṹָ룬ָṹĵַ
 *   ֵɹӵԪص
 * ڣ20180101
-* ע    ⣺ÿβһԪأrearrearֵڵڶbufLenʱrearֵΪ0Ҫעǣ
-*           еԪϴдԪʱдԪڶеԪ+д
-*           Ԫ-еEnQueueڳԪزȡǵ̬ȡ
+* ע    ⣺ֻһӷеԪϴдԪʱֻдʣռ
+*           Ĳ֣EnQueueڳԪزȡǵ̬ȡݿɺŸrearӷ
+*           δдԪ
 *********************************************************************************************************/
-i16 EnQueue(StructCirQue* pQue, DATA_TYPE* pInput, i16 len)
+HOT_FUNC i16 EnQueue(StructCirQue* pQue, const void* pInput, i16 len)
 {
-  i16 wLen = 0; //ӵԪlenwLen0ӵlen-1
-  
-  while((pQue->elemNum < pQue->bufLen) && (wLen < len))
+  u16 rear = pQue->rear;                                      //ֻӷ޸rear
+  i16 wLen = pQue->mask + 1 - (u16)(rear - pQue->front);     //ʣռ
+
+  if(wLen > len)
   {
-    pQue->pBuffer[pQue->rear] = pInput[wLen]; //ӵĵwLenԪpInput[wLen]
-    pQue->rear++;     //βrearָβԪصһλ
-    
-    if(pQue->rear >= pQue->bufLen)
-    {
-      pQue->rear = 0; //βԪصһλΪpQue->bufLenrearָͷѭڴ˴
-    }
-
-    wLen++;
-    pQue->elemNum++;  //ǰеԪ
+    wLen = len;
+  }
+
+  if(wLen > 0)
+  {
+    QUEUE_ACQUIRE();
+    CopyIn(pQue, rear, (const u8*)pInput, wLen);
+    QUEUE_RELEASE();
+    pQue->rear = rear + wLen;
+  }
+  else
+  {
+    wLen = 0;
   }
 
   return wLen;  //ֵwLenΪ0ʾûԪ
@@ -151,27 +226,80 @@ i16 EnQueue(StructCirQue* pQue, DATA_TYPE* pInput, i16 len)
 * pQue-ṹָ룬ָṹĵַpOutput-Ԫشŵĵַ
 *   ֵɹӵԪص
 * ڣ20180101
-* ע    ⣺ÿȡһԪأfrontfrontֵڵڶbufLenʱfrontֵΪ0Ҫرע⣬
-*           жȡԪصǰǶҪһԪأȡԪlenСڻڶԪص
-*           ʱ԰ȡlenԪأֻȡеԪء 
+* ע    ⣺ֻһӷȡԪlenСڻڶԪصʱ԰ȡlen
+*           ԪأֻȡеԪءɺŸfrontӷḲδԪ
 *********************************************************************************************************/
-i16 DeQueue(StructCirQue* pQue, DATA_TYPE* pOutput, i16 len)
+HOT_FUNC i16 DeQueue(StructCirQue* pQue, void* pOutput, i16 len)
 {
-  i16 rLen = 0; //ȡlenԪأȡrLenԪ
-  
-  while((pQue->elemNum > 0) && (rLen < len))
+  u16 front = pQue->front;                    //ֻгӷ޸front
+  i16 rLen  = (u16)(pQue->rear - front);      //еԪ
+
+  if(rLen > len)
+  {
+    rLen = len;
+  }
+
+  if(rLen > 0)
+  {
+    QUEUE_ACQUIRE();
+    CopyOut(pQue, front, (u8*)pOutput, rLen);
+    QUEUE_RELEASE();
+    pQue->front = front + rLen;
+  }
+  else
   {
-    pOutput[rLen] = pQue->pBuffer[pQue->front];
-    pQue->front++;
-    
-    if( pQue->front >= pQue->bufLen )
-    {
-      pQue->front = 0;//ͷԪصһλΪpQue->bufLenfrontָͷѭڴ˴
-    }
-
-    rLen++;
-    pQue->elemNum--;  //ǰеԪ
+    rLen = 0;
   }
 
   return rLen;  //ֵrLenΪ0ʾûԪ
 }
+
+/*********************************************************************************************************
+* ƣReserveQueue
+* ܣڶβԤlenԪصдֱд뻺ٵCommitQueueӣʡȥEnQueueԪؿ
+* pQue-ṹָ룬ָṹĵַlen-ҪԤԪ
+* pSpan-ԤдβʱΪ
+*   ֵԤɹlenʣռ䲻lenʱ0ʱԤκοռ
+* ڣ20261017
+* ע    ⣺Ԥı״ֻ̬һдߣֻʣռ䣬ԤύǰʼЧ
+*           EnQueueͬռ䲻ʱֻܾдһ֡DATA_TYPEԪصĶ
+*********************************************************************************************************/
+HOT_FUNC i16 ReserveQueue(StructCirQue* pQue, StructQueSpan* pSpan, i16 len)
+{
+  u16 rear  = pQue->rear;
+  u16 index = rear & pQue->mask;  //β±
+  i16 first;                      //Ӷβĩβ
+
+  if((len <= 0) || (pQue->mask + 1 - (u16)(rear - pQue->front) < len))
+  {
+    return 0;
+  }
+
+  first = pQue->mask + 1 - index;
+  if(first > len)
+  {
+    first = len;
+  }
+
+  pSpan->pSpan[0]   = &pQue->pBuffer[index];
+  pSpan->spanLen[0] = first;
+  pSpan->pSpan[1]   = pQue->pBuffer;
+  pSpan->spanLen[1] = len - first;
+
+  return len;
+}
+
+/*********************************************************************************************************
+* ƣCommitQueue
+* ܣύдԤlenԪأƶβ
+* pQue-ṹָ룬ָṹĵַlen-дԪReserveQueueķֵ
+* pQue-ṹָ룬ָṹĵַ
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺ϱ֤Ԥдrearĸ
+*********************************************************************************************************/
+HOT_FUNC void CommitQueue(StructCirQue* pQue, i16 len)
+{
+  QUEUE_RELEASE();
+  pQue->rear = pQue->rear + len;
+}
@@ -32,23 +32,36 @@
 typedef u8  DATA_TYPE;
 
 //ѭнṹ
+///Уӷֻ޸rearӷֻ޸front߾Ϊɵļ
+//ԪΪrear-frontȡģ±꣬Ϊ2ݡжѭռһʱж
 typedef struct
 {
-  i16       front;    //ͷָ룬ӷǿʱָͷԪ
-  i16       rear;     //βָ룬ӷǿʱָβԪصһλ
-  i16       bufLen;   //е
-  i16       elemNum;  //ǰеԪص
-  DATA_TYPE *pBuffer; //ѭеĻ
+  volatile u16  front;    //ѳӵԪɳӷ޸
+  volatile u16  rear;     //ӵԪӷ޸
+  u16           mask;     //1
+  u16           elemSize; //ÿԪصֽ
+  u8            *pBuffer; //ѭеĻ
 }StructCirQue;
 
+//ԤдβʱΪΣʱڶγΪ0
+typedef struct
+{
+  DATA_TYPE *pSpan[2];  //д׵ַ
+  i16       spanLen[2]; //дĳȣԪظ
+}StructQueSpan;
+
 /*********************************************************************************************************
 *                                              API
 *********************************************************************************************************/
 void  InitQueue(StructCirQue* pQue, DATA_TYPE* pBuf, i16 len);  //ʼ
+void  InitQueueElem(StructCirQue* pQue, void* pBuf, i16 len, u16 elemSize); //ʼԪشСΪelemSizeֽڵĶ
 void  ClearQueue(StructCirQue* pQue);                           //
 u8    QueueEmpty(StructCirQue* pQue);                           //ж϶ǷΪգ1Ϊգ0Ϊǿ
 i16   QueueLength(StructCirQue* pQue);                          //ضԪظΪеĳ
-i16   EnQueue(StructCirQue* pQue, DATA_TYPE* pInput, i16 len);  //lenԪ
-i16   DeQueue(StructCirQue* pQue, DATA_TYPE* pOutput, i16 len); //lenԪ
+i16   EnQueue(StructCirQue* pQue, const void* pInput, i16 len); //lenԪ
+i16   DeQueue(StructCirQue* pQue, void* pOutput, i16 len);      //lenԪ
+
+i16   ReserveQueue(StructCirQue* pQue, StructQueSpan* pSpan, i16 len); //ԤlenԪصдռ䲻㷵0
+void  CommitQueue(StructCirQue* pQue, i16 len);                         //ύдԤlenԪ
 
 #endif
@@ -20,6 +20,7 @@
 #include "UART1.h"
 #include "stm32f10x_conf.h"
 #include "Queue.h"
+#include "FastIO.h"
 
 /*********************************************************************************************************
 *                                              궨
@@ -220,37 +221,34 @@ static  void  SendCharUsedByFputc(u16 ch)
 * ڣ20180101
 * ע    ⣺
 *********************************************************************************************************/
-void USART1_IRQHandler(void)                
+HOT_FUNC void USART1_IRQHandler(void)
 {
   u8  uData = 0;
+  u16 sr    = USART1->SR; //ֻһ״̬Ĵ֮DRͬʱRXNEORE
 
-  if(USART_GetITStatus(USART1, USART_IT_RXNE) != RESET)  //ջǿж
+  if(sr & (USART_SR_RXNE | USART_SR_ORE))                //ջǿջ
   {                                                         
-    NVIC_ClearPendingIRQ(USART1_IRQn);  //USART1жϹ
-    uData = USART_ReceiveData(USART1);  //USART1յݱ浽uData
+    NVIC_ClearPendingIRQ(USART1_IRQn);                   //USART1жϹ
+    uData = (u8)USART1->DR;                              //ȡUSART_DR
                                                           
-    WriteReceiveBuf(uData);  //յдջ                                 
-  }                                                         
-                                                            
-  if(USART_GetFlagStatus(USART1, USART_FLAG_ORE) == SET) //־Ϊ1
-  {                                                         
-    USART_ClearFlag(USART1, USART_FLAG_ORE);             //־
-    USART_ReceiveData(USART1);                           //ȡUSART_DR 
+    if(sr & USART_SR_RXNE)
+    {
+      WriteReceiveBuf(uData);                            //յдջ
+    }
   }                                                         
                                                            
-  if(USART_GetITStatus(USART1, USART_IT_TXE)!= RESET)    //ͻж
+  if(UARTTxEmptyPending(USART1))                         //ͻжϣдDRTXE
   {                                                        
-    USART_ClearITPendingBit(USART1, USART_IT_TXE);       //жϱ־
     NVIC_ClearPendingIRQ(USART1_IRQn);                   //USART1жϹ
                                                            
     ReadSendBuf(&uData);                                 //ȡͻݵuData
                                                                     
-    USART_SendData(USART1, uData);                       //uDataдUSART_DR
+    USART1->DR = uData;                                  //uDataдUSART_DR
                                                                                            
     if(QueueEmpty(&s_structUARTSendCirQue))              //ͻΪʱ
     {                                                               
       s_iUARTTxSts = UART_STATE_OFF;                     //ڷ״̬Ϊδ       
-      USART_ITConfig(USART1, USART_IT_TXE, DISABLE);     //رմڷͻж
+      UARTTxEmptyITOff(USART1);                          //رմڷͻж
     }
   }
 } 
@@ -300,6 +298,39 @@ u8  WriteUART1(u8 *pBuf, u8 len)
   return wLen;  //ʵдݵĸ
 }
 
+/*********************************************************************************************************
+* ƣReserveUART1
+* ܣڴڷͻԤlenֽڵдֱڻ
+* lenҪԤֽ
+* pSpanԤдʱΪ
+*   ֵԤɹlenʣռ䲻ʱ0
+* ڣ20261017
+* ע    ⣺ռ䲻ʱܾWriteUART1ֻдһ֣ԤCommitUART1
+*********************************************************************************************************/
+u8  ReserveUART1(StructQueSpan* pSpan, u8 len)
+{
+  return (u8)ReserveQueue(&s_structUARTSendCirQue, pSpan, len);
+}
+
+/*********************************************************************************************************
+* ƣCommitUART1
+* ܣύԤдlenֽڣʹܷж
+* lenдֽ
+* void
+*   ֵvoid
+* ڣ20261017
+* ע    ⣺
+*********************************************************************************************************/
+void  CommitUART1(u8 len)
+{
+  CommitQueue(&s_structUARTSendCirQue, len);
+
+  if(s_iUARTTxSts == UART_STATE_OFF)
+  {
+    EnableUARTTx();
+  }
+}
+
 /*********************************************************************************************************
 * ƣReadUART1
 * ܣڣȡڽջе  
@@ -333,3 +364,27 @@ int fputc(int ch, FILE* f)
                                
   return ch;                     //ch
 }
+
+#if defined(__GNUC__) && !defined(__CC_ARM)
+/*********************************************************************************************************
+* ƣ_write
+* ܣGCC(newlib) µ printf ض
+* fdpBuflen
+* void
+*   ֵintдַ
+* ڣ20261017
+* ע    ⣺Keil(MicroLIB) ʹ fputcGCC  newlib-nano ʱ _write 
+*********************************************************************************************************/
+int _write(int fd, char* pBuf, int len)
+{
+  int i;
+
+  (void)fd;
+  for(i = 0; i < len; i++)
+  {
+    SendCharUsedByFputc((u8)pBuf[i]);
+  }
+
+  return len;
+}
+#endif
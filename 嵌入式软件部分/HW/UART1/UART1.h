@@ -21,11 +21,16 @@
 *********************************************************************************************************/
 #include <stdio.h>
 #include "DataType.h"
+#include "Queue.h"
 
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
-#define UART1_BUF_SIZE 100           //ûĴС
+#define UART1_BUF_SIZE 128           //ûĴСΪ2
+
+#if (UART1_BUF_SIZE & (UART1_BUF_SIZE - 1)) != 0
+  #error "UART1_BUF_SIZE must be a power of two"
+#endif
 
 /*********************************************************************************************************
 *                                              öٽṹ嶨
@@ -38,4 +43,7 @@ void  InitUART1(u32 bound);          //
 u8    WriteUART1(u8 *pBuf, u8 len);  //дڣдݵĸ
 u8    ReadUART1(u8 *pBuf, u8 len);   //ڣضݵĸ
 
+u8    ReserveUART1(StructQueSpan* pSpan, u8 len);  //Ԥͻռ䲻ʱ0ҲԤ
+void  CommitUART1(u8 len);                         //ύԤдݲ
+
 #endif